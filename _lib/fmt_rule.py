@@ -25,6 +25,8 @@ StdAttrs = {
 ,	'targets'           : ( dict  , False )
 ,	'allow_stderr'      : ( bool  , True  )
 ,	'autodep'           : ( str   , True  )
+,	'autodep_cache'     : ( bool  , True  )
+,	'autodep_ring'      : ( bool  , True  )
 ,	'auto_mkdir'        : ( bool  , True  )
 ,	'backend'           : ( str   , True  )
 ,	'cache'             : ( str   , True  )
@@ -55,6 +57,7 @@ StdAttrs = {
 ,	'timeout'           : ( float , True  )
 ,	'tmp_view'          : ( str   , True  )
 ,	'use_script'        : ( bool  , True  )
+,	'use_zygote'        : ( bool  , True  )
 ,	'views'             : ( dict  , True  )
 }
 Keywords     = {'dep','deps','resources','stems','target','targets'}
@@ -488,6 +491,7 @@ class Handle :
 		self._handle_val('root_view'                        )
 		self._handle_val('tmp_view'                         )
 		self._handle_val('use_script'                       )
+		self._handle_val('use_zygote'                       )
 		self._handle_val('views'                            )
 		self.rule_rep.start_cmd_attrs = self._finalize()
 
@@ -501,6 +505,8 @@ class Handle :
 	def handle_start_none(self) :
 		if not callable(self.attrs.kill_sigs) : self.attrs.kill_sigs = [int(x) for x in self.attrs.kill_sigs]
 		self._init()
+		self._handle_val('autodep_cache'                          )
+		self._handle_val('autodep_ring'                           )
 		self._handle_val('keep_tmp'                               )
 		self._handle_val('start_delay'                            )
 		self._handle_val('kill_sigs'                              )
@@ -40,6 +40,7 @@ config = pdict(
 ,	max_error_lines     = 100           # used to limit the number of error lines when not reasonably limited otherwise
 ,	network_delay       = 1             # delay between job completed and server aware of it. Too low, there may be spurious lost jobs. Too high, tool reactivity may rarely suffer.
 ,	path_max            = 400           # max path length, but a smaller value makes debugging easier (by default, not activated)
+#,	python_evaluators   = 0             # number of processes evaluating dynamic attributes out of server (if 0, they are evaluated within server)
 #,	reliable_dirs       = False         # if true, close to open coherence is deemed to encompass enclosing directory coherence (improve performances)
 #	                                    # - forced true if only local backend is used
 #	                                    # - set   true  for ceph
@@ -61,6 +62,10 @@ config = pdict(
 			cpu =     _cpu                                  # total number of cpus available for the process, and hence for all jobs launched locally
 		,	mem = str(_mem>>20)+'M'                         # total available memory in MBytes, defaults to all available memory
 		,	tmp = str(_tmp>>20)+'M'                         # total available temporary disk space in MBytes, defaults to free space in current filesystem
+		#,	backfill = False                                # if True, a job that does not fit reserves resources and others only run ahead if they do not delay it
+		#,	relay    = False                                # if True, jobs communicate with server through a per host relay holding a persistent connection
+		#,	precompute_start = False                        # if True, start attributes (cmd, environ, ...) are evaluated when jobs are launched rather than when they start
+		#,	pool     = False                                # if True, jobs are forked from a pre-started job_exec fork server rather than spawned, useful for numerous short jobs
 		)
 	#,	sge = pdict(
 	#		interface         = _interface                  # address at which lmake can be contacted from jobs launched by this backend, can be :
@@ -73,6 +78,7 @@ config = pdict(
 	#	,	cell              = 'default'                   # cell     used for SGE job submission, by default, SGE automatically determines it
 	#	,	cluster           = 'p6444'                     # cluseter used for SGE job submission, by default, SGE automatically determines it
 	#	,	default_prio      = 0                           # default priority to use if none is specified on the lmake command line (this is the default)
+	#	,	max_array_sz      = 1000                        # max number of jobs submitted as a single array job (this is the default), 1 means no arrays
 	#	,	n_max_queued_jobs = 10                          # max number of queued jobs for a given set of asked resources
 	#	,	repo_key          = _osp.basename(_os.getcwd()) # prefix used before job name to name slurm jobs (this is the default if not specified)
 	#	,	root_dir          = '/opt/sge'                  # root directory of the SGE installation
@@ -83,6 +89,7 @@ config = pdict(
 	#,	slurm = pdict(
 	#		interface         = _interface                  # cf sge entry above
 	#	,	config            = '/etc/slurm/slurm.conf'     # config file (this is the default value if not specified)
+	#	,	max_array_sz      = 1000                        # max number of jobs submitted as a single job array (this is the default), 1 means no arrays
 	#	,	n_max_queued_jobs = 10                          # max number of queued jobs for a given set of asked resources
 	#	,	repo_key          = _osp.basename(_os.getcwd()) # prefix used before job name to name slurm jobs
 	#	,	use_nice          = True                        # if True (default is False), nice value is used to automatically prioritize jobs between repositories
@@ -105,6 +112,13 @@ config = pdict(
 	#	,	size   = 10<<30                                 # the overall size of this cache
 	#	,	group  = _group                                 # the group used to write to the cache. If user does not belong to this group, read-only access is still possible
 	#	)
+	#,	tiered = pdict(                                     # when rule specifies cache = 'tiered' , this cache is selected
+	#		tag           = 'tiered'                        # a local dir cache in front of a shared dir cache, shared hits are promoted to the local tier
+	#	,	repo          = root_dir                        # same as for dir cache
+	#	,	local         = '/local_cache_dir'              # the directory of the local tier, typically on local disk
+	#	,	shared        = '/shared_cache_dir'             # the directory of the shared tier, typically on NFS
+	#	,	shared_upload = True                            # if False, shared tier is only read
+	#	)
 	)
 ,	colors = pdict(
 		#                 normal video    reverse video
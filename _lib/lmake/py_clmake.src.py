@@ -71,10 +71,13 @@ else :
 	if not root_dir : del root_dir
 #
 autodeps = ()
-if "$HAS_FUSE"     : autodeps += ('fuse'    ,)
-if "$HAS_LD_AUDIT" : autodeps += ('ld_audit',)
+if "$HAS_FUSE"          : autodeps += ('fuse'    ,)
+if "$HAS_LD_AUDIT"      : autodeps += ('ld_audit',)
 autodeps += ('ld_preload','ld_preload_jemalloc','ptrace')
+if "$HAS_SECCOMP_NOTIF" : autodeps += ('seccomp' ,)
 #
 backends = ('local',)
 if "$HAS_SGE"   : backends += ('sge'  ,)
 if "$HAS_SLURM" : backends += ('slurm',)
+#
+has_pcre = bool("$HAS_PCRE") # if True, regexprs in rules follow PCRE syntax, else they follow std::regex (ECMAScript) syntax
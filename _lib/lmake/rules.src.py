@@ -68,6 +68,8 @@ class Rule(_RuleBase) :
 	__special__      = None                            # plain Rule
 #	allow_stderr     = False                           # if set, writing to stderr is not an error but a warning
 #	auto_mkdir       = False                           # auto mkdir directory in case of chdir
+#	autodep_cache    = False                           # if set, read accesses already reported by a process of the job are not reported again by others (ld_* autodep methods only)
+#	autodep_ring     = False                           # if set, read accesses are reported to job_exec through shared memory rather than through a socket (ld_* autodep methods only)
 	backend          = 'local'                         # may be set anywhere in the inheritance hierarchy if execution must be remote
 #	chroot_dir       = '/'                             # chroot directory to execute cmd (if None, empty or absent, no chroot is not done)
 #	cache            = None                            # cache used to store results for this rule. None means no caching
@@ -105,7 +107,8 @@ class Rule(_RuleBase) :
 	#                                                  # - else a tmpfs sized after the 'tmp' resource if specified (no tmpfs is created if value is 0)
 	#                                                  # - else a private sub-directory in the LMAKE directory
 #	use_script       = False                           # use a script to run job rather than calling interpreter with -c
-	if 'ld_audit' in autodeps : autodep = 'ld_audit'   # may be set anywhere in the inheritance hierarchy if autodep uses an alternate method : none, ptrace, ld_audit, ld_preload
+#	use_zygote       = False                           # for python jobs, fork job from a per host zygote with module level code of cmd already executed (ld_* autodep only)
+	if 'ld_audit' in autodeps : autodep = 'ld_audit'   # may be set anywhere in the inheritance hierarchy if autodep uses an alternate method : none, ptrace, seccomp, ld_audit, ld_preload
 	else                      : autodep = 'ld_preload' # .
 	resources = {                                      # used in conjunction with backend to inform it of the necessary resources to execute the job, same syntax as deps
 		'cpu' : 1                                      # number of cpu's to allocate to job
@@ -0,0 +1,229 @@
+# This file is part of the open-lmake distribution (git@github.com:cesar-douady/open-lmake.git)
+# Copyright (c) 2023 Doliam
+# This program is free software: you can redistribute/modify under the terms of the GPL-v3 (https://www.gnu.org/licenses/gpl-3.0.html).
+# This program is distributed WITHOUT ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+# /!\ this file is Python3 only, it is used by job_exec when the use_zygote rule attribute is set
+
+'''
+	Zygote for python jobs.
+	A zygote is launched by job_exec with the static part of cmd (i.e. all but the job specific context), which it executes once, mostly to import modules.
+	Then, it forks a child for each job, which runs the full cmd as python -c would, finding modules already imported.
+	Accesses done while warming up are recorded in a file (through the autodep lib) which zygote_client checks and reports for each job.
+	usage : <interpreter> -c <bootstrap> <sock_name> <warm_up_file> <deps_file> <log_file>
+	protocol, over an abstract unix socket (all ints are native uint32/int32) :
+	- abstract sockets are visible to all users, so connections from other users are closed right away
+	- upon connection, zygote sends len+deps_file
+	- client then sends either :
+		- len=0                                                                            : zygote stops listening and exits once all running jobs are done
+		- len+'\\0'.join((cwd,n_args,*args,*env)) along with its stdin, stdout and stderr : zygote replies pid, then wstatus when job is done
+	- if client hangs up, job is killed
+'''
+
+import builtins
+import importlib
+import os
+import selectors
+import signal
+import socket
+import struct
+import sys
+import time
+import traceback
+import types
+
+import clmake
+
+IdleTimeout = 600 # zygote exits when no job has been run for that long (in s)
+
+_Int  = struct.Struct('=i'  )
+_Cred = struct.Struct('=iii') # struct ucred : pid, uid, gid
+
+def _recv_all(conn,sz) :
+	res = b''
+	while len(res)<sz :
+		chunk = conn.recv(sz-len(res))
+		if not chunk : raise EOFError()
+		res += chunk
+	return res
+
+def _recv_req(conn) :
+	'return (payload,fds), payload is None for an exit request'
+	msg,ancdata,_,_ = conn.recvmsg( _Int.size , socket.CMSG_LEN(3*_Int.size) )
+	if len(msg)<_Int.size : msg += _recv_all(conn,_Int.size-len(msg))
+	fds = []
+	for level,typ,data in ancdata :
+		if level==socket.SOL_SOCKET and typ==socket.SCM_RIGHTS : fds += struct.unpack(f'={len(data)//_Int.size}i',data[:len(data)-len(data)%_Int.size])
+	sz, = _Int.unpack(msg)
+	if not sz : return None,fds
+	return _recv_all(conn,sz).decode('utf-8','surrogateescape'),fds
+
+def _warm_up(warm_up_file) :
+	with open(warm_up_file) as f : code = f.read()
+	os.unlink(warm_up_file)
+	save_argv = sys.argv
+	sys.argv  = ['-c']
+	try :
+		exec( compile(code,'<string>','exec') , {'__name__':'__zygote__','__builtins__':builtins} ) # only for side effects (mostly imports), job will execute code again
+	except BaseException :
+		traceback.print_exc()                                                                    # this is not fatal : job will see what was imported
+	sys.argv = save_argv
+
+def _serve(sock_name,deps_file) :
+	'''
+		serve job requests until idle for too long
+		return a job in a child process, None in zygote process when it must exit
+	'''
+	listener = socket.socket(socket.AF_UNIX,socket.SOCK_STREAM)
+	try :
+		listener.bind('\0'+sock_name)
+	except OSError :                                                             # another zygote won the race, let it serve
+		os.unlink(deps_file)
+		return None
+	listener.listen(64)
+	os.write(1,b'1')                                                             # tell job_exec we are ready
+	null = os.open('/dev/null',os.O_WRONLY)
+	os.dup2(null,1)
+	os.close(null)
+	#
+	wake_r,wake_w = os.pipe()
+	os.set_blocking(wake_w,False)
+	signal.signal(signal.SIGCHLD,lambda sig,frame:None)
+	signal.set_wakeup_fd(wake_w)
+	#
+	sel      = selectors.DefaultSelector()
+	greeting = deps_file.encode()
+	greeting = _Int.pack(len(greeting))+greeting
+	conns    = {}                                                                # conn -> pid if running, None if waiting for request
+	jobs     = {}                                                                # pid  -> conn
+	sel.register(listener,selectors.EVENT_READ)
+	sel.register(wake_r  ,selectors.EVENT_READ)
+	last_date = time.time()
+	def close(conn) :
+		sel.unregister(conn)
+		del conns[conn]
+		conn.close()
+	while listener or jobs or conns :
+		if jobs or conns : timeout = None
+		else             : timeout = last_date+IdleTimeout-time.time()
+		if timeout is not None and timeout<=0 :
+			sel.unregister(listener) ; listener.close() ; listener = None    # stop listening, exit once connections are done
+			continue
+		for key,_ in sel.select(timeout) :
+			obj = key.fileobj
+			if obj is listener :
+				conn,_ = listener.accept()
+				_,uid,_ = _Cred.unpack(conn.getsockopt(socket.SOL_SOCKET,socket.SO_PEERCRED,_Cred.size))
+				if uid!=os.getuid() : conn.close() ; continue                # only serve our own jobs
+				try                : conn.sendall(greeting)
+				except OSError     : conn.close() ; continue
+				conns[conn] = None
+				sel.register(conn,selectors.EVENT_READ)
+			elif obj==wake_r :
+				os.read(wake_r,4096)
+				while jobs :
+					try                      : pid,wstatus = os.waitpid(-1,os.WNOHANG)
+					except ChildProcessError : break
+					if not pid : break
+					conn = jobs.pop(pid,None)
+					if conn is None : continue
+					try            : conn.sendall(_Int.pack(wstatus))
+					except OSError : pass
+					close(conn)
+				last_date = time.time()
+			elif conns[obj] is None :                                        # waiting for request
+				try                           : req,fds = _recv_req(obj)
+				except (OSError,EOFError)     : close(obj) ; continue
+				if req is None :                                             # exit request
+					for fd in fds : os.close(fd)
+					if listener : sel.unregister(listener) ; listener.close() ; listener = None
+					close(obj)                                               # close after listener so client knows we are not listening any more when it sees eof
+					continue
+				if len(fds)!=3 :
+					for fd in fds : os.close(fd)
+					close(obj)
+					continue
+				sys.stdout.flush()
+				sys.stderr.flush()
+				pid = os.fork()
+				if not pid :                                                 # in child : forget about zygote and return job
+					signal.set_wakeup_fd(-1)
+					signal.signal(signal.SIGCHLD,signal.SIG_DFL)
+					sel.close()
+					for c in conns : c.close()
+					if listener : listener.close()
+					os.close(wake_r)
+					os.close(wake_w)
+					os.setsid()
+					for i,fd in enumerate(fds) : os.dup2(fd,i)
+					for fd in fds :
+						if fd>2 : os.close(fd)
+					return req
+				for fd in fds : os.close(fd)
+				try            : obj.sendall(_Int.pack(pid))
+				except OSError : os.killpg(pid,signal.SIGKILL)               # job will be reaped and reported to nobody
+				conns[obj] = pid
+				jobs[pid]  = obj
+			else :                                                           # running job : client hung up or misbehaved, kill job
+				pid = conns[obj]
+				try            : os.killpg(pid,signal.SIGKILL)
+				except OSError : pass
+				del jobs[pid]
+				close(obj)
+	os.unlink(deps_file)
+	return None
+
+def _run(req) :
+	'run job as python -c would, return exit status'
+	cwd,n_args,*rest = req.split('\0')
+	n_args = int(n_args)
+	args   = rest[:n_args]
+	env    = rest[n_args:]
+	try :
+		os.chdir(cwd)
+	except OSError as e :
+		print(f'cannot chdir to {cwd} : {e}',file=sys.stderr)
+		return 1
+	os.environ.clear()
+	for kv in env :
+		k,v = kv.split('=',1)
+		os.environ[k] = v
+	clmake._reset_autodep()                                                 # autodep must now report to job_exec of our job
+	#
+	sys.dont_write_bytecode = bool(sys.flags.dont_write_bytecode)
+	importlib.invalidate_caches()                                            # repo may have changed since zygote has looked at it
+	if 'tempfile' in sys.modules : sys.modules['tempfile'].tempdir = None    # TMPDIR is job specific
+	main = types.ModuleType('__main__')
+	if args[0]=='-c' :
+		code        = args[1]
+		filename    = '<string>'
+		sys.argv    = ['-c',*args[2:]]
+		sys.path[0] = ''
+	else :
+		filename = args[0]
+		with open(filename) as f : code = f.read()
+		sys.argv      = args
+		sys.path[0]   = os.path.dirname(os.path.realpath(filename))
+		main.__file__ = filename
+	sys.modules['__main__'] = main
+	try :
+		exec( compile(code,filename,'exec') , main.__dict__ )
+	except Exception :
+		typ,val,tb = sys.exc_info()
+		sys.excepthook(typ,val,tb.tb_next)                                   # hide our own frame
+		return 1
+	return 0
+
+def main() :
+	sock_name,warm_up_file,deps_file,log_file = sys.argv[1:]
+	sys.dont_write_bytecode = True                                           # writing pyc files would be reported to no job
+	_warm_up(warm_up_file)
+	clmake.set_autodep(False)                                                # all accesses that may be of interest to jobs have been recorded
+	#
+	pid = os.fork()                                                          # detach from job_exec, which waits for us
+	if pid : os._exit(0)
+	req = _serve(sock_name,deps_file)
+	if req is None :
+		os.unlink(log_file)                                                  # log is only meaningful while zygote lives
+		return 0
+	return _run(req)
@@ -71,3 +71,11 @@ def lmake(*args,rc=0,summary=None,**kwds) :
 		raise
 	finally :
 		sys.stdout.flush()
+
+# build target twice so that exec times are known from the first run when jobs are launched during the second one
+# jobs (named by tgts) must depend on file trig and print $SEQUENCE_ID (allocated by server in launch order) as first word of their target
+# return a dict giving launch order of each job during the second run
+def launch_order( target , tgts ) :
+	print(1,file=open('trig','w')) ; lmake( target , new=1     , may_rerun=1 , done=len(tgts) , steady=1 )
+	print(2,file=open('trig','w')) ; lmake( target , changed=1 ,               done=len(tgts) , steady=1 )
+	return { t:int(open(t).read().split()[0]) for t in tgts }
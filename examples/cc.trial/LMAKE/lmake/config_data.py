@@ -0,0 +1,175 @@
+{
+	'config' : {
+		'disk_date_precision' : 0.01
+	,	'heartbeat'           : 10
+	,	'heartbeat_tick'      : 0.1
+	,	'link_support'        : 'Full'
+	,	'max_dep_depth'       : 1000
+	,	'max_error_lines'     : 100
+	,	'network_delay'       : 1
+	,	'path_max'            : 400
+	,	'sub_prio_boost'      : 1
+	,	'console'             : {'date_precision': None, 'has_exec_time': True, 'host_length': None, 'show_eta': True}
+	,	'backends'            : {'precisions': {'cpu': 8, 'mem': 8, 'tmp': 8}, 'local': {'cpu': 1, 'mem': '6013M', 'tmp': '238663M'}}
+	,	'debug'               : {'': 'lmake_debug.default', 'u': 'lmake_debug.pudb', 'n': 'lmake_debug.none', 'e': 'lmake_debug.enter', 'c': 'lmake_debug.vscode', 'g': 'lmake_debug.gdb'}
+	,	'caches'              : {}
+	,	'colors'              : {'hidden_note': [[192, 192, 192], [96, 96, 96]], 'hidden_ok': [[176, 208, 176], [80, 112, 80]], 'note': [[0, 0, 255], [64, 160, 255]], 'ok': [[0, 128, 0], [128, 255, 128]], 'warning': [[155, 0, 255], [255, 0, 255]], 'err': [[180, 0, 0], [255, 60, 60]], 'speculate_err': [[220, 80, 0], [255, 128, 50]]}
+	,	'trace'               : {}
+	,	'has_split_rules'     : False
+	,	'has_split_srcs'      : True
+	}
+,	'rules' : (
+		{
+			'name'               : 'Dir'
+		,	'stems'              : {}
+		,	'matches'            : {'<stdout>': ('{Dir:.+}/...', 'target')}
+		,	'job_name'           : '{Dir:.+}/...'
+		,	'max_submit_count'   : 10
+		,	'create_none_attrs'  : ({},)
+		,	'cache_none_attrs'   : ({},)
+		,	'deps_attrs'         : ({},)
+		,	'submit_rsrcs_attrs' : ({'backend': 'local', 'rsrcs': {'cpu': 1}},)
+		,	'submit_none_attrs'  : ({'n_retries': 1},)
+		,	'start_cmd_attrs'    : ({'env': {'HOME': '/root/repo/examples/cc.trial', 'PATH': '/root/repo/bin:/.rbenv/shims:/root/.rbenv/bin:/root/.cargo/bin:/root/miniconda/condabin:/.pyenv/bin:/.pyenv/shims:/usr/local/bin:/usr/local/sbin:/usr/bin:/usr/sbin:/bin:/sbin:.', 'LD_LIBRARY_PATH': '/root/.pyenv/versions/3.11.7/lib'}, 'interpreter': ('/bin/bash',)},)
+		,	'start_rsrcs_attrs'  : ({'autodep': 'ld_audit'},)
+		,	'start_none_attrs'   : ({'start_delay': 3.0, 'kill_sigs': (9,), 'n_retries': 1, 'env': {'UID': '0', 'USER': 'root'}},)
+		,	'end_cmd_attrs'      : ({},)
+		,	'end_none_attrs'     : ({'max_stderr_len': 100},)
+		,	'is_python'          : False
+		,	'cmd'                : ({'cmd': ''},)
+		}
+	,	{
+			'name'               : 'NoComment'
+		,	'stems'              : {'File': '.+', 'Exe': '.+', 'Test': '[^-]+'}
+		,	'matches'            : {'<stdout>': ('{File}.nc', 'target'), '__PYC__': ('{*:(.+/)?}__pycache__/{*:\\w+}.{*:\\w+-\\d+}.pyc', 'side_targets', ('Incremental',)), '__PY__': ('{*:(.+/)?}{*:\\w+}.py', 'side_deps', ('StatReadData',))}
+		,	'job_name'           : '{File}.nc'
+		,	'max_submit_count'   : 10
+		,	'create_none_attrs'  : ({},)
+		,	'cache_none_attrs'   : ({},)
+		,	'deps_attrs'         : ({'<stdin>': '{File}'},)
+		,	'submit_rsrcs_attrs' : ({'backend': 'local', 'rsrcs': {'cpu': 1}},)
+		,	'submit_none_attrs'  : ({'n_retries': 1},)
+		,	'start_cmd_attrs'    : ({'env': {'PYTHONPATH': '/root/repo/lib:/root/repo/examples/cc.trial', 'HOME': '/root/repo/examples/cc.trial', 'PATH': '/root/repo/bin:/.rbenv/shims:/root/.rbenv/bin:/root/.cargo/bin:/root/miniconda/condabin:/.pyenv/bin:/.pyenv/shims:/usr/local/bin:/usr/local/sbin:/usr/bin:/usr/sbin:/bin:/sbin:.', 'LD_LIBRARY_PATH': '/root/.pyenv/versions/3.11.7/lib'}, 'interpreter': ('/root/.pyenv/shims/python3',)},)
+		,	'start_rsrcs_attrs'  : ({'autodep': 'ld_audit'},)
+		,	'start_none_attrs'   : ({'start_delay': 3.0, 'kill_sigs': (9,), 'n_retries': 1, 'env': {'UID': '0', 'USER': 'root'}},)
+		,	'end_cmd_attrs'      : ({},)
+		,	'end_none_attrs'     : ({'max_stderr_len': 100},)
+		,	'is_python'          : True
+		,	'cmd'                : ({'cmd': "py_rule = 'Py3Rule'\n_lmake_dir = '/root/repo'\ndef cmd0() :                                                                 # this will be executed before cmd() of concrete subclasses as cmd() are chained in case of inheritance\n\t\timport sys\n\t\tif py_rule==None                                    : raise RuntimeError('cannot determine what kind of PyRule is used'                                          )\n\t\tif py_rule=='Py2Rule' and sys.version_info.major!=2 : raise RuntimeError('cannot use %s with python%d.%d'%(py_rule,sys.version_info.major,sys.version_info.minor))\n\t\tif py_rule=='Py3Rule' and sys.version_info.major!=3 : raise RuntimeError('cannot use %s with python%d.%d'%(py_rule,sys.version_info.major,sys.version_info.minor))\n\t\ttry : import lmake\n\t\texcept ImportError :\n\t\t\tsys.path[0:0] = (_lmake_dir+'/lib',)\n\t\tfrom lmake.import_machinery import fix_import\n\t\tfix_import(py_rule)\nimport sys\ndef cmd1() :                                                     # when cmd is a function, it is called to run the job (remember it is transported for remote execution)\n\t\timport re\n\t\ttext     = sys.stdin.read()                                 # sys is imported from the global environment\n\t\tfiltered = re.sub('(^|\\n)\\n+',r'\\1',re.sub(r'#.*','',text)) # strip comments and empty lines\n\t\tprint(filtered,end='')\ndef cmd() :\n\tcmd0()\n\treturn cmd1()\n"}, (), '', '', "try :\n\t(lambda:None).__code__.replace(co_filename='',co_firstlineno=1)\n\tdef sourcify(func,module,qualname,filename,firstlineno) :\n\t\ttry :\n\t\t\tfunc.__code__     = func.__code__.replace( co_filename=filename , co_firstlineno=firstlineno )\n\t\t\tfunc.__module__   = module\n\t\t\tfunc.__qualname__ = qualname\n\t\texcept : pass\nexcept :\n\tdef sourcify(func,module,qualname,filename,firstlineno) :\n\t\ttry :\n\t\t\tc    = func.__code__\n\t\t\targs = [c.co_argcount]\n\t\t\tif hasattr(c,'co_posonlyargcount') : args.append(c.co_posonlyargcount)\n\t\t\tif hasattr(c,'co_kwonlyargcount' ) : args.append(c.co_kwonlyargcount )\n\t\t\targs += [\n\t\t\t\tc.co_nlocals\n\t\t\t,\tc.co_stacksize\n\t\t\t,\tc.co_flags\n\t\t\t,\tc.co_code\n\t\t\t,\tc.co_consts\n\t\t\t,\tc.co_names\n\t\t\t,\tc.co_varnames\n\t\t\t,\tfilename\n\t\t\t,\tc.co_name\n\t\t\t,\tfirstlineno\n\t\t\t,\tc.co_lnotab\n\t\t\t,\tc.co_freevars\n\t\t\t,\tc.co_cellvars\n\t\t\t]\n\t\t\tfunc.__code__     = c.__class__(*args)\n\t\t\tfunc.__module__   = module\n\t\t\tfunc.__qualname__ = qualname\n\t\texcept : pass\nsourcify(cmd0,'lmake.rules','_PyRule.cmd','../../lib/lmake/rules.py',156)\nsourcify(cmd1,'Lmakefile','NoComment.cmd','Lmakefile.py',40)\n")
+		}
+	,	{
+			'name'               : 'Compile'
+		,	'stems'              : {'File': '.+', 'Exe': '.+', 'Test': '[^-]+'}
+		,	'matches'            : {'OBJ': ('{File}.o', 'target')}
+		,	'job_name'           : '{File}.o'
+		,	'max_submit_count'   : 10
+		,	'create_none_attrs'  : ({},)
+		,	'cache_none_attrs'   : ({},)
+		,	'deps_attrs'         : ({'SRC': '{File}.c'},)
+		,	'submit_rsrcs_attrs' : ({'backend': 'local', 'rsrcs': {'cpu': 1}},)
+		,	'submit_none_attrs'  : ({'n_retries': 1},)
+		,	'start_cmd_attrs'    : ({'env': {'HOME': '/root/repo/examples/cc.trial', 'PATH': '/root/repo/bin:/.rbenv/shims:/root/.rbenv/bin:/root/.cargo/bin:/root/miniconda/condabin:/.pyenv/bin:/.pyenv/shims:/usr/local/bin:/usr/local/sbin:/usr/bin:/usr/sbin:/bin:/sbin:.', 'LD_LIBRARY_PATH': '/root/.pyenv/versions/3.11.7/lib'}, 'interpreter': ('/bin/bash',)},)
+		,	'start_rsrcs_attrs'  : ({'autodep': 'ld_audit'},)
+		,	'start_none_attrs'   : ({'start_delay': 3.0, 'kill_sigs': (9,), 'n_retries': 1, 'env': {'UID': '0', 'USER': 'root'}},)
+		,	'end_cmd_attrs'      : ({},)
+		,	'end_none_attrs'     : ({'max_stderr_len': 100},)
+		,	'is_python'          : False
+		,	'cmd'                : ({}, ('OBJ', 'SRC'), "flags = '-O0'\n", "f'lrun_cc gcc {flags} -c -std=c99 -o{OBJ} {SRC}'", '')
+		}
+	,	{
+			'name'               : 'Link'
+		,	'stems'              : {'File': '.+', 'Exe': '.+', 'Test': '[^-]+'}
+		,	'matches'            : {'EXE': ('{Exe}.exe', 'target')}
+		,	'job_name'           : '{Exe}.exe'
+		,	'max_submit_count'   : 10
+		,	'create_none_attrs'  : ({},)
+		,	'cache_none_attrs'   : ({},)
+		,	'deps_attrs'         : ({'LST': ('{Exe}.olst.nc', 'critical')},)
+		,	'submit_rsrcs_attrs' : ({'backend': 'local', 'rsrcs': {'cpu': 1}},)
+		,	'submit_none_attrs'  : ({'n_retries': 1},)
+		,	'start_cmd_attrs'    : ({'env': {'HOME': '/root/repo/examples/cc.trial', 'PATH': '/root/repo/bin:/.rbenv/shims:/root/.rbenv/bin:/root/.cargo/bin:/root/miniconda/condabin:/.pyenv/bin:/.pyenv/shims:/usr/local/bin:/usr/local/sbin:/usr/bin:/usr/sbin:/bin:/sbin:.', 'LD_LIBRARY_PATH': '/root/.pyenv/versions/3.11.7/lib'}, 'interpreter': ('/bin/bash',)},)
+		,	'start_rsrcs_attrs'  : ({'autodep': 'ld_audit'},)
+		,	'start_none_attrs'   : ({'start_delay': 3.0, 'kill_sigs': (9,), 'n_retries': 1, 'env': {'UID': '0', 'USER': 'root'}},)
+		,	'end_cmd_attrs'      : ({},)
+		,	'end_none_attrs'     : ({'max_stderr_len': 100},)
+		,	'is_python'          : False
+		,	'cmd'                : ({'cmd': "\n\t\tsed 's:.*:\\0.o:' {LST} >$TMPDIR/olst           # $TMPDIR is guaranteed empty at job startup time\n\t\techo link objects : ; cat $TMPDIR/olst\n\t\tlrun_cc gcc -o{EXE} $(cat $TMPDIR/olst)        # and there is no need to clean it up, this is done automatically by lmake\n\t"},)
+		}
+	,	{
+			'name'               : 'Run'
+		,	'stems'              : {'File': '.+', 'Exe': '.+', 'Test': '[^-]+'}
+		,	'matches'            : {'<stdout>': ('{Exe}-{Test}.out', 'target')}
+		,	'job_name'           : '{Exe}-{Test}.out'
+		,	'max_submit_count'   : 10
+		,	'create_none_attrs'  : ({},)
+		,	'cache_none_attrs'   : ({},)
+		,	'deps_attrs'         : ({'EXE': '{Exe}.exe', 'IN': '{Exe}-{Test}.scn.nc'},)
+		,	'submit_rsrcs_attrs' : ({'backend': 'local', 'rsrcs': {'cpu': 1}},)
+		,	'submit_none_attrs'  : ({'n_retries': 1},)
+		,	'start_cmd_attrs'    : ({'env': {'HOME': '/root/repo/examples/cc.trial', 'PATH': '/root/repo/bin:/.rbenv/shims:/root/.rbenv/bin:/root/.cargo/bin:/root/miniconda/condabin:/.pyenv/bin:/.pyenv/shims:/usr/local/bin:/usr/local/sbin:/usr/bin:/usr/sbin:/bin:/sbin:.', 'LD_LIBRARY_PATH': '/root/.pyenv/versions/3.11.7/lib'}, 'interpreter': ('/bin/bash',)},)
+		,	'start_rsrcs_attrs'  : ({'autodep': 'ld_audit'},)
+		,	'start_none_attrs'   : ({'start_delay': 3.0, 'kill_sigs': (9,), 'n_retries': 1, 'env': {'UID': '0', 'USER': 'root'}},)
+		,	'end_cmd_attrs'      : ({},)
+		,	'end_none_attrs'     : ({'max_stderr_len': 100},)
+		,	'is_python'          : False
+		,	'cmd'                : ({'cmd': './{EXE} "$(cat {IN})"'},)
+		}
+	,	{
+			'name'               : 'Chk'
+		,	'stems'              : {'File': '.+', 'Exe': '.+', 'Test': '[^-]+'}
+		,	'matches'            : {'<stdout>': ('{Exe}-{Test}.ok', 'target')}
+		,	'job_name'           : '{Exe}-{Test}.ok'
+		,	'max_submit_count'   : 10
+		,	'create_none_attrs'  : ({},)
+		,	'cache_none_attrs'   : ({},)
+		,	'deps_attrs'         : ({'DUT': '{Exe}-{Test}.out', 'REF': '{Exe}-{Test}.ref.nc'},)
+		,	'submit_rsrcs_attrs' : ({'backend': 'local', 'rsrcs': {'cpu': 1}},)
+		,	'submit_none_attrs'  : ({'n_retries': 1},)
+		,	'start_cmd_attrs'    : ({'env': {'HOME': '/root/repo/examples/cc.trial', 'PATH': '/root/repo/bin:/.rbenv/shims:/root/.rbenv/bin:/root/.cargo/bin:/root/miniconda/condabin:/.pyenv/bin:/.pyenv/shims:/usr/local/bin:/usr/local/sbin:/usr/bin:/usr/sbin:/bin:/sbin:.', 'LD_LIBRARY_PATH': '/root/.pyenv/versions/3.11.7/lib'}, 'interpreter': ('/bin/bash',)},)
+		,	'start_rsrcs_attrs'  : ({'autodep': 'ld_audit'},)
+		,	'start_none_attrs'   : ({'start_delay': 3.0, 'kill_sigs': (9,), 'n_retries': 1, 'env': {'UID': '0', 'USER': 'root'}},)
+		,	'end_cmd_attrs'      : ({},)
+		,	'end_none_attrs'     : ({'max_stderr_len': 100},)
+		,	'is_python'          : False
+		,	'cmd'                : ({'cmd': 'diff {REF} {DUT}>&2'},)
+		}
+	,	{
+			'name'               : 'Scenarios'
+		,	'stems'              : {'File': '.+', 'Exe': '.+', 'Test': '[^-]+'}
+		,	'matches'            : {'LST': ('{Exe}.tlst', 'target'), 'SCN': ('{Exe}-{Test*}.scn', 'target'), 'REF': ('{Exe}-{Test*}.ref', 'target')}
+		,	'job_name'           : '{Exe}.tlst'
+		,	'max_submit_count'   : 10
+		,	'create_none_attrs'  : ({},)
+		,	'cache_none_attrs'   : ({},)
+		,	'deps_attrs'         : ({'<stdin>': '{Exe}.regr.nc'},)
+		,	'submit_rsrcs_attrs' : ({'backend': 'local', 'rsrcs': {'cpu': 1}},)
+		,	'submit_none_attrs'  : ({'n_retries': 1},)
+		,	'start_cmd_attrs'    : ({'env': {'HOME': '/root/repo/examples/cc.trial', 'PATH': '/root/repo/bin:/.rbenv/shims:/root/.rbenv/bin:/root/.cargo/bin:/root/miniconda/condabin:/.pyenv/bin:/.pyenv/shims:/usr/local/bin:/usr/local/sbin:/usr/bin:/usr/sbin:/bin:/sbin:.', 'LD_LIBRARY_PATH': '/root/.pyenv/versions/3.11.7/lib'}, 'interpreter': ('/root/.pyenv/shims/python3',)},)
+		,	'start_rsrcs_attrs'  : ({'autodep': 'ld_audit'},)
+		,	'start_none_attrs'   : ({'start_delay': 3.0, 'kill_sigs': (9,), 'n_retries': 1, 'env': {'UID': '0', 'USER': 'root'}},)
+		,	'end_cmd_attrs'      : ({},)
+		,	'end_none_attrs'     : ({'max_stderr_len': 100},)
+		,	'is_python'          : True
+		,	'cmd'                : ({'cmd': "import sys\ndef cmd() :\n\t\twith open(LST,'w') as lst :\n\t\t\tfor l in sys.stdin.readlines() :\n\t\t\t\ttest,scn,ref = (x.strip() for x in l.split(':'))\n\t\t\t\tprint(scn ,file=open(SCN(test),'w'))\n\t\t\t\tprint(ref ,file=open(REF(test),'w'))\n\t\t\t\tprint(test,file=lst                )\n"}, ('LST', 'SCN', 'REF'), '', '', "try :\n\tcmd.__code__     = cmd.__code__.replace( co_filename='Lmakefile.py' , co_firstlineno=96 )\n\tcmd.__module__   = 'Lmakefile'\n\tcmd.__qualname__ = 'Scenarios.cmd'\nexcept :\n\ttry :\n\t\tc    = cmd.__code__\n\t\targs = [c.co_argcount]\n\t\tif hasattr(c,'co_posonlyargcount') : args.append(c.co_posonlyargcount)\n\t\tif hasattr(c,'co_kwonlyargcount' ) : args.append(c.co_kwonlyargcount )\n\t\targs += [\n\t\t\tc.co_nlocals\n\t\t,\tc.co_stacksize\n\t\t,\tc.co_flags\n\t\t,\tc.co_code\n\t\t,\tc.co_consts\n\t\t,\tc.co_names\n\t\t,\tc.co_varnames\n\t\t,\t'Lmakefile.py'\n\t\t,\tc.co_name\n\t\t,\t96\n\t\t,\tc.co_lnotab\n\t\t,\tc.co_freevars\n\t\t,\tc.co_cellvars\n\t\t]\n\t\tcmd.__code__     = c.__class__(*args)\n\t\tcmd.__module__   = 'Lmakefile'\n\t\tcmd.__qualname__ = 'Scenarios.cmd'\n\texcept : pass\n")
+		}
+	,	{
+			'name'               : 'Regr'
+		,	'stems'              : {'File': '.+', 'Exe': '.+', 'Test': '[^-]+'}
+		,	'matches'            : {'<stdout>': ('{Exe}.ok', 'target')}
+		,	'job_name'           : '{Exe}.ok'
+		,	'max_submit_count'   : 10
+		,	'create_none_attrs'  : ({},)
+		,	'cache_none_attrs'   : ({},)
+		,	'deps_attrs'         : ({'LST': ('{Exe}.tlst.nc', 'critical')},)
+		,	'submit_rsrcs_attrs' : ({'backend': 'local', 'rsrcs': {'cpu': 1}},)
+		,	'submit_none_attrs'  : ({'n_retries': 1},)
+		,	'start_cmd_attrs'    : ({'env': {'HOME': '/root/repo/examples/cc.trial', 'PATH': '/root/repo/bin:/.rbenv/shims:/root/.rbenv/bin:/root/.cargo/bin:/root/miniconda/condabin:/.pyenv/bin:/.pyenv/shims:/usr/local/bin:/usr/local/sbin:/usr/bin:/usr/sbin:/bin:/sbin:.', 'LD_LIBRARY_PATH': '/root/.pyenv/versions/3.11.7/lib'}, 'interpreter': ('/bin/bash',)},)
+		,	'start_rsrcs_attrs'  : ({'autodep': 'ld_audit'},)
+		,	'start_none_attrs'   : ({'start_delay': 3.0, 'kill_sigs': (9,), 'n_retries': 1, 'env': {'UID': '0', 'USER': 'root'}},)
+		,	'end_cmd_attrs'      : ({},)
+		,	'end_none_attrs'     : ({'max_stderr_len': 100},)
+		,	'is_python'          : False
+		,	'cmd'                : ({'cmd': "\n\t\tldepend $(sed 's:.*:{Exe}-\\0.ok:' {LST})          # ldepend sets dependencies, so the regression is ok as soon as all tests are ok\n\t"},)
+		}
+	)
+}
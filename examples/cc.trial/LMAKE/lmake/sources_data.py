@@ -0,0 +1,13 @@
+{
+	'manifest' : (
+		'Manifest'
+	,	'Lmakefile.py'
+	,	'hello.h'
+	,	'hello.c'
+	,	'world.h'
+	,	'world.c'
+	,	'hello_world.c'
+	,	'hello_world.olst'
+	,	'hello_world.regr'
+	)
+}
@@ -0,0 +1 @@
+duke
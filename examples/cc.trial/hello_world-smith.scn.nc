@@ -0,0 +1 @@
+Mr Smith
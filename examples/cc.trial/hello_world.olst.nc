@@ -0,0 +1,3 @@
+hello
+world
+hello_world
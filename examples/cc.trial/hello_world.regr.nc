@@ -0,0 +1,2 @@
+smith  : Mr Smith : hello Mr Smith
+world  :          : hello world
@@ -0,0 +1,2 @@
+smith
+world
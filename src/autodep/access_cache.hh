@@ -0,0 +1,73 @@
+// This file is part of the open-lmake distribution (git@github.com:cesar-douady/open-lmake.git)
+// Copyright (c) 2023 Doliam
+// This program is free software: you can redistribute/modify under the terms of the GPL-v3 (https://www.gnu.org/licenses/gpl-3.0.html).
+// This program is distributed WITHOUT ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+#pragma once
+
+#include <sys/mman.h> // mmap, munmap
+
+#include <new>        // placement new
+
+#include "disk.hh"
+
+// AccessCache is a job-wide cache of read accesses, shared by all processes of the job so a read already reported by any of them is not reported again :
+// - it is created by Gather in a file mapped by all processes of the job, typically in /dev/shm
+// - it is a lock-free open addressing hash table whose buckets are never freed, file names are stored in an append only arena
+// - a bucket is reserved by setting its hash, then its name is filled in and published by setting name_pos
+// - accesses are merged with atomic or's so that exactly one process sees a given access as new and reports it
+// - if the table or the arena is full, or if a bucket is left half filled by a killed process, callers must fall back to a per-process cache
+struct AccessCache {
+	using Val = Accesses::Val ;
+	static constexpr size_t   NBuckets  = 1<<16   ;                                  // must be a power of 2
+	static constexpr size_t   MaxProbes = 64      ;
+	static constexpr size_t   MaxSpins  = 1<<16   ;                                  // wait that long for a concurrent insertion of the same hash to complete
+	static constexpr size_t   ArenaSz   = 16<<20  ;                                  // only touched pages are actually allocated
+	static constexpr uint32_t BadPos    = -1      ;                                  // name could not be recorded, bucket is unusable
+	struct Bucket {
+		::atomic<uint64_t> hash     = 0 ;                                            // 0 means free
+		::atomic<uint32_t> name_pos = 0 ;                                            // 0 means being filled, else 1+position in arena
+		uint32_t           name_sz  = 0 ;
+		::atomic<Val>      accessed = 0 ;
+		::atomic<Val>      seen     = 0 ;
+	} ;
+	// statics
+	static size_t s_sz() { return sizeof(AccessCache) + NBuckets*sizeof(Bucket) + ArenaSz ; }
+	static AccessCache* s_map( Fd fd , bool init ) {                                 // return nullptr if mapping is not possible
+		if ( init && ::ftruncate(fd,s_sz())!=0 ) return nullptr ;
+		void* res = ::mmap( nullptr , s_sz() , PROT_READ|PROT_WRITE , MAP_SHARED , fd , 0 ) ;
+		if (res==MAP_FAILED) return nullptr ;
+		if (init) return new(res) AccessCache ;                                      // buckets are zero initialized by ftruncate
+		return static_cast<AccessCache*>(res) ;
+	}
+	static void s_unmap(AccessCache* ac) { ::munmap(ac,s_sz()) ; }
+	// accesses
+	Bucket* _buckets() { return reinterpret_cast<Bucket*>(this+1)            ; }
+	char*   _arena  () { return reinterpret_cast<char*  >(_buckets()+NBuckets) ; }
+	// services
+	Bucket* bucket(::string const& file) {                                           // find or insert file, return nullptr if not possible
+		uint64_t h = ::hash<::string>()(file) ; if (!h) h = 1 ;                      // 0 is reserved for free buckets
+		for( size_t i=0 ; i<MaxProbes ; i++ ) {
+			Bucket&  b  = _buckets()[(h+i)&(NBuckets-1)] ;
+			uint64_t bh = b.hash.load(::memory_order_acquire) ;
+			if ( !bh && b.hash.compare_exchange_strong(bh,h) ) {                     // we own bucket, fill it
+				uint32_t pos = arena_pos.fetch_add(file.size()) ;
+				if (pos+file.size()>ArenaSz) { b.name_pos = BadPos ; return nullptr ; }
+				::memcpy( _arena()+pos , file.data() , file.size() ) ;
+				b.name_sz = file.size() ;
+				b.name_pos.store( pos+1 , ::memory_order_release ) ;
+				return &b ;
+			}
+			if (bh!=h) continue ;                                                    // bh has been updated if we lost the race
+			uint32_t np = 0 ;
+			for( size_t s=0 ; s<MaxSpins ; s++ ) if ((np=b.name_pos.load(::memory_order_acquire))) break ;
+			if ( !np || np==BadPos                                                            ) return nullptr ; // cannot know if this is our file
+			if ( b.name_sz==file.size() && ::memcmp(_arena()+np-1,file.data(),file.size())==0 ) return &b     ;
+		}
+		return nullptr ;
+	}
+	// data
+	::atomic<uint32_t> arena_pos = 0 ;
+	char               _pad[64-sizeof(uint32_t)] ;                                   // keep buckets cache aligned
+} ;
+static_assert( sizeof(AccessCache)%64==0 ) ;
@@ -10,6 +10,7 @@ namespace Backdoor {
 	::umap_s<Func> const& get_func_tab() {
 		static ::umap_s<Func> s_tab = {
 			{ Enable::Cmd , func<Enable> }
+		,	{ Reset ::Cmd , func<Reset > }
 		,	{ Solve ::Cmd , func<Solve > }
 		} ;
 		return s_tab ;
@@ -28,6 +29,19 @@ namespace Backdoor {
 		return res ;
 	}
 
+	//
+	// Reset
+	//
+	::ostream& operator<<( ::ostream& os , Reset const& r ) {
+		return os<<"Reset("<<r.autodep_env<<')' ;
+	}
+	size_t Reset::reply_len() const { return 1 ; } // just a bool
+	Reset::Reply Reset::process(Record& r) const {
+		Record::s_reset_autodep_env(autodep_env) ;
+		r = {New} ;                                 // Record's must be rebuilt after a reset, enable is reset to what env says
+		return true ;
+	}
+
 	//
 	// Solve
 	//
@@ -54,6 +54,16 @@ namespace Backdoor {
 		Bool3 enable = Maybe ; // Maybe means dont update record state
 	} ;
 
+	struct Reset {
+		friend ::ostream& operator<<( ::ostream& , Reset const& ) ;
+		static constexpr char Cmd[] = "reset" ;
+		using Reply = bool/*done*/ ;
+		size_t reply_len(         ) const ;
+		Reply  process  (Record& r) const ;
+		// data
+		::string autodep_env ; // new autodep env, as found in LMAKE_AUTODEP_ENV
+	} ;
+
 	struct Solve {
 		friend ::ostream& operator<<( ::ostream& , Solve const& ) ;
 		static constexpr char Cmd[] = "solve" ;
@@ -237,9 +237,27 @@ static PyObject* set_autodep( PyObject* /*null*/ , PyObject* args , PyObject* kw
 	return None.to_py_boost() ;
 }
 
+static PyObject* _reset_autodep( PyObject* /*null*/ , PyObject* args , PyObject* kwds ) { // forget all about previous job, LMAKE_AUTODEP_ENV must describe the new one
+	Tuple const& py_args = *from_py<Tuple const>(args) ;
+	size_t       n_args  = py_args.size()              ;
+	if (kwds    ) return py_err_set(Exception::TypeErr,"expected no keyword args") ;
+	if (n_args>0) return py_err_set(Exception::TypeErr,"expected no args"        ) ;
+	::string ade = get_env("LMAKE_AUTODEP_ENV") ;
+	Record::s_reset_autodep_env(ade) ;                                                     // our own copy of Record, distinct from the one in autodep lib
+	_g_record = {New,Yes/*enabled*/} ;
+	//vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+	Backdoor::call(Backdoor::Reset{.autodep_env=ade}) ;
+	//^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
+	return None.to_py_boost() ;
+}
+
 #define F(name,descr) { #name , reinterpret_cast<PyCFunction>(name) , METH_VARARGS|METH_KEYWORDS , descr }
 static PyMethodDef funcs[] = {
-	F( check_deps ,
+	F( _reset_autodep ,
+		"_reset_autodep()\n"
+		"Internal use only : forget all about the previous job, LMAKE_AUTODEP_ENV describes the new one.\n"
+	)
+,	F( check_deps ,
 		"check_deps(verbose=false)\n"
 		"Ensure that all previously seen deps are up-to-date.\n"
 		"Job will be killed in case some deps are not up-to-date.\n"
@@ -318,15 +336,16 @@ PyMODINIT_FUNC
 	_g_record = {New,Yes/*enabled*/} ;
 	//
 	Ptr<Module> mod    { PY_MAJOR_VERSION<3?"clmake2":"clmake" , funcs } ;
-	Ptr<Tuple>  py_ads { HAS_FUSE+HAS_LD_AUDIT+3 }                       ; // PER_AUTODEP_METHOD : add entries here
-	Ptr<Tuple>  py_bes { 1+HAS_SGE+HAS_SLURM     }                       ; // PER_BACKEND        : add entries here
+	Ptr<Tuple>  py_ads { HAS_FUSE+HAS_LD_AUDIT+HAS_SECCOMP_NOTIF+3 }     ; // PER_AUTODEP_METHOD : add entries here
+	Ptr<Tuple>  py_bes { 1+HAS_SGE+HAS_SLURM                       }     ; // PER_BACKEND        : add entries here
 	//
 	size_t i = 0 ;
-	if (HAS_FUSE    ) py_ads->set_item(i++,*Ptr<Str>("fuse"               )) ;
-	if (HAS_LD_AUDIT) py_ads->set_item(i++,*Ptr<Str>("ld_audit"           )) ;
-	/**/              py_ads->set_item(i++,*Ptr<Str>("ld_preload"         )) ;
-	/**/              py_ads->set_item(i++,*Ptr<Str>("ld_preload_jemalloc")) ;
-	/**/              py_ads->set_item(i++,*Ptr<Str>("ptrace"             )) ;
+	if (HAS_FUSE         ) py_ads->set_item(i++,*Ptr<Str>("fuse"               )) ;
+	if (HAS_LD_AUDIT     ) py_ads->set_item(i++,*Ptr<Str>("ld_audit"           )) ;
+	/**/                   py_ads->set_item(i++,*Ptr<Str>("ld_preload"         )) ;
+	/**/                   py_ads->set_item(i++,*Ptr<Str>("ld_preload_jemalloc")) ;
+	/**/                   py_ads->set_item(i++,*Ptr<Str>("ptrace"             )) ;
+	if (HAS_SECCOMP_NOTIF) py_ads->set_item(i++,*Ptr<Str>("seccomp"            )) ;
 	SWEAR(i==py_ads->size(),i,py_ads->size()) ;
 	i = 0 ;
 	/**/              py_bes->set_item(i++,*Ptr<Str>("local"              )) ;
@@ -337,6 +356,7 @@ PyMODINIT_FUNC
 	mod->set_attr( "root_dir"    , *Ptr<Str>(no_slash(Record::s_autodep_env().root_dir_s).c_str()) ) ;
 	mod->set_attr( "backends"    , *py_bes                                                         ) ;
 	mod->set_attr( "autodeps"    , *py_ads                                                         ) ;
+	mod->set_attr( "has_pcre"    , *Ptr<Bool>(bool(HAS_PCRE))                                      ) ;
 	mod->set_attr( "no_crc"      , *Ptr<Int>(+Crc::Unknown)                                        ) ;
 	mod->set_attr( "crc_a_link"  , *Ptr<Int>(+Crc::Lnk    )                                        ) ;
 	mod->set_attr( "crc_a_reg"   , *Ptr<Int>(+Crc::Reg    )                                        ) ;
@@ -9,11 +9,13 @@ using namespace Disk ;
 
 ::ostream& operator<<( ::ostream& os , AutodepEnv const& ade ) {
 	os << "AutodepEnv(" ;
-	/**/                 os <<      static_cast<RealPathEnv const&>(ade) ;
-	/**/                 os <<','<< ade.service                          ;
-	if (ade.auto_mkdir ) os <<",auto_mkdir"                              ;
-	if (ade.ignore_stat) os <<",ignore_stat"                             ;
-	if (ade.enable     ) os <<",enable"                                  ;
+	/**/                   os <<      static_cast<RealPathEnv const&>(ade) ;
+	/**/                   os <<','<< ade.service                          ;
+	if (+ade.ring        ) os <<",ring:"        <<ade.ring                 ;
+	if (+ade.access_cache) os <<",access_cache:"<<ade.access_cache         ;
+	if ( ade.auto_mkdir  ) os <<",auto_mkdir"                              ;
+	if ( ade.ignore_stat ) os <<",ignore_stat"                             ;
+	if ( ade.enable      ) os <<",enable"                                  ;
 	return os <<')' ;
 }
 
@@ -45,6 +47,12 @@ AutodepEnv::AutodepEnv( ::string const& env ) {
 	{ if (env[pos++]!=':') goto Fail ; } { if (env[pos++]!='"') goto Fail ; } root_dir_s = parse_printable<'"'>                 (env,pos                  ) ; { if (env[pos++]!='"') goto Fail ; }
 	{ if (env[pos++]!=':') goto Fail ; }                                      src_dirs_s = parse_printable<::vector_s>          (env,pos,false/*empty_ok*/) ;
 	{ if (env[pos++]!=':') goto Fail ; }                                      views      = parse_printable<::vmap_s<::vector_s>>(env,pos,false/*empty_ok*/) ;
+	if (env[pos]==':') {
+		pos++/*:*/ ;
+		{ if (env[pos++]!='"') goto Fail ; } ring         = parse_printable<'"'>(env,pos) ; { if (env[pos++]!='"') goto Fail ; }
+		{ if (env[pos++]!=':') goto Fail ; }
+		{ if (env[pos++]!='"') goto Fail ; } access_cache = parse_printable<'"'>(env,pos) ; { if (env[pos++]!='"') goto Fail ; }
+	}
 	{ if (env[pos  ]!=0  ) goto Fail ; }
 	for( ::string const& src_dir_s : src_dirs_s ) if (!is_dirname(src_dir_s)) goto Fail ;
 	return ;
@@ -70,5 +78,9 @@ AutodepEnv::operator ::string() const {
 	res <<':'<< '"'<<mk_printable<'"'>(root_dir_s                  )<<'"' ;
 	res <<':'<<      mk_printable     (src_dirs_s,false/*empty_ok*/)      ;
 	res <<':'<<      mk_printable     (views     ,false/*empty_ok*/)      ;
+	if ( +ring || +access_cache ) {
+		res <<':'<< '"'<<mk_printable<'"'>(ring        )<<'"' ;
+		res <<':'<< '"'<<mk_printable<'"'>(access_cache)<<'"' ;
+	}
 	return res ;
 }
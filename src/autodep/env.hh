@@ -12,25 +12,31 @@ struct AutodepEnv : Disk::RealPathEnv {
 	friend ::ostream& operator<<( ::ostream& , AutodepEnv const& ) ;
 	// cxtors & casts
 	AutodepEnv() = default ;
-	// env format : server:port:options:source_dirs:tmp_dir_s:root_dir_s
+	// env format : server:port:options:source_dirs:tmp_dir_s:root_dir_s[:ring:access_cache]
 	// if port is empty, server is considered a file to log deps to (which defaults to stderr if empty)
 	// if tmp_dir_s is empty, there is no tmp dir
+	// if ring is present, it is a shared memory file in which read accesses may be reported (cf. report_ring.hh)
+	// if access_cache is present, it is a shared memory file containing a job-wide cache of reported read accesses (cf. access_cache.hh)
 	AutodepEnv(::string const& env) ;
 	AutodepEnv(NewType            ) : AutodepEnv{get_env("LMAKE_AUTODEP_ENV")} {}
 	operator ::string() const ;
 	// services
 	template<IsStream S> void serdes(S& s) {
 		::serdes(s,static_cast<RealPathEnv&>(*this)) ;
+		::serdes(s,access_cache                    ) ;
 		::serdes(s,auto_mkdir                      ) ;
 		::serdes(s,enable                          ) ;
 		::serdes(s,ignore_stat                     ) ;
+		::serdes(s,ring                            ) ;
 		::serdes(s,service                         ) ;
 		::serdes(s,views                           ) ;
 	}
 	// data
-	bool                 auto_mkdir  = false ; // if true  <=> auto mkdir in case of chdir
-	bool                 enable      = true  ; // if false <=> no automatic report
-	bool                 ignore_stat = false ; // if true  <=> stat-like syscalls do not trigger dependencies
-	::string             service     ;
-	::vmap_s<::vector_s> views       ;
+	::string             access_cache ;         // if not empty <=> file containing an AccessCache shared by all processes of the job
+	bool                 auto_mkdir   = false ; // if true  <=> auto mkdir in case of chdir
+	bool                 enable       = true  ; // if false <=> no automatic report
+	bool                 ignore_stat  = false ; // if true  <=> stat-like syscalls do not trigger dependencies
+	::string             ring         ;         // if not empty <=> file containing a ReportRing where to report read accesses
+	::string             service      ;
+	::vmap_s<::vector_s> views        ;
 } ;
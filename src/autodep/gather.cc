@@ -8,9 +8,12 @@
 
 #include "fuse.hh"
 #include "ptrace.hh"
+#include "seccomp.hh"
 
 #include "gather.hh"
 
+#include "rpc_job_relay.hh"
+
 using namespace Disk ;
 using namespace Hash ;
 using namespace Time ;
@@ -130,10 +133,11 @@ void Gather::_send_to_server( Fd fd , Jerr&& jerr ) {
 	for( int i=3 ; i>=1 ; i-- ) {                                                     // retry if server exists and cannot be reached
 		bool sent = false ;
 		try {
-			ClientSockFd csfd { service_mngt } ;                                      // ensure csfd is closed only after sent = true
+			ClientSockFd csfd = JobRelay::connect( i>1?relay_sock_name:""s , JobRelayProc::Mngt , service_mngt ) ; // ensure csfd is closed only after sent = true, last trial is direct
 			//vvvvvvvvvvvvvvvvvvvvvvvvvvv
 			OMsgBuf().send( csfd , jmrr ) ;
 			//^^^^^^^^^^^^^^^^^^^^^^^^^^^
+			JobRelay::wait_ack(csfd) ;                                                // if relayed, ensure server has received request
 			sent = true ;
 		} catch (::string const& e) {
 			if (i>1) continue ;                                                       // retry
@@ -155,21 +159,40 @@ void Gather::_send_to_server( Fd fd , Jerr&& jerr ) {
 
 void Gather::_do_child( Fd report_fd , ::latch* ready ) {
 	t_thread_key = 'T' ;
-	AutodepPtrace::s_init(autodep_env) ;
-	_child.pre_exec = AutodepPtrace::s_prepare_child  ;
+	bool seccomp = method==AutodepMethod::Seccomp ;                                              // PER_AUTODEP_METHOD : handle case
+	if (seccomp) { AutodepSeccomp::s_init(autodep_env) ; _child.pre_exec = AutodepSeccomp::s_prepare_child ; }
+	else         { AutodepPtrace ::s_init(autodep_env) ; _child.pre_exec = AutodepPtrace ::s_prepare_child ; }
 	//vvvvvvvvvvvv
 	_child.spawn() ;                                                                             // /!\ although not mentioned in man ptrace, child must be launched by the tracing thread
 	//^^^^^^^^^^^^
 	ready->count_down() ;                                                                        // signal main thread that _child.pid is available
-	AutodepPtrace autodep_ptrace{_child.pid} ;
-	wstatus = autodep_ptrace.process() ;
-	_child.waited() ;                                                                            // _child is already waited by autodep_ptrace.process
+	if (seccomp) { AutodepSeccomp autodep_seccomp{_child.pid} ; wstatus = autodep_seccomp.process() ; }
+	else         { AutodepPtrace  autodep_ptrace {_child.pid} ; wstatus = autodep_ptrace .process() ; }
+	_child.waited() ;                                                                            // _child is already waited by process
 	// mimic signalfd to signal main thread child is done
 	struct signalfd_siginfo si  ; si.ssi_pid = 0 ;                                               // wstatus is already set and we do not want to wait for child
 	ssize_t                 cnt = write(report_fd,&si,sizeof(si)) ; SWEAR(cnt==sizeof(si),cnt) ; // report child end
 	Record::s_close_report() ;
 }
 
+::pair_ss Gather::s_autodep_lib_env( AutodepMethod method , ::map_ss const* env ) {
+	::pair_ss res ;
+	switch (method) {                                                                                                            // PER_AUTODEP_METHOD : handle case
+		#if HAS_32
+			#define DOLLAR_LIB "$LIB"                                                                                            // 32 bits is supported, use ld.so automatic detection feature
+		#else
+			#define DOLLAR_LIB "lib"                                                                                             // 32 bits is not supported, use standard name
+		#endif
+		case AutodepMethod::LdAudit           : res = { "LD_AUDIT"   , *g_lmake_dir_s + "_d" DOLLAR_LIB "/ld_audit.so"            } ; break ;
+		case AutodepMethod::LdPreload         : res = { "LD_PRELOAD" , *g_lmake_dir_s + "_d" DOLLAR_LIB "/ld_preload.so"          } ; break ;
+		case AutodepMethod::LdPreloadJemalloc : res = { "LD_PRELOAD" , *g_lmake_dir_s + "_d" DOLLAR_LIB "/ld_preload_jemalloc.so" } ; break ;
+		#undef DOLLAR_LIB
+	DF}
+	if (env) { if (env->contains(res.first)) res.second += ':' + env->at(res.first) ; }
+	else     { if (has_env      (res.first)) res.second += ':' + get_env(res.first) ; }
+	return res ;
+}
+
 Fd Gather::_spawn_child() {
 	SWEAR(+cmd_line) ;
 	Trace trace("_spawn_child",child_stdin,child_stdout,child_stderr) ;
@@ -183,10 +206,11 @@ Fd Gather::_spawn_child() {
 	_child.stdout_fd  = child_stdout                          ;
 	_child.stderr_fd  = child_stderr                          ;
 	_child.first_pid  = first_pid                             ;
-	if (method==AutodepMethod::Ptrace) {                                                         // PER_AUTODEP_METHOD : handle case
+	bool traced = method==AutodepMethod::Ptrace || method==AutodepMethod::Seccomp ;              // PER_AUTODEP_METHOD : handle case
+	if (traced) {
 		// we split the responsability into 2 threads :
 		// - parent watches for data (stdin, stdout, stderr & incoming connections to report deps)
-		// - child launches target process using ptrace and watches it using direct wait (without signalfd) then report deps using normal socket report
+		// - child launches target process using ptrace (resp. seccomp) and watches it using direct wait (resp. seccomp notifications) then report deps using normal socket report
 		Pipe pipe{New,true/*no_std*/} ;
 		child_fd  = pipe.read  ;
 		report_fd = pipe.write ;
@@ -194,20 +218,7 @@ Fd Gather::_spawn_child() {
 		if (method==AutodepMethod::Fuse) {                                                       // PER_AUTODEP_METHOD : handle case
 			Fuse::Mount::s_autodep_env(autodep_env) ;
 		} else if (method>=AutodepMethod::Ld) {                                                  // PER_AUTODEP_METHOD : handle case
-			::string env_var ;
-			switch (method) {                                                                    // PER_AUTODEP_METHOD : handle case
-				#if HAS_32
-					#define DOLLAR_LIB "$LIB"                                                    // 32 bits is supported, use ld.so automatic detection feature
-				#else
-					#define DOLLAR_LIB "lib"                                                     // 32 bits is not supported, use standard name
-				#endif
-				case AutodepMethod::LdAudit           : env_var = "LD_AUDIT"   ; _add_env[env_var] = *g_lmake_dir_s + "_d" DOLLAR_LIB "/ld_audit.so"            ; break ;
-				case AutodepMethod::LdPreload         : env_var = "LD_PRELOAD" ; _add_env[env_var] = *g_lmake_dir_s + "_d" DOLLAR_LIB "/ld_preload.so"          ; break ;
-				case AutodepMethod::LdPreloadJemalloc : env_var = "LD_PRELOAD" ; _add_env[env_var] = *g_lmake_dir_s + "_d" DOLLAR_LIB "/ld_preload_jemalloc.so" ; break ;
-				#undef DOLLAR_LIB
-			DF}
-			if (env) { if (env->contains(env_var)) _add_env[env_var] += ':' + env->at(env_var) ; }
-			else     { if (has_env      (env_var)) _add_env[env_var] += ':' + get_env(env_var) ; }
+			_add_env.insert(s_autodep_lib_env(method,env)) ;
 		}
 		new_exec( New , mk_glb(cmd_line[0],cwd_s) ) ;
 		SWEAR(is_blocked_sig(SIGCHLD)) ;
@@ -218,7 +229,7 @@ Fd Gather::_spawn_child() {
 	_child.env      = env       ;
 	_child.add_env  = &_add_env ;
 	_child.cwd_s    = cwd_s     ;
-	if (method==AutodepMethod::Ptrace) {
+	if (traced) {
 		::latch ready{1} ;
 		_ptrace_thread = ::jthread( _s_do_child , this , report_fd , &ready ) ;                  // /!\ _child must be spawned from tracing thread
 		ready.wait() ;                                                                           // wait until _child.pid is available
@@ -231,6 +242,23 @@ Fd Gather::_spawn_child() {
 	trace("child_pid",_child.pid) ;
 	return child_fd ;
 }
+template<class T> static T* _mk_shm(::string& file/*out*/,::string const& pfx) {              // create and map a shared memory file with an unpredictable name, nullptr if not possible
+	Trace trace("_mk_shm",pfx) ;
+	uint64_t    rnd    = 0                                 ;
+	AutoCloseFd rnd_fd = ::open("/dev/urandom",O_RDONLY|O_CLOEXEC) ;                           // getrandom is not available in CentOS7
+	if ( !rnd_fd || ::read(rnd_fd,&rnd,sizeof(rnd))!=sizeof(rnd) ) { trace("no_random") ; return nullptr ; }
+	OStringStream fss ; fss << pfx << ::getpid() <<'_'<< ::hex<<rnd ; file = fss.str() ;
+	AutoCloseFd fd  = ::open( file.c_str() , O_CREAT|O_EXCL|O_NOFOLLOW|O_RDWR|O_CLOEXEC , 0600 ) ; // O_EXCL|O_NOFOLLOW : never open a file prepared by someone else
+	if (!fd) { trace("cannot_create",file) ; file.clear() ; return nullptr ; }
+	T* res = T::s_map(fd,true/*init*/) ;
+	if (!res) {
+		trace("failed",file) ;
+		unlnk(file,false/*dir_ok*/,true/*abs_ok*/) ;
+		file.clear() ;
+	}
+	return res ;
+}
+
 Status Gather::exec_child() {
 	Trace trace("exec_child",STR(as_session),method,autodep_env,cmd_line) ;
 	if (env) trace("env",*env) ;
@@ -239,6 +267,16 @@ Status Gather::exec_child() {
 	if (env) swear_prod( !env->contains("LMAKE_AUTODEP_ENV") , "cannot run lmake under lmake" ) ;
 	else     swear_prod( !has_env      ("LMAKE_AUTODEP_ENV") , "cannot run lmake under lmake" ) ;
 	autodep_env.service = job_master_fd.service(addr) ;
+	if ( method>=AutodepMethod::Ld ) {                                                           // PER_AUTODEP_METHOD : shared memory is only accessed from within job processes
+		if (report_ring) {
+			_ring = _mk_shm<ReportRing>( _ring_file , "/dev/shm/lmake_report_" ) ;
+			if (_ring) autodep_env.ring = _ring_file ;                                          // else fall back to socket reports
+		}
+		if (job_access_cache) {
+			AccessCache* ac = _mk_shm<AccessCache>( _cache_file , "/dev/shm/lmake_access_cache_" ) ;
+			if (ac) { AccessCache::s_unmap(ac) ; autodep_env.access_cache = _cache_file ; }         // cache is only accessed from job processes, else fall back to per-process caches
+		}
+	}
 	trace("autodep_env",::string(autodep_env)) ;
 	//
 	AutoCloseFd                                          child_fd           ;
@@ -254,6 +292,13 @@ Status Gather::exec_child() {
 		if ( status==Status::New || status==Status::Ok ) status = status_ ;                      // else there is already another reason
 		if ( +msg_                                     ) msg << set_nl << msg_ ;
 	} ;
+	auto drain_ring = [&](bool at_end=false)->void {
+		if (!_ring) return ;
+		_ring->drain( [&]( PD pd , AccessDigest const& ad , ::string&& file , FileInfo const& fi , ::string&& comment )->void {
+			n_access_reports++ ;
+			_new_access( pd , ::move(file) , ad , fi , comment ) ;
+		} , at_end ) ;
+	} ;
 	auto kill = [&](bool next_step=false)->void {
 		trace("kill",STR(next_step),_kill_step,STR(as_session),_child.pid,_wait) ;
 		if      (next_step             ) SWEAR(_kill_step<=kill_sigs.size()) ;
@@ -311,6 +356,7 @@ Status Gather::exec_child() {
 			wait_for = event_date<Pdate::Future ? event_date-now : Delay::Forever ;
 		}
 		::vector<Epoll::Event> events = epoll.wait(wait_for) ;
+		drain_ring() ;                      // ring reports precede socket reports that are seen now, this ensures proper ordering, in particular before ChkDeps
 		if (!events) {
 			if (+delayed_check_deps) {      // process delayed check deps after all other events
 				trace("delayed_chk_deps") ;
@@ -357,7 +403,7 @@ Status Gather::exec_child() {
 									size_t len = old_sz + pos - live_out_pos ;
 									trace("live_out",live_out_pos,len) ;
 									//vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
-									OMsgBuf().send( ClientSockFd(service_mngt) , JobMngtRpcReq( JobMngtProc::LiveOut , seq_id , job , stdout.substr(live_out_pos,len) ) ) ;
+									OMsgBuf().send( JobRelay::connect(relay_sock_name,JobRelayProc::Mngt,service_mngt) , JobMngtRpcReq( JobMngtProc::LiveOut , seq_id , job , stdout.substr(live_out_pos,len) ) ) ;
 									//^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
 									live_out_pos = old_sz+pos ;
 								}
@@ -494,6 +540,16 @@ Return :
 	_child.waited() ;
 	trace("done",status) ;
 	SWEAR(status!=Status::New) ;
+	if (_ring) {
+		drain_ring(true/*at_end*/) ;                                                                                                // slots not marked ready at this point were abandoned by killed processes
+		ReportRing::s_unmap(_ring) ;
+		unlnk(_ring_file,false/*dir_ok*/,true/*abs_ok*/) ;
+		_ring = nullptr ;
+	}
+	if (+_cache_file) {
+		unlnk(_cache_file,false/*dir_ok*/,true/*abs_ok*/) ;
+		_cache_file.clear() ;
+	}
 	reorder(true/*at_end*/) ;                                                                                                       // ensure server sees a coherent view
 	return status ;
 }
@@ -20,7 +20,9 @@
 #include "rpc_job.hh"
 #include "rpc_job_exec.hh"
 
+#include "access_cache.hh"
 #include "env.hh"
+#include "report_ring.hh"
 
 // When several sockets are opened to send depend & target data, we are not sure of the order between these reports because of system buffers.
 // We could have decided to synchronize each report, which may be expensive in performance.
@@ -86,6 +88,7 @@ struct Gather {
 		AccessDigest digest          ;
 	} ;
 	// statics
+	static ::pair_ss s_autodep_lib_env( AutodepMethod , ::map_ss const* env ) ;                    // env variable to set (with its value) for the autodep lib to be loaded, method must be Ld
 private :
 	static void _s_do_child( void* self , Fd report_fd , ::latch* ready ) { reinterpret_cast<Gather*>(self)->_do_child(report_fd,ready) ; }
 	// services
@@ -95,6 +98,7 @@ private :
 	void _new_access(      PD pd , ::string&& f    , AccessDigest ad , DI const& di , ::string const& c       ) { _new_access({},pd,::move(f),ad,di,c) ; }
 	//
 	void _new_accesses( Fd fd , Jerr&& jerr ) {
+		n_access_reports += jerr.files.size() ;
 		for( auto& [f,dd] : jerr.files ) _new_access( fd , jerr.date , ::move(f) , jerr.digest , dd , jerr.txt ) ;
 	}
 	void _new_guards( Fd fd , Jerr&& jerr ) {                                                                   // fd for trace purpose only
@@ -140,12 +144,16 @@ public :
 	pid_t                             first_pid        = 0                                          ;
 	uset_s                            guards           ;                                              // dir creation/deletion that must be guarded against NFS
 	JobIdx                            job              = 0                                          ;
+	bool                              job_access_cache = false                                      ; // if true <=> processes share a job-wide cache of reported read accesses (Ld methods only)
 	::vector<uint8_t>                 kill_sigs        ;                                              // signals used to kill job
 	bool                              live_out         = false                                      ;
 	AutodepMethod                     method           = AutodepMethod::Dflt                        ;
 	::string                          msg              ;                                              // contains error messages not from job
+	size_t                            n_access_reports = 0                                          ; // number of accesses reported by job processes, for statistics only
 	Time::Delay                       network_delay    = Time::Delay(1)                             ; // 1s is reasonable when nothing is said
 	pid_t                             pid              = -1                                         ; // pid to kill
+	::string                          relay_sock_name  ;                                              // if not empty, connect to server through the relay listening to this socket
+	bool                              report_ring      = false                                      ; // if true <=> read accesses may be reported through shared memory (Ld methods only)
 	bool                              seen_tmp         = false                                      ;
 	SeqId                             seq_id           = 0                                          ;
 	ServerSockFd                      server_master_fd ;
@@ -158,8 +166,11 @@ public :
 private :
 	::map_ss            _add_env       ;
 	Child               _child         ;
-	::jthread           _ptrace_thread ;
+	::jthread           _ptrace_thread ;                                                              // tracing thread, used with ptrace and seccomp
 	::umap<Fd,::string> _codec_files   ;
+	ReportRing*         _ring          = nullptr    ;                                                 // shared memory ring in which job processes report read accesses, if any
+	::string            _ring_file     ;
+	::string            _cache_file    ;                                                              // shared memory file containing the job-wide AccessCache, if any
 	PD                  _end_timeout   = PD::Future ;
 	PD                  _end_child     = PD::Future ;
 	PD                  _end_kill      = PD::Future ;
@@ -21,16 +21,20 @@ using namespace Time ;
 // Record
 //
 
-bool                                                   Record::s_static_report = false        ;
-::vmap_s<DepDigest>                                  * Record::s_deps          = nullptr      ;
-::string                                             * Record::s_deps_err      = nullptr      ;
-::umap_s<pair<Accesses/*accessed*/,Accesses/*seen*/>>* Record::s_access_cache  = nullptr      ; // map file to read accesses
-AutodepEnv*                                            Record::_s_autodep_env  = nullptr      ; // declare as pointer to avoid late initialization
-Fd                                                     Record::_s_root_fd      ;
-pid_t                                                  Record::_s_root_pid     = 0            ;
-Fd                                                     Record::_s_report_fd    ;
-pid_t                                                  Record::_s_report_pid   = 0            ;
-uint64_t                                               Record::_s_id           = 0/*garbage*/ ;
+bool                                                   Record::s_static_report           = false        ;
+::vmap_s<DepDigest>                                  * Record::s_deps                    = nullptr      ;
+::string                                             * Record::s_deps_err                = nullptr      ;
+::umap_s<pair<Accesses/*accessed*/,Accesses/*seen*/>>* Record::s_access_cache            = nullptr      ; // map file to read accesses
+AutodepEnv*                                            Record::_s_autodep_env            = nullptr      ; // declare as pointer to avoid late initialization
+Fd                                                     Record::_s_root_fd                               ;
+pid_t                                                  Record::_s_root_pid               = 0            ;
+ReportRing*                                            Record::_s_report_ring            = nullptr      ;
+bool                                                   Record::_s_report_ring_tried      = false        ;
+AccessCache*                                           Record::_s_job_access_cache       = nullptr      ;
+bool                                                   Record::_s_job_access_cache_tried = false        ;
+Fd                                                     Record::_s_report_fd                             ;
+pid_t                                                  Record::_s_report_pid             = 0            ;
+uint64_t                                               Record::_s_id                     = 0/*garbage*/ ;
 
 bool Record::s_is_simple(const char* file) {
 	if (!file        ) return true  ;                                     // no file is simple (not documented, but used in practice)
@@ -96,9 +100,23 @@ bool/*sent*/ Record::report_async_access( JobExecRpcReq&& jerr , bool force ) co
 	SWEAR( jerr.proc==Proc::Access || jerr.proc==Proc::DepVerbose , jerr.proc ) ;
 	if ( !force && !enable ) return false/*sent*/ ;                                        // dont update cache as report is not actually done
 	if (!jerr.sync) {
-		bool miss = false ;
+		bool         miss      = false                ;
+		AccessCache* job_cache = s_job_access_cache() ;
 		for( auto const& [f,dd] : jerr.files ) {
 			SWEAR( +f , jerr.files , jerr.txt ) ;
+			if ( AccessCache::Bucket* b = job_cache ? job_cache->bucket(f) : nullptr ) {           // job-wide cache takes precedence, per-process cache is a fallback
+				AccessCache::Val a = +jerr.digest.accesses ;
+				if (jerr.digest.write==No) {
+					AccessCache::Val old_accessed =         b->accessed.fetch_or(a)      ;         // atomic or's ensure exactly one process sees a given access as new
+					AccessCache::Val old_seen     = +dd ? b->seen    .fetch_or(a) : 0 ;
+					if (!( a & ~(+dd?old_seen:old_accessed) )) continue ;                          // no new (seen) accesses
+				} else {
+					b->accessed = +~Accesses() ;                                                   // from now on, read accesses need not be reported as file has been written
+					b->seen     = +~Accesses() ;                                                   // .
+				}
+				miss = true ;
+				continue ;
+			}
 			auto                                           [it,inserted] = s_access_cache->emplace(f,pair(Accesses(),Accesses())) ;
 			::pair<Accesses/*accessed*/,Accesses/*seen*/>& entry         = it->second                                             ;
 			if (jerr.digest.write==No) {
@@ -114,6 +132,17 @@ bool/*sent*/ Record::report_async_access( JobExecRpcReq&& jerr , bool force ) co
 			miss = true ;
 		}
 		if (!miss) return false/*sent*/ ;                                                  // modifying accesses cannot be cached as we do not know what other processes may have done in between
+		// async reads need no reply nor confirmation, they can go through the shared memory ring, if any
+		if ( jerr.proc==Proc::Access && jerr.digest.write==No && !s_static_report )
+			if ( ReportRing* ring=s_report_ring() ) {
+				size_t n_pushed = 0 ;
+				for( auto const& [f,fi] : jerr.files ) {
+					if (!ring->push(jerr.date,jerr.digest,f,fi,jerr.txt)) break ;              // ring is full or entry is too large, report remaining files through socket
+					n_pushed++ ;
+				}
+				if (n_pushed==jerr.files.size()) return true/*sent*/ ;
+				jerr.files.erase( jerr.files.begin() , jerr.files.begin()+n_pushed ) ;
+			}
 	}
 	return report_direct(::move(jerr)) ;
 }
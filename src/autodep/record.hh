@@ -6,7 +6,9 @@
 #pragma once
 
 #include "disk.hh"
+#include "access_cache.hh"
 #include "gather.hh"
+#include "report_ring.hh"
 #include "rpc_job_exec.hh"
 #include "time.hh"
 
@@ -50,6 +52,20 @@ struct Record {
 		}
 		return _s_report_fd ;
 	}
+	static ReportRing* s_report_ring() {                                                                                          // nullptr if no ring is available
+		if (!_s_report_ring_tried) {
+			_s_report_ring_tried = true                                        ;                                                  // dont retry if ring cannot be mapped
+			_s_report_ring       = _s_map_shm<ReportRing>(_s_autodep_env->ring) ;                                                 // mapping is inherited by forked children
+		}
+		return _s_report_ring ;
+	}
+	static AccessCache* s_job_access_cache() {                                                                                    // nullptr if no job-wide cache is available
+		if (!_s_job_access_cache_tried) {
+			_s_job_access_cache_tried = true                                                 ;                                    // dont retry if cache cannot be mapped
+			_s_job_access_cache       = _s_map_shm<AccessCache>(_s_autodep_env->access_cache) ;                                   // mapping is inherited by forked children
+		}
+		return _s_job_access_cache ;
+	}
 	static void s_close_report() {
 		_s_report_fd.close() ;
 	}
@@ -62,6 +78,16 @@ struct Record {
 		_s_mk_autodep_env(new AutodepEnv{ade}) ;
 		return *_s_autodep_env ;
 	}
+	static void s_reset_autodep_env(AutodepEnv const& ade) {                                                                     // forget all about previous job when process is reused for another one (e.g. zygote child)
+		AutodepEnv* e = _s_autodep_env ? _s_autodep_env : new AutodepEnv ;                                                        // reuse existing object as RealPath's refer to it
+		*e = ade ;
+		delete s_access_cache ;
+		_s_mk_autodep_env(e) ;
+		::close(_s_root_fd  .detach().fd) ;                                                                                       // fd may not be valid in this process, ignore errors
+		::close(_s_report_fd.detach().fd) ;                                                                                       // .
+		_s_report_ring_tried      = false ;                                                                                       // previous mappings, if any, are left as is
+		_s_job_access_cache_tried = false ;                                                                                       // .
+	}
 	static AutodepEnv const& s_autodep_env(NewType) {
 		SWEAR( !s_access_cache == !_s_autodep_env ) ;
 		if (!_s_autodep_env) _s_mk_autodep_env(new AutodepEnv{New}) ;
@@ -76,6 +102,14 @@ struct Record {
 		if ( _s_report_fd.fd>=0 &&  uint(_s_report_fd.fd)>=min && uint(_s_report_fd.fd)<=max ) _s_report_fd.detach() ;
 	}
 	// private
+	template<class T> static T* _s_map_shm(::string const& file) {                                                                // map a shared memory file created by Gather, nullptr if not possible
+		if (!file) return nullptr ;
+		AutoCloseFd fd = ::open( file.c_str() , O_RDWR|O_NOFOLLOW|O_CLOEXEC ) ;
+		if (!fd) return nullptr ;
+		struct ::stat st ;
+		if ( ::fstat(fd,&st)!=0 || st.st_uid!=::getuid() || (st.st_mode&(S_IRWXG|S_IRWXO)) ) return nullptr ;                   // only trust a file created by Gather
+		return T::s_map(fd,false/*init*/) ;
+	}
 	static void _s_mk_autodep_env(AutodepEnv* ade) {
 		_s_autodep_env = ade                                                       ;
 		s_access_cache = new ::umap_s<pair<Accesses/*accessed*/,Accesses/*seen*/>> ;
@@ -92,13 +126,17 @@ public :
 	static ::string                                             * s_deps_err       ;
 	static ::umap_s<pair<Accesses/*accessed*/,Accesses/*seen*/>>* s_access_cache   ; // map file to read accesses
 private :
-	static AutodepEnv* _s_autodep_env ;
-	static Fd          _s_root_fd     ;                                              // a file descriptor to repo root dir
-	static pid_t       _s_root_pid    ;                                              // pid in which _s_root_fd is valid
+	static AutodepEnv*  _s_autodep_env            ;
+	static Fd           _s_root_fd                ;                                  // a file descriptor to repo root dir
+	static pid_t        _s_root_pid               ;                                  // pid in which _s_root_fd is valid
+	static ReportRing*  _s_report_ring            ;                                  // shared memory ring to report read accesses, if any
+	static bool         _s_report_ring_tried      ;                                  // if true <=> _s_report_ring has been computed
+	static AccessCache* _s_job_access_cache       ;                                  // read accesses already reported by any process of the job, if any
+	static bool         _s_job_access_cache_tried ;                                  // if true <=> _s_job_access_cache has been computed
 public:
-	static Fd          _s_report_fd   ;
-	static pid_t       _s_report_pid  ;                                              // pid in which _s_report_fd is valid
-	static uint64_t    _s_id          ;                                              // used by Confirm to refer to confirmed Access, 0 means nothing to confirm
+	static Fd           _s_report_fd              ;
+	static pid_t        _s_report_pid             ;                                  // pid in which _s_report_fd is valid
+	static uint64_t     _s_id                     ;                                  // used by Confirm to refer to confirmed Access, 0 means nothing to confirm
 	// cxtors & casts
 public :
 	Record(                                            ) = default ;
@@ -176,7 +214,7 @@ private :
 		report_direct({Proc::Tmp,sync,::move(c)}) ;
 	}
 	void _report_confirm( uint64_t id , bool ok ) const {
-		if (id) report_direct({ Proc::Confirm , id , ok }) ;
+		if ( id && confirm ) report_direct({ Proc::Confirm , id , ok }) ;
 	}
 public :
 	bool/*sent*/ report_direct( JobExecRpcReq&& jerr , bool force=false ) const {
@@ -456,6 +494,7 @@ public :
 	// data
 	bool seen_chdir = false ;
 	bool enable     = false ;
+	bool confirm    = true  ;                     // if false, syscall outcome is unknown and modifying accesses are left unconfirmed
 private :
 	Disk::RealPath _real_path ;
 	mutable bool   _tmp_cache = false ;           // record that tmp usage has been reported, no need to report any further
@@ -0,0 +1,106 @@
+// This file is part of the open-lmake distribution (git@github.com:cesar-douady/open-lmake.git)
+// Copyright (c) 2023 Doliam
+// This program is free software: you can redistribute/modify under the terms of the GPL-v3 (https://www.gnu.org/licenses/gpl-3.0.html).
+// This program is distributed WITHOUT ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+#pragma once
+
+#include <sys/mman.h> // mmap, munmap
+
+#include <new>        // placement new
+
+#include "disk.hh"
+#include "time.hh"
+
+#include "rpc_job_exec.hh"
+
+// ReportRing is a shared memory ring of fixed size slots used to report read accesses without a syscall nor serialization :
+// - it is created by Gather (consumer) in a file mapped by all processes of the job (producers), typically in /dev/shm
+// - producers reserve a position by incrementing write_pos, claim its slot, fill it, then publish it by storing its ready sequence number
+// - consumer handles published slots as it sees them, and frees them by incrementing read_pos over the handled prefix
+// - a slot is never reused before it has been published and handled, so a slow producer never blocks consumer but may fill up the ring
+// - if ring is full or if a report does not fit in a slot, producers must fall back to the socket report
+// - only async read accesses are reported this way, as others need a reply (sync) or an id known on the socket they are sent to (Confirm)
+// each slot carries a sequence word holding the position it is used for and its state (free, busy or ready) :
+// - a slot handled by consumer is immediately marked free for the next round, but cannot be reserved before read_pos has gone past it
+// - a producer publishes its reports before sending anything on its socket, so its ring reports are seen by consumer before its socket reports
+// - at end of job, slots that are still unpublished were abandoned (e.g. producer was killed), a late producer sees its publication fail
+struct ReportRing {
+	using Pdate = Time::Pdate    ;
+	using FI    = Disk::FileInfo ;
+	static constexpr size_t NSlots = 8192 ;                                                          // 4MB in total
+	static constexpr size_t SlotSz = 512  ;
+	enum class SlotState : uint8_t { Free , Busy , Ready } ;
+	static constexpr uint64_t _s_seq( uint64_t pos , SlotState st ) { return pos<<2 | uint64_t(st) ; }
+	struct Slot {
+		char* data() { return reinterpret_cast<char*>(this+1) ; }                                    // file followed by comment
+		// data
+		::atomic<uint64_t> seq        = 0 ;                                                          // _s_seq(pos,state) for the position the slot is used for
+		uint16_t           file_sz    = 0 ;
+		uint16_t           comment_sz = 0 ;
+		Pdate              date       ;
+		AccessDigest       digest     ;
+		FI                 file_info  ;
+	} ;
+	static_assert(::is_trivially_copyable_v<AccessDigest>) ;                                        // as they are copied by producer and consumer in different processes
+	static_assert(::is_trivially_copyable_v<FI          >) ;                                        // .
+	static constexpr size_t MaxDataSz = SlotSz - sizeof(Slot) ;
+	// statics
+	static size_t s_sz() { return sizeof(ReportRing) + NSlots*SlotSz ; }
+	static ReportRing* s_map( Fd fd , bool init ) {                                                  // return nullptr if mapping is not possible
+		if ( init && ::ftruncate(fd,s_sz())!=0 ) return nullptr ;
+		void* res = ::mmap( nullptr , s_sz() , PROT_READ|PROT_WRITE , MAP_SHARED , fd , 0 ) ;
+		if (res==MAP_FAILED) return nullptr ;
+		if (!init) return static_cast<ReportRing*>(res) ;
+		ReportRing* ring = new(res) ReportRing ;
+		for( uint64_t pos=0 ; pos<NSlots ; pos++ ) ring->_slot(pos).seq = _s_seq(pos,SlotState::Free) ;
+		return ring ;
+	}
+	static void s_unmap(ReportRing* ring) { ::munmap(ring,s_sz()) ; }
+	// accesses
+	Slot& _slot(uint64_t pos) { return *reinterpret_cast<Slot*>( reinterpret_cast<char*>(this+1) + (pos%NSlots)*SlotSz ) ; }
+	bool operator+() const { return read_pos!=write_pos ; }                                          // true if there are pending reports
+	// services
+	bool/*done*/ push( Pdate date , AccessDigest const& digest , ::string const& file , FI const& fi , ::string const& comment ) {
+		if ( file.size()+comment.size()>MaxDataSz ) return false ;
+		uint64_t pos = write_pos ;
+		do { if (pos-read_pos>=NSlots) return false ; } while (!write_pos.compare_exchange_weak(pos,pos+1)) ; // ring is full
+		Slot&    s   = _slot(pos)                      ;
+		uint64_t seq = _s_seq(pos,SlotState::Free) ;
+		if (!s.seq.compare_exchange_strong(seq,_s_seq(pos,SlotState::Busy))) return false ;               // slot has already been abandoned by consumer
+		s.file_sz    = file   .size() ;
+		s.comment_sz = comment.size() ;
+		s.date       = date           ;
+		s.digest     = digest         ;
+		s.file_info  = fi             ;
+		::memcpy( s.data()             , file   .data() , file   .size() ) ;
+		::memcpy( s.data()+file.size() , comment.data() , comment.size() ) ;
+		seq = _s_seq(pos,SlotState::Busy) ;
+		return s.seq.compare_exchange_strong( seq , _s_seq(pos,SlotState::Ready) , ::memory_order_release ) ; // publish, fails if slot has been abandoned by consumer while filling it
+	}
+	// call cb on each published report, never wait for a slot being filled, it will be handled by a later call
+	// if at_end, unpublished slots are abandoned
+	template<class Cb> void drain( Cb cb , bool at_end=false ) {
+		uint64_t end     = write_pos                             ;
+		uint64_t pos     = read_pos.load(::memory_order_relaxed) ;                                // consumer is the only one to write read_pos
+		bool     handled = true                                  ;                                // if true <=> all slots before pos are handled
+		for(; pos<end ; pos++ ) {
+			Slot&    s    = _slot(pos)                         ;
+			uint64_t seq  = s.seq.load(::memory_order_acquire) ;
+			uint64_t done = _s_seq(pos+NSlots,SlotState::Free) ;                                   // slot has been handled, it may be reused once read_pos is past it
+			if (seq==_s_seq(pos,SlotState::Ready)) {
+				cb( s.date , s.digest , ::string(s.data(),s.file_sz) , s.file_info , ::string(s.data()+s.file_sz,s.comment_sz) ) ;
+				s.seq.store( done , ::memory_order_relaxed ) ;
+			} else if (seq!=done) {
+				if      (!at_end                                   ) { handled = false ; continue ; } // not published yet, handle following slots and come back later
+				else if (!s.seq.compare_exchange_strong(seq,done)) { pos--           ; continue ; } // slot has been published in the mean time, retry
+			}
+			if (handled) read_pos.store( pos+1 , ::memory_order_release ) ;                         // free slot as soon as possible
+		}
+	}
+	// data
+	::atomic<uint64_t> write_pos = 0 ;                                                              // next position to be reserved by a producer
+	::atomic<uint64_t> read_pos  = 0 ;                                                              // next position to be consumed
+	char               _pad[64-2*sizeof(uint64_t)] ;                                                // keep slots cache aligned
+} ;
+static_assert( sizeof(ReportRing)%64==0 ) ;
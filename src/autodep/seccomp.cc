@@ -0,0 +1,243 @@
+// This file is part of the open-lmake distribution (git@github.com:cesar-douady/open-lmake.git)
+// Copyright (c) 2023 Doliam
+// This program is free software: you can redistribute/modify under the terms of the GPL-v3 (https://www.gnu.org/licenses/gpl-3.0.html).
+// This program is distributed WITHOUT ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+#include <poll.h>
+#include <syscall.h>        // SYS_* macros
+#include <sys/ioctl.h>
+#include <sys/prctl.h>
+#include <sys/socket.h>
+
+#include "disk.hh"
+#include "trace.hh"
+
+#include "record.hh"
+#include "syscall_tab.hh"
+
+#include "seccomp.hh"
+
+#if HAS_SECCOMP_NOTIF
+	#include <linux/audit.h>    // AUDIT_ARCH_*
+	#include <linux/filter.h>   // sock_filter, sock_fprog, BPF_*
+	#include <linux/seccomp.h>
+#endif
+
+using namespace Disk ;
+
+#if HAS_SECCOMP_NOTIF
+
+	#if defined(__x86_64__)
+		static constexpr uint32_t NativeArch = AUDIT_ARCH_X86_64  ;
+	#elif defined(__aarch64__)
+		static constexpr uint32_t NativeArch = AUDIT_ARCH_AARCH64 ;
+	#endif
+
+	static constexpr int64_t UnknownRes = -ENOSYS ; // syscall outcome as passed to exit procs as we do not see it, only the backdoor emulation may replace it
+
+	// all must be prepared before the child is cloned as s_prepare_child must be malloc free
+	static ::vector<struct sock_filter> _s_filter   ;
+	static struct sock_fprog            _s_prog     = {}          ;
+	static int                          _s_sock[2]  = { -1 , -1 } ; // child sends listener through _s_sock[1], supervisor receives it from _s_sock[0]
+	static int                          _s_listener = -1          ; // notification being handled, so that it can be checked after each read in tracee memory
+	static uint64_t                     _s_notif_id = 0           ; // .
+
+	static void _s_chk_notif() {
+		if (::ioctl(_s_listener,SECCOMP_IOCTL_NOTIF_ID_VALID,&_s_notif_id)!=0) throw int(ESRCH) ; // tracee died since notification was received and its pid may have been reused
+	}
+
+#endif
+
+void AutodepSeccomp::s_init(AutodepEnv const& ade) {
+	Record::s_autodep_env(ade) ;
+	#if HAS_SECCOMP_NOTIF
+		static SyscallDescr::Tab const& s_tab = SyscallDescr::s_tab ;
+		bool               ignore_stat = ade.ignore_stat && ade.lnk_support!=LnkSupport::Full ;      // if full link support, we need to analyze uphill dirs
+		::vector<uint32_t> syscalls ;
+		for( long syscall=0 ; syscall<SyscallDescr::NSyscalls ; syscall++ ) {
+			SyscallDescr const& descr = s_tab[syscall] ;
+			if ( !descr || !descr.entry       ) continue ;                                        // descr is not allocated
+			if ( descr.is_stat && ignore_stat ) continue ;                                        // non stat-like access are always needed
+			syscalls.push_back(syscall) ;
+		}
+		SWEAR( syscalls.size()<256 , syscalls.size() ) ;                                          // jumps are coded on 8 bits
+		// foreign arch syscalls are notified so that supervisor can report them as not supported
+		_s_filter = {
+			BPF_STMT( BPF_LD |BPF_W  |BPF_ABS , offsetof(struct seccomp_data,arch)     )
+		,	BPF_JUMP( BPF_JMP|BPF_JEQ|BPF_K   , NativeArch , 1/*jt*/ , 0/*jf*/         )
+		,	BPF_STMT( BPF_RET|BPF_K           , SECCOMP_RET_USER_NOTIF                 )
+		,	BPF_STMT( BPF_LD |BPF_W  |BPF_ABS , offsetof(struct seccomp_data,nr)       )
+		} ;
+		for( size_t i=0 ; i<syscalls.size() ; i++ )
+			_s_filter.push_back(BPF_JUMP( BPF_JMP|BPF_JEQ|BPF_K , syscalls[i] , uint8_t(syscalls.size()-i)/*jt : jump to notify*/ , 0/*jf*/ )) ;
+		_s_filter.push_back(BPF_STMT( BPF_RET|BPF_K , SECCOMP_RET_ALLOW      )) ;
+		_s_filter.push_back(BPF_STMT( BPF_RET|BPF_K , SECCOMP_RET_USER_NOTIF )) ;
+		_s_prog = { .len=static_cast<unsigned short>(_s_filter.size()) , .filter=_s_filter.data() } ;
+		SyscallDescr::s_chk_tracee = _s_chk_notif ;
+		//
+		swear_prod( ::socketpair( AF_UNIX , SOCK_SEQPACKET|SOCK_CLOEXEC , 0 , _s_sock )==0 , "cannot create socket pair to receive seccomp listener" ) ;
+		for( int& fd : _s_sock ) fd = Fd(fd,true/*no_std*/).fd ;                                 // child sets up its std fd's before calling s_prepare_child
+	#endif
+}
+
+void AutodepSeccomp::init(pid_t cp) {
+	child_pid = cp ;
+	#if HAS_SECCOMP_NOTIF
+		Trace trace("AutodepSeccomp::init",child_pid) ;
+		::close(_s_sock[1]) ;                                                                     // ensure we see eof if child does not send listener (e.g. it failed before)
+		char          dummy                                 ;
+		char          cmsg_buf[CMSG_SPACE(sizeof(int))]     ;
+		struct iovec  iov { .iov_base=&dummy , .iov_len=1 } ;
+		struct msghdr msg {}                                ;
+		msg.msg_iov        = &iov             ;
+		msg.msg_iovlen     = 1                ;
+		msg.msg_control    = cmsg_buf         ;
+		msg.msg_controllen = sizeof(cmsg_buf) ;
+		ssize_t cnt = ::recvmsg( _s_sock[0] , &msg , MSG_CMSG_CLOEXEC ) ;
+		::close(_s_sock[0]) ;
+		struct cmsghdr* cmsg = cnt==1 ? CMSG_FIRSTHDR(&msg) : nullptr ;
+		if ( cmsg && cmsg->cmsg_level==SOL_SOCKET && cmsg->cmsg_type==SCM_RIGHTS ) {
+			int fd ; ::memcpy( &fd , CMSG_DATA(cmsg) , sizeof(int) ) ;
+			_listener = fd ;
+		}
+		trace("listener",_listener) ;                                                             // if no listener, child_pid will be waited for in process
+	#endif
+}
+
+// /!\ this function must be malloc free as malloc takes a lock that may be held by another thread at the time process is cloned
+int/*rc*/ AutodepSeccomp::s_prepare_child(void*) {
+	#if HAS_SECCOMP_NOTIF
+		if (::prctl(PR_SET_NO_NEW_PRIVS,1,0,0,0)!=0) return -1 ;                                 // necessary to install a filter without CAP_SYS_ADMIN
+		int listener = ::syscall( SYS_seccomp , SECCOMP_SET_MODE_FILTER , SECCOMP_FILTER_FLAG_NEW_LISTENER , &_s_prog ) ;
+		if (listener<0) return -1 ;
+		// pass listener to supervisor, sendmsg is not watched, so we cannot block here
+		char          dummy                             = 0  ;
+		char          cmsg_buf[CMSG_SPACE(sizeof(int))] = {} ;
+		struct iovec  iov { .iov_base=&dummy , .iov_len=1 }  ;
+		struct msghdr msg {}                                 ;
+		msg.msg_iov        = &iov             ;
+		msg.msg_iovlen     = 1                ;
+		msg.msg_control    = cmsg_buf         ;
+		msg.msg_controllen = sizeof(cmsg_buf) ;
+		struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg) ;
+		cmsg->cmsg_level = SOL_SOCKET            ;
+		cmsg->cmsg_type  = SCM_RIGHTS            ;
+		cmsg->cmsg_len   = CMSG_LEN(sizeof(int)) ;
+		::memcpy( CMSG_DATA(cmsg) , &listener , sizeof(int) ) ;
+		if (::sendmsg(_s_sock[1],&msg,0)!=1) return -1 ;
+		::close(listener) ;                                                                       // supervisor has its own copy
+		::close(_s_sock[1]) ;                                                                     // would be closed by exec anyway, but dont leak it to children of pre_exec
+	#endif
+	return 0 ;
+}
+
+int/*wstatus*/ AutodepSeccomp::process() {
+	Trace trace("AutodepSeccomp::process",child_pid,_listener) ;
+	#if HAS_SECCOMP_NOTIF
+		AutoCloseFd   pid_fd = ::syscall( SYS_pidfd_open , child_pid , 0 )                    ; // readable when child_pid terminates
+		struct pollfd fds[2] = { { pid_fd , POLLIN , 0 } , { _listener , POLLIN , 0 } } ;
+		nfds_t        n_fds  = +_listener ? 2 : 1                                        ;
+		while ( +pid_fd && n_fds>1 ) {                                                           // if no listener, just wait for child
+			if (::poll(fds,n_fds,-1/*timeout*/)<0) {
+				SWEAR(errno==EINTR,errno) ;
+				continue ;
+			}
+			if      (fds[1].revents& POLLIN          ) _handle()  ;
+			else if (fds[1].revents&(POLLHUP|POLLERR)) n_fds = 1 ;                                // no more filtered processes
+			if (fds[0].revents&POLLIN) break ;                                                    // child_pid is done, other processes are not waited for, as with ptrace
+		}
+		if (n_fds>1) _drain() ;                                                                   // some descendants may still carry the filter
+	#endif
+	int   wstatus                                 ;
+	pid_t pid     = ::waitpid(child_pid,&wstatus,0) ;
+	swear_prod(pid==child_pid,"cannot wait for pid",child_pid) ;
+	trace("done",wstatus) ;
+	return wstatus ;
+}
+
+#if HAS_SECCOMP_NOTIF
+	// descendants of child_pid (e.g. daemons) may outlive it and their watched syscalls would fail with ENOSYS if listener were closed
+	// so hand listener over to a detached process that lets their syscalls through until no filtered process is left
+	// accesses are not recorded as job is over, as with ptrace where such processes are not waited for
+	void AutodepSeccomp::_drain() {
+		Trace trace("AutodepSeccomp::_drain",_listener) ;
+		pid_t pid = ::fork() ;
+		if (pid<0) { trace("cannot_fork",::strerror(errno)) ; return ; }
+		if (pid>0) {                                                                              // listener is closed when we are destroyed
+			int wstatus ; ::waitpid(pid,&wstatus,0) ;                                             // intermediate process exits immediately
+			return ;
+		}
+		// /!\ we are in a fork of a multi-threaded process, stay async-signal-safe from here
+		if (::fork()!=0) ::_exit(0) ;                                                             // detach drain so that it is not our child
+		int  listener = _listener.fd ;
+		bool closed   = false        ;                                                            // dont keep job_exec connections alive
+		#ifdef SYS_close_range
+			closed = ::syscall(SYS_close_range,0,listener-1,0)==0 && ::syscall(SYS_close_range,listener+1,~0u,0)==0 ;
+		#endif
+		if (!closed) for( int fd=0 ; fd<1024 ; fd++ ) if (fd!=listener) ::close(fd) ;             // close_range may not be supported
+		struct pollfd fds[1] = { { listener , POLLIN , 0 } } ;
+		for(;;) {
+			if (::poll(fds,1,-1/*timeout*/)<0) {
+				if (errno==EINTR) continue ;
+				break ;
+			}
+			if (!(fds[0].revents&POLLIN)) break ;                                                 // POLLHUP : no more filtered processes
+			struct seccomp_notif      req  ; ::memset( &req  , 0 , sizeof(req ) ) ;
+			struct seccomp_notif_resp resp ; ::memset( &resp , 0 , sizeof(resp) ) ;
+			if (::ioctl(listener,SECCOMP_IOCTL_NOTIF_RECV,&req)!=0) continue ;
+			resp.id    = req.id                           ;
+			resp.flags = SECCOMP_USER_NOTIF_FLAG_CONTINUE ;
+			::ioctl(listener,SECCOMP_IOCTL_NOTIF_SEND,&resp) ;                                    // ignore errors : tracee may have died in between
+		}
+		::_exit(0) ;
+	}
+
+	void AutodepSeccomp::_handle() {
+		static SyscallDescr::Tab const& tab = SyscallDescr::s_tab ;
+		struct seccomp_notif      req  ; ::memset( &req  , 0 , sizeof(req ) ) ;                  // kernel requires a zeroed struct
+		struct seccomp_notif_resp resp ; ::memset( &resp , 0 , sizeof(resp) ) ;
+		if (::ioctl(_listener,SECCOMP_IOCTL_NOTIF_RECV,&req)!=0) return ;                        // tracee died or syscall was interrupted in between
+		resp.id    = req.id                           ;
+		resp.flags = SECCOMP_USER_NOTIF_FLAG_CONTINUE ;
+		pid_t pid = req.pid ;
+		if (req.data.arch!=NativeArch) {
+			// XXX : support 32 bits exe's (beware of 32 bits syscall numbers)
+			if (!_arch_reported) {
+				Trace trace("AutodepSeccomp::_handle","panic","arch",req.data.arch) ;
+				Record(New,pid).report_direct({ JobExecProc::Panic , "32 bits processes on "s+NpWordSz+" host not supported yet with seccomp" }) ;
+				_arch_reported = true ;
+			}
+		} else if ( req.data.nr>=0 && req.data.nr<SyscallDescr::NSyscalls ) {
+			SyscallDescr const& descr = tab[req.data.nr] ;
+			SWEAR( +descr && descr.entry , "should not be awaken for nothing" , req.data.nr ) ;
+			_s_listener = _listener ;
+			_s_notif_id = req.id    ;
+			try {
+				Record r { New , pid } ;                                                          // reads cwd from /proc, so chdir need not be followed
+				r.confirm = false ;                                                               // outcome is not seen, leave writes unconfirmed
+				auto it = _enables.find(pid) ; if (it!=_enables.end()) r.enable = it->second ;
+				// ensure seccomp args is actually an array of uint64_t
+				static_assert( sizeof(req.data.args[0])==sizeof(uint64_t) && ::is_unsigned_v<remove_reference_t<decltype(req.data.args[0])>> ) ;
+				uint64_t* args = reinterpret_cast<uint64_t*>(req.data.args) ;
+				void*     ctx  = nullptr                                    ;
+				descr.entry( ctx , r , pid , args , descr.comment ) ;
+				if (ctx) {
+					SWEAR(descr.exit,req.data.nr) ;
+					int64_t res = descr.exit( ctx , r , pid , UnknownRes ) ;                      // free ctx, only backdoor emulation knows the result
+					if (res!=UnknownRes) {                                                        // syscall was emulated, dont execute it
+						resp.flags = 0                    ;
+						resp.val   = res<0 ? 0        : res ;
+						resp.error = res<0 ? int(res) : 0   ;
+					}
+				}
+				if (r.enable==Record::s_autodep_env().enable) _enables.erase(pid)       ;
+				else                                          _enables[pid] = r.enable ;
+			} catch (int e) {
+				if (e!=ESRCH) Trace("AutodepSeccomp::_handle","cannot_analyze",pid,req.data.nr,::strerror(e)) ;   // ESRCH : tracee died while we analyze its syscall, proceed as if nothing happened
+			} catch (::string const& e) {
+				Trace("AutodepSeccomp::_handle","cannot_analyze",pid,req.data.nr,e) ;
+			}
+		}
+		::ioctl(_listener,SECCOMP_IOCTL_NOTIF_SEND,&resp) ;                                       // ignore errors : tracee may have died in between
+	}
+#endif
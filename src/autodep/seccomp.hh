@@ -0,0 +1,38 @@
+// This file is part of the open-lmake distribution (git@github.com:cesar-douady/open-lmake.git)
+// Copyright (c) 2023 Doliam
+// This program is free software: you can redistribute/modify under the terms of the GPL-v3 (https://www.gnu.org/licenses/gpl-3.0.html).
+// This program is distributed WITHOUT ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+#pragma once
+
+#include "gather.hh"
+#include "record.hh"
+
+// AutodepSeccomp watches the syscalls of SyscallDescr::s_tab through seccomp user notifications :
+// - child installs a filter that notifies watched syscalls to a listener fd, which it passes to the supervisor (the tracing thread of Gather)
+// - supervisor reads syscall args from tracee memory, records accesses and lets the kernel resume the syscall (SECCOMP_USER_NOTIF_FLAG_CONTINUE)
+// - syscall outcome is not seen, so writes are left unconfirmed and job_exec resolves them from disk, except the backdoor which is emulated
+// - processes still filtered when child_pid terminates are served by a detached drain process that lets their syscalls through
+// notifications are handled by a single thread, as with ptrace : handling one is short compared to a context switch, and Record is not thread-safe
+struct AutodepSeccomp {
+	// init
+	static void s_init(AutodepEnv const&) ;
+	// statics
+	static int/*rc*/ s_prepare_child(void*) ; // must be called from child
+	// cxtors & casts
+	AutodepSeccomp(        ) = default ;
+	AutodepSeccomp(pid_t cp) { init(cp) ; }
+	void init(pid_t child_pid) ;
+	// services
+private :
+	void _handle() ;                          // handle one notification
+	void _drain () ;                          // let syscalls of processes outliving child_pid through
+public :
+	int/*wstatus*/ process() ;
+	// data
+	pid_t child_pid = 0 ;
+private :
+	AutoCloseFd        _listener      ;         // seccomp notification fd, received from child
+	::umap<pid_t,bool> _enables       ;         // processes that changed their enable state through the backdoor, as a new Record is built for each notification
+	bool               _arch_reported = false ;
+} ;
@@ -5,15 +5,21 @@
 
 #include <syscall.h>   // for SYS_* macros
 #include <sys/mount.h>
+#include <sys/uio.h>   // process_vm_readv, process_vm_writev
 
 #include "ptrace.hh"
 #include "record.hh"
 
 #include "syscall_tab.hh"
 
+// process_vm_readv/writev need a single syscall per chunk instead of one per word with ptrace and work whether tracee is ptrace'd (ptrace) or not (seccomp)
+// ptrace is used as a fall back if they are not available (e.g. forbidden by a container seccomp policy)
+static constexpr size_t VmChunkSz = 4096 ;                                                   // a chunk aligned on this size never crosses a page boundary, hence is either fully accessible or not at all
+
+[[maybe_unused]] static bool _vm_unavailable() { return errno==ENOSYS || errno==EPERM ; }
+
 // return null terminated string pointed by src in process pid's space
-[[maybe_unused]] static ::string _get_str( pid_t pid , uint64_t src ) {
-	if (!pid) return {reinterpret_cast<const char*>(src)} ;
+[[maybe_unused]] static ::string _ptrace_get_str( pid_t pid , uint64_t src ) {
 	::string res ;
 	errno = 0 ;
 	for(;;) {
@@ -26,10 +32,40 @@
 		src += sizeof(long)-offset ;
 	}
 }
+[[maybe_unused]] static ::string _get_str( pid_t pid , uint64_t src ) {
+	if (!pid) return {reinterpret_cast<const char*>(src)} ;
+	::string res ;
+	for(;;) {
+		char         buf[VmChunkSz]                                                     ;
+		size_t       chunk  = VmChunkSz - src%VmChunkSz                                 ;
+		struct iovec local  { .iov_base=buf                           , .iov_len=chunk } ;
+		struct iovec remote { .iov_base=reinterpret_cast<void*>(src) , .iov_len=chunk } ;
+		ssize_t      cnt    = ::process_vm_readv( pid , &local , 1 , &remote , 1 , 0 )  ;
+		if (cnt<=0) {
+			if ( cnt<0 && _vm_unavailable() ) return res + _ptrace_get_str(pid,src) ;
+			throw cnt<0 ? errno : EFAULT ;                                                   // /!\ dont throw 0 as it means file is simple
+		}
+		if ( const char* end = static_cast<const char*>(::memchr(buf,0,cnt)) ) {
+			res.append( buf , end-buf ) ;
+			if (SyscallDescr::s_chk_tracee) SyscallDescr::s_chk_tracee() ;
+			return res ;
+		}
+		res.append( buf , cnt ) ;
+		src += cnt ;
+	}
+}
 
-// copy src to process pid's space @ dst
+// copy src in process pid's space to dst
 [[maybe_unused]] static void _peek( pid_t pid , char* dst , uint64_t src , size_t sz ) {
 	SWEAR(pid) ;
+	struct iovec local  { .iov_base=dst                          , .iov_len=sz } ;
+	struct iovec remote { .iov_base=reinterpret_cast<void*>(src) , .iov_len=sz } ;
+	ssize_t      cnt    = ::process_vm_readv( pid , &local , 1 , &remote , 1 , 0 ) ;
+	if (cnt==ssize_t(sz)) {
+		if (SyscallDescr::s_chk_tracee) SyscallDescr::s_chk_tracee() ;
+		return ;
+	}
+	if (!( cnt<0 && _vm_unavailable() )) throw cnt<0 ? errno : EFAULT ;
 	errno = 0 ;
 	for( size_t chunk ; sz ; src+=chunk , dst+=chunk , sz-=chunk) { // invariant : copy src[i:sz] to dst
 		size_t offset = src%sizeof(long) ;
@@ -38,11 +74,17 @@
 		chunk = ::min( sizeof(long) - offset , sz ) ;
 		::memcpy( dst , reinterpret_cast<char*>(&word)+offset , chunk ) ;
 	}
+	if (SyscallDescr::s_chk_tracee) SyscallDescr::s_chk_tracee() ;
 }
 
 // copy src to process pid's space @ dst
 [[maybe_unused]] static void _poke( pid_t pid , uint64_t dst , const char* src , size_t sz ) {
 	SWEAR(pid) ;
+	struct iovec local  { .iov_base=const_cast<char*>(src)       , .iov_len=sz } ;
+	struct iovec remote { .iov_base=reinterpret_cast<void*>(dst) , .iov_len=sz } ;
+	ssize_t      cnt    = ::process_vm_writev( pid , &local , 1 , &remote , 1 , 0 ) ;
+	if (cnt==ssize_t(sz)               ) return ;
+	if (!( cnt<0 && _vm_unavailable() )) throw cnt<0 ? errno : EFAULT ;
 	errno = 0 ;
 	for( size_t chunk ; sz ; src+=chunk , dst+=chunk , sz-=chunk) {                 // invariant : copy src[i:sz] to dst
 		size_t offset = dst%sizeof(long) ;
@@ -427,4 +469,5 @@ static constexpr SyscallDescr::Tab _build_syscall_descr_tab() {
 }
 
 constexpr SyscallDescr::Tab _syscall_descr_tab = _build_syscall_descr_tab() ;
-SyscallDescr::Tab const& SyscallDescr::s_tab = _syscall_descr_tab ;
+SyscallDescr::Tab const& SyscallDescr::s_tab          = _syscall_descr_tab ;
+void                   (*SyscallDescr::s_chk_tracee)() = nullptr           ;
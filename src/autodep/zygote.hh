@@ -0,0 +1,31 @@
+// This file is part of the open-lmake distribution (git@github.com:cesar-douady/open-lmake.git)
+// Copyright (c) 2023 Doliam
+// This program is free software: you can redistribute/modify under the terms of the GPL-v3 (https://www.gnu.org/licenses/gpl-3.0.html).
+// This program is distributed WITHOUT ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+#pragma once
+
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "fd.hh"
+
+// a zygote runs python jobs by forking a process in which modules are already imported, cf. _lib/lmake/zygote.py
+// zygotes are per host and listen to an abstract unix socket whose name is derived from all that makes them suitable for a job
+// as abstract sockets are visible to all users, both sides check the peer runs as the same user
+
+namespace Zygote {
+
+	static constexpr char SockPfx[] = "lmake_zygote_" ;
+
+	inline AutoCloseFd connect(::string const& sock_name) { // return an invalid fd if no zygote listens to sock_name
+		struct sockaddr_un addr = { .sun_family=AF_UNIX , .sun_path={} } ;
+		if (sock_name.size()+1>sizeof(addr.sun_path)) return {} ;
+		::memcpy( addr.sun_path+1 , sock_name.data() , sock_name.size() ) ;                                                   // abstract socket : sun_path starts with a null
+		AutoCloseFd fd = ::socket( AF_UNIX , SOCK_STREAM|SOCK_CLOEXEC , 0 ) ;
+		if (::connect( fd , reinterpret_cast<struct sockaddr*>(&addr) , offsetof(struct sockaddr_un,sun_path)+1+sock_name.size() )!=0) return {} ;
+		if (!SockFd::s_same_user(fd)                                                                                                 ) return {} ; // abstract sockets are visible to all users, only trust ours
+		return fd ;
+	}
+
+}
@@ -0,0 +1,151 @@
+// This file is part of the open-lmake distribution (git@github.com:cesar-douady/open-lmake.git)
+// Copyright (c) 2023 Doliam
+// This program is free software: you can redistribute/modify under the terms of the GPL-v3 (https://www.gnu.org/licenses/gpl-3.0.html).
+// This program is distributed WITHOUT ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+#include <poll.h>
+
+#include "disk.hh"
+#include "msg.hh"
+#include "process.hh"
+
+#include "rpc_job_exec.hh"
+
+#include "record.hh"
+#include "zygote.hh"
+
+// run a python job in a zygote (cf. _lib/lmake/zygote.py for a description of the protocol)
+// usage : zygote_client <sock_name> <n_interpreter> <interpreter>... <args>...
+// this program is launched by job_exec as the job, and stands for it :
+// - it reports accesses done by the zygote while warming up, as if they had been done by the job
+// - it forwards signals to the job and exits the same way the job does
+// if zygote cannot be used (not running or stale), interpreter is exec'ed with args, exactly as if there were no zygote
+
+using namespace Disk ;
+
+using Jerr = JobExecRpcReq ;
+using Proc = JobExecProc   ;
+
+static ::vector<int> const FwdSigs = { SIGHUP , SIGINT , SIGQUIT , SIGTERM , SIGUSR1 , SIGUSR2 } ; // signals forwarded to job
+
+static ::vector_s _g_cmd_line ; // cmd line to exec if zygote cannot be used
+
+[[noreturn]] static void _exec_interpreter() {
+	::vector<const char*> argv ; argv.reserve(_g_cmd_line.size()+1) ;
+	for( ::string const& a : _g_cmd_line ) argv.push_back(a.c_str()) ;
+	/**/                                   argv.push_back(nullptr   ) ;
+	::execv( argv[0] , const_cast<char**>(argv.data()) ) ;
+	exit(Rc::System,"cannot exec ",_g_cmd_line[0]) ;
+}
+
+static bool/*ok*/ _read( Fd fd , void* buf , size_t sz ) {
+	for( size_t cnt=0 ; cnt<sz ;) {
+		ssize_t c = ::read( fd , static_cast<char*>(buf)+cnt , sz-cnt ) ;
+		if (c<=0) return false ;
+		cnt += c ;
+	}
+	return true ;
+}
+
+static bool/*ok*/ _send( Fd fd , ::string const& payload , bool with_std_fds ) {
+	int32_t       len     = payload.size()             ;
+	struct iovec  iov     = { &len , sizeof(len) }     ;
+	struct msghdr msg     = {}                         ;
+	alignas(struct cmsghdr) char cbuf[CMSG_SPACE(3*sizeof(int))] ;
+	msg.msg_iov    = &iov ;
+	msg.msg_iovlen = 1    ;
+	if (with_std_fds) {
+		int std_fds[3] = { Fd::Stdin , Fd::Stdout , Fd::Stderr } ;
+		msg.msg_control    = cbuf         ;
+		msg.msg_controllen = sizeof(cbuf) ;
+		struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg) ;
+		cmsg->cmsg_level = SOL_SOCKET                 ;
+		cmsg->cmsg_type  = SCM_RIGHTS                 ;
+		cmsg->cmsg_len   = CMSG_LEN(sizeof(std_fds)) ;
+		::memcpy( CMSG_DATA(cmsg) , std_fds , sizeof(std_fds) ) ;
+	}
+	if (::sendmsg(fd,&msg,0)!=sizeof(len)) return false ;
+	try                     { fd.write(payload) ; }
+	catch (::string const&) { return false ;      }
+	return true ;
+}
+
+// report accesses done by zygote while warming up, return false if any of them is stale
+static bool/*fresh*/ _report_deps(::string const& deps_file) {
+	::string content ;
+	try                     { content = read_content(deps_file) ; }
+	catch (::string const&) { return false ;                      }
+	Record         r       { New , Yes/*enabled*/ } ;
+	Fd             root_fd = Record::s_root_fd()    ;
+	::vector<Jerr> jerrs   ;
+	for( size_t pos=0 ; pos<content.size() ;) {
+		if (pos+sizeof(MsgBuf::Len)>content.size()) return false ;                                                       // truncated, zygote is not reliable
+		size_t len = MsgBuf::s_sz(content.data()+pos) ;
+		if (pos+sizeof(MsgBuf::Len)+len>content.size()) return false ;                                                   // .
+		Jerr jerr = IMsgBuf::s_receive<Jerr>(content.data()+pos) ;
+		pos += sizeof(MsgBuf::Len)+len ;
+		if ( jerr.proc!=Proc::Access || jerr.digest.write!=No ) continue ;                                              // only deps are relevant, warming up must not write
+		if (+jerr.digest.accesses)
+			for( auto const& [f,fi] : jerr.files ) if ( FileSig(root_fd,f)!=fi.sig() ) return false ;                      // file has changed since zygote read it
+		jerrs.push_back(::move(jerr)) ;
+	}
+	for( Jerr& jerr : jerrs ) r.report_direct(::move(jerr)) ;
+	return true ;
+}
+
+int main( int argc , char* argv[] ) {
+	if (argc<4) exit(Rc::Usage,"usage : ",argv[0]," sock_name n_interpreter interpreter... args...") ;
+	::string sock_name = argv[1]                                 ;
+	size_t   n_interp  = from_string<size_t>(argv[2])            ;
+	_g_cmd_line        = ::vector_s( argv+3 , argv+argc )       ;
+	if ( !n_interp || n_interp>=_g_cmd_line.size() ) exit(Rc::Usage,"bad interpreter size ",n_interp) ;
+	//
+	AutoCloseFd fd = Zygote::connect(sock_name) ;
+	if (!fd) _exec_interpreter() ;                                                                                          // no zygote
+	//
+	int32_t deps_file_sz = 0 ;
+	if (!_read(fd,&deps_file_sz,sizeof(deps_file_sz))) _exec_interpreter() ;
+	::string deps_file ( deps_file_sz , 0 ) ;
+	if (!_read(fd,deps_file.data(),deps_file.size())) _exec_interpreter() ;
+	if (!_report_deps(deps_file)) {
+		char c ;
+		if (_send(fd,{},false/*with_std_fds*/)) _read(fd,&c,1) ;                                                             // ask stale zygote to exit and wait for eof, so a fresh one can be launched by next job
+		_exec_interpreter() ;
+	}
+	//
+	::string payload = cwd_s() ; payload.pop_back() ;                                                                       // no trailing slash
+	payload <<'\0'<< (_g_cmd_line.size()-n_interp) ;
+	for( size_t i=n_interp ; i<_g_cmd_line.size() ; i++ ) payload <<'\0'<< _g_cmd_line[i] ;
+	for( char** e=environ ; *e ; e++ )                     payload <<'\0'<< *e             ;
+	//
+	block_sigs(FwdSigs) ;                                                                                                  // block before job exists so no signal is lost
+	int32_t pid = 0 ;
+	if ( !_send(fd,payload,true/*with_std_fds*/) || !_read(fd,&pid,sizeof(pid)) ) {                                         // zygote did not take the job
+		unblock_sigs(FwdSigs) ;
+		_exec_interpreter() ;
+	}
+	//
+	AutoCloseFd   sig_fd  = open_sigs_fd(FwdSigs) ;
+	struct pollfd fds[2]  = { {.fd=fd,.events=POLLIN,.revents=0} , {.fd=sig_fd,.events=POLLIN,.revents=0} } ;
+	int32_t       wstatus = 0 ;
+	for(;;) {
+		if (::poll(fds,2,-1/*timeout*/)<0) continue ;
+		if (fds[1].revents) {
+			struct signalfd_siginfo si ;
+			if (_read(sig_fd,&si,sizeof(si))) ::kill(-pid,si.ssi_signo) ;                                                   // job is in its own session
+		}
+		if (fds[0].revents) {
+			if (_read(fd,&wstatus,sizeof(wstatus))) break ;
+			::kill(-pid,SIGKILL) ;                                                                                          // zygote has gone, we cannot know when job ends
+			exit(Rc::System,"zygote disappeared") ;
+		}
+	}
+	if (WIFEXITED  (wstatus)) return WEXITSTATUS(wstatus) ;                                                                 // exit as transparently as possible
+	if (WIFSIGNALED(wstatus)) {                                                                                             // .
+		int sig = WTERMSIG(wstatus) ;
+		::signal(sig,SIG_DFL) ;
+		unblock_sigs({sig}) ;
+		::raise(sig) ;
+	}
+	exit(Rc::System,"unexpected wstatus : ",wstatus) ;
+}
@@ -19,6 +19,7 @@
 using CodecIdx    = uint32_t ; // used to store code <-> value associations in lencode/ldecode
 using DepsIdx     = uint32_t ; // used to index deps
 using FileNameIdx = uint16_t ; // 64k for a file name is already ridiculously long
+using InvJobsIdx  = uint32_t ; // used to index reverse deps & targets, i.e. jobs referencing a node
 using JobIdx      = uint32_t ; // 2 guard bits
 using JobTgtsIdx  = uint32_t ; // JobTgts are used to store job candidate for each Node, so this Idx is a little bit larget than NodeIdx
 using NameIdx     = uint32_t ; // used to index Rule & Job names
@@ -88,6 +89,16 @@ static constexpr SeqId JobHistorySz = 1000 ;
 // backlog of incoming connections from remote jobs (i.e. number of pending connect calls before connections are refused)
 static constexpr int JobExecBacklog = 4096 ; // max usual value as set in /proc/sys/net/core/somaxconn
 
+// number of threads preparing job ends before they are handed to the engine thread
+static constexpr size_t NJobEndPrepThreads = 4 ;
+
+// number of threads evaluating start attributes of launched jobs before they connect (only for backends configured with precompute_start)
+static constexpr size_t NStartPrepThreads = 4 ;
+
+// max number of launched jobs whose start is prepared ahead of time, i.e. waiting for, undergoing or done with this preparation but not started yet
+// this bounds memory and useless evaluations when jobs are launched long before they start (e.g. when queued in a batch system), while covering bursts of launched jobs
+static constexpr size_t MaxStartPreps = 1000 ;
+
 //
 // derived info
 //
@@ -3,9 +3,12 @@
 // This program is free software: you can redistribute/modify under the terms of the GPL-v3 (https://www.gnu.org/licenses/gpl-3.0.html).
 // This program is distributed WITHOUT ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
 
+#include <sys/ioctl.h>
 #include <sys/mman.h>
 #include <sys/sendfile.h>
 
+#include <linux/fs.h>     // FICLONE
+
 #include "disk.hh"
 #include "hash.hh"
 
@@ -342,6 +345,22 @@ namespace Disk {
 		if (has_dir(file)) mk_dir_s(at,dir_name_s(file)) ;
 	}
 
+	static void _cpy_reg( Fd dst_at , ::string const& dst_file , Fd rfd , FileInfo const& fi , bool mk_read_only ) {
+		AutoCloseFd wfd = open_write( dst_at , dst_file , false/*append*/ , fi.tag()==FileTag::Exe , mk_read_only ) ;
+		if (::ioctl(wfd,FICLONE,rfd.fd)==0) return ;                                                                // reflink if file system supports it (shares data until modified)
+		::sendfile( wfd , rfd , nullptr , fi.sz ) ;
+	}
+
+	FileTag cpy( Fd dst_at , ::string const& dst_file , Fd src_fd , bool unlnk_dst , bool mk_read_only ) {
+		FileInfo fi  { src_fd } ;
+		FileTag  tag = fi.tag() ;
+		SWEAR( tag==FileTag::Reg || tag==FileTag::Exe , src_fd , tag ) ;                                            // only regular files can be copied from an open fd
+		if (unlnk_dst) unlnk(dst_at,dst_file)                                 ;
+		else           SWEAR( !is_target(dst_at,dst_file) , dst_at,dst_file ) ;
+		_cpy_reg( dst_at , dst_file , src_fd , fi , mk_read_only ) ;
+		return tag ;
+	}
+
 	FileTag cpy( Fd dst_at , ::string const& dst_file , Fd src_at , ::string const& src_file , bool unlnk_dst , bool mk_read_only ) {
 		FileInfo fi { src_at , src_file } ;
 		FileTag tag = fi.tag()            ;
@@ -351,9 +370,8 @@ namespace Disk {
 			case FileTag::None : break ;
 			case FileTag::Reg  :
 			case FileTag::Exe  : {
-				AutoCloseFd rfd = ::openat  ( src_at , src_file.c_str() , O_RDONLY                                           ) ;
-				AutoCloseFd wfd = open_write( dst_at , dst_file         , false/*append*/ , tag==FileTag::Exe , mk_read_only ) ;
-				::sendfile( wfd , rfd , nullptr , fi.sz ) ;
+				AutoCloseFd rfd = ::openat( src_at , src_file.c_str() , O_RDONLY|O_CLOEXEC ) ;
+				_cpy_reg( dst_at , dst_file , rfd , fi , mk_read_only ) ;
 			}
 			break ;
 			case FileTag::Lnk : {
@@ -278,6 +278,10 @@ namespace Disk {
 		}
 	}
 
+	inline bool/*done*/ hard_lnk( Fd dst_at , ::string const& dst_file , Fd src_at , ::string const& src_file ) { // fails if dst_file exists or is on another file system
+		return ::linkat( src_at , src_file.c_str() , dst_at , dst_file.c_str() , 0/*flags*/ )==0 ;
+	}
+
 	inline Fd open_read( Fd at , ::string const& filename ) {
 		return ::openat( at , filename.c_str() , O_RDONLY|O_CLOEXEC , 0666 ) ;
 	}
@@ -333,6 +337,7 @@ namespace Disk {
 	inline FileTag cpy(             ::string const& df       , Fd sat    , ::string const& sf       , bool ud       =false , bool ro          =false ) { return cpy(Fd::Cwd,df,sat    ,sf,ud,ro) ; }
 	inline FileTag cpy( Fd dat    , ::string const& df       ,             ::string const& sf       , bool ud       =false , bool ro          =false ) { return cpy(dat    ,df,Fd::Cwd,sf,ud,ro) ; }
 	inline FileTag cpy(             ::string const& df       ,             ::string const& sf       , bool ud       =false , bool ro          =false ) { return cpy(Fd::Cwd,df,Fd::Cwd,sf,ud,ro) ; }
+	/**/   FileTag cpy( Fd dst_at , ::string const& dst_file , Fd src_fd ,                            bool unlnk_dst=false , bool mk_read_only=false ) ; // src_fd must be an open regular file, which allows to copy a snapshot
 
 	struct FileMap {
 		// cxtors & casts
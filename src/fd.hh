@@ -131,6 +131,25 @@ struct SockFd : AutoCloseFd {
 	static ::string s_service( ::string const& host , in_port_t port ) { return host+':'+port                    ; }
 	static ::string s_service( in_addr_t       addr , in_port_t port ) { return s_service(s_addr_str(addr),port) ; }
 	static ::string s_service(                        in_port_t port ) { return s_service(host()          ,port) ; }
+	//
+	static bool/*ok*/ s_same_user(Fd fd) {                                                   // for unix sockets, true if peer runs as the same user as we do
+		struct ucred cred     ;
+		socklen_t    cred_len = sizeof(cred) ;
+		if (::getsockopt( fd , SOL_SOCKET , SO_PEERCRED , &cred , &cred_len )!=0) return false ;
+		return cred.uid==::getuid() ;
+	}
+	static bool/*ok*/ s_send_some( Fd fd , ::string& buf/*inout*/ ) {                          // send as much of buf as possible without blocking, return false if peer is gone
+		size_t cnt = 0 ;
+		while (cnt<buf.size()) {
+			ssize_t c = ::send( fd , buf.data()+cnt , buf.size()-cnt , MSG_DONTWAIT|MSG_NOSIGNAL ) ;
+			if ( c>0                                   ) { cnt += c ; continue ; }
+			if ( c<0 && (errno==EAGAIN||errno==EINTR) ) { break ;               }
+			buf.clear() ;
+			return false ;
+		}
+		buf.erase(0,cnt) ;
+		return true ;
+	}
 private :
 	static size_t _s_col(::string const& service) {
 		size_t col = service.rfind(':') ;
@@ -246,6 +265,17 @@ struct Epoll {
 		swear_prod(rc==0,"cannot add",fd_,"to epoll",fd,'(',strerror(errno),')') ;
 		cnt += wait ;
 	}
+	template<class T> void mod( Fd fd_ , T data , uint32_t& events/*inout*/ , uint32_t new_events , bool wait=true ) {                            // events is the current registration, 0 if not registered
+		static_assert(sizeof(T)<=4) ;
+		if (new_events==events) return ;
+		epoll_event event { .events=new_events , .data={.u64=(uint64_t(uint32_t(data))<<32)|uint32_t(fd_) } } ;
+		int         op    = !events ? EPOLL_CTL_ADD : !new_events ? EPOLL_CTL_DEL : EPOLL_CTL_MOD ;
+		int         rc    = ::epoll_ctl( fd , op , fd_ , &event ) ;
+		swear_prod(rc==0,"cannot modify",fd_,"in epoll",fd,'(',strerror(errno),')') ;
+		if      (!events    ) cnt += wait ;
+		else if (!new_events) cnt -= wait ;
+		events = new_events ;
+	}
 	void del( Fd fd_ , bool wait=true ) {                                                                                                        // wait must be coherent with corresponding add
 		int rc = ::epoll_ctl( fd , EPOLL_CTL_DEL , fd_ , nullptr ) ;
 		swear_prod(rc==0,"cannot del",fd_,"from epoll",fd,'(',strerror(errno),')') ;
@@ -19,9 +19,11 @@
 #include "trace.hh"
 
 #include "autodep/gather.hh"
+#include "autodep/zygote.hh"
 
 #include "rpc_job.hh"
 #include "rpc_job_exec.hh"
+#include "rpc_job_relay.hh"
 
 using namespace Disk ;
 using namespace Hash ;
@@ -47,19 +49,20 @@ struct PatternDict {
 	::vmap<RegExpr,MatchFlags> patterns = {} ;
 } ;
 
-Gather      g_gather         ;
-JobIdx      g_job            = 0/*garbage*/ ;
-PatternDict g_match_dct      ;
-NfsGuard    g_nfs_guard      ;
-SeqId       g_seq_id         = 0/*garbage*/ ;
-::string    g_phy_root_dir_s ;
-::string    g_phy_tmp_dir_s  ;
-::string    g_service_start  ;
-::string    g_service_mngt   ;
-::string    g_service_end    ;
-JobRpcReply g_start_info     ;
-SeqId       g_trace_id       = 0/*garbage*/ ;
-::vector_s  g_washed         ;
+Gather      g_gather          ;
+JobIdx      g_job             = 0/*garbage*/ ;
+PatternDict g_match_dct       ;
+NfsGuard    g_nfs_guard       ;
+SeqId       g_seq_id          = 0/*garbage*/ ;
+::string    g_phy_root_dir_s  ;
+::string    g_phy_tmp_dir_s   ;
+::string    g_service_start   ;
+::string    g_service_mngt    ;
+::string    g_service_end     ;
+::string    g_relay_sock_name ; // if not empty, connect to server through the relay listening to this socket
+JobRpcReply g_start_info      ;
+SeqId       g_trace_id        = 0/*garbage*/ ;
+::vector_s  g_washed          ;
 
 struct Digest {
 	::vmap_s<TargetDigest> targets ;
@@ -124,8 +127,10 @@ Digest analyze(Status status=Status::New) {
 		if (status==Status::New) continue ;            // we are handling chk_deps and we only care about deps
 		// handle targets
 		if (is_tgt) {
-			if (ad.write==Maybe) relax.sleep_until() ; // /!\ if a write is interrupted, it may continue past the end of the process when accessing a network disk ...
-			//                                         // ... no need to optimize (could compute other crcs while waiting) as this is exceptional
+			// /!\ if a write is interrupted, it may continue past the end of the process when accessing a network disk ...
+			// ... no need to optimize (could compute other crcs while waiting) as this is exceptional
+			// with seccomp, writes are never confirmed, but they are not interrupted unless job is killed
+			if ( ad.write==Maybe && ( g_start_info.method!=AutodepMethod::Seccomp || status==Status::Killed ) ) relax.sleep_until() ;
 			bool    written  = ad.write==Yes ;
 			FileSig sig      ;
 			Crc     crc      ;                                                                                            // lazy evaluated (not in parallel, but need is exceptional)
@@ -204,9 +209,112 @@ Digest analyze(Status status=Status::New) {
 
 ::vmap_s<DepDigest> cur_deps_cb() { return analyze().deps ; }
 
+// return the name of the socket a suitable zygote listens to, launching it if necessary, or empty if job cannot be run from a zygote
+// a zygote is suitable if it has been launched with the same static part of cmd in the same context (cf. _lib/lmake/zygote.py)
+::string mk_zygote( ::map_ss const& cmd_env , bool entered ) {
+	Trace trace("mk_zygote",g_start_info.zygote_sz) ;
+	if (!g_start_info.zygote_sz                                 ) {                               return {} ; }
+	if (entered                                                 ) { trace("job_space"     ) ; return {} ; } // zygote is not in the job namespace
+	if (g_start_info.method<AutodepMethod::Ld                   ) { trace("no_ld"         ) ; return {} ; } // zygote must be able to change autodep config on the fly
+	if (g_start_info.zygote_sz>g_start_info.cmd.first.size()    ) { trace("bad_sz"        ) ; return {} ; }
+	::string warm_up_code = g_start_info.cmd.first.substr(g_start_info.cmd.first.size()-g_start_info.zygote_sz) ;
+	::map_ss zygote_env   = cmd_env                                                                       ;
+	for( const char* k : {"SEQUENCE_ID","SMALL_ID","TMPDIR"} ) zygote_env.erase(k) ;                              // per job variables are passed to each job
+	if ( auto it=zygote_env.find("HOME") ; it!=zygote_env.end() && it->second==no_slash(g_gather.autodep_env.tmp_dir_s) ) zygote_env.erase(it) ; // HOME defaults to tmp dir
+	//
+	Xxh h ;
+	h.update(*g_lmake_dir_s            ) ;
+	h.update(*g_root_dir_s             ) ;
+	h.update(g_start_info.cwd_s        ) ;
+	h.update(g_start_info.method       ) ;
+	h.update(g_start_info.interpreter  ) ;
+	h.update(warm_up_code              ) ;
+	h.update(zygote_env                ) ;
+	::string key       = ::string(h.digest()) ;
+	::string sock_name = Zygote::SockPfx+key  ;
+	if (+Zygote::connect(sock_name)) { trace("found",key) ; return sock_name ; }
+	//
+	::string dir_s   = g_phy_root_dir_s+PrivateAdminDirS+"zygotes/"+host()+'/' ;
+	::string pfx     = dir_s+key+'.'+::getpid()                                 ;
+	::string warm_up = pfx+".py"                                                ;
+	::string deps    = pfx+".deps"                                              ;
+	::string log     = pfx+".log"                                               ;                                 // per zygote, so a zygote losing a race does not clobber the log of the winner
+	OFStream(dir_guard(warm_up)) << warm_up_code ;
+	AutodepEnv ade = g_gather.autodep_env ;
+	ade.service      = deps+':' ;                                                                                 // record warm up accesses in deps, for zygote_client to report them
+	ade.ring         = {}       ;                                                                                 // these are job specific
+	ade.access_cache = {}       ;                                                                                 // .
+	::map_ss add_env { {"LMAKE_AUTODEP_ENV",ade} , Gather::s_autodep_lib_env(g_start_info.method,&zygote_env) } ;
+	::vector_s zygote_cmd_line = g_start_info.interpreter ;
+	zygote_cmd_line.push_back("-c") ;
+	zygote_cmd_line.push_back("import sys ; sys.path.insert(0,"+mk_py_str(*g_lmake_dir_s+"lib")+") ; import lmake.zygote as z ; del sys.path[0] ; sys.exit(z.main())") ;
+	zygote_cmd_line.push_back(sock_name) ;
+	zygote_cmd_line.push_back(warm_up  ) ;
+	zygote_cmd_line.push_back(deps     ) ;
+	zygote_cmd_line.push_back(log      ) ;                                                                        // zygote removes its log when it exits
+	bool ok = false ;
+	try {
+		AutoCloseFd stdin_fd  = open_read ("/dev/null") ; stdin_fd .no_std() ;
+		AutoCloseFd stderr_fd = open_write(log        ) ; stderr_fd.no_std() ;                                   // zygote is shared by all jobs, its errors cannot be reported to any of them
+		Child child {
+			.as_session = true
+		,	.cmd_line   = zygote_cmd_line
+		,	.stdin_fd   = stdin_fd
+		,	.stdout_fd  = Child::PipeFd
+		,	.stderr_fd  = stderr_fd
+		,	.env        = &zygote_env
+		,	.add_env    = &add_env
+		,	.cwd_s      = g_start_info.cwd_s
+		} ;
+		child.spawn() ;
+		char c ;
+		ok = ::read(child.stdout,&c,1)==1 ;                                                                         // zygote sends a byte when it is ready to serve
+		child.wait() ;                                                                                              // zygote has detached itself, we just reap the intermediate process
+	} catch (::string const& e) {
+		trace("cannot_spawn",e) ;
+	}
+	if (!ok) {
+		unlnk(warm_up) ;                                                                                            // log is kept as it is the only trace of why zygote could not start
+		if (!Zygote::connect(sock_name)) { trace("failed",key) ; return {} ; }                                      // if we lost a race, the winner is ok
+	}
+	trace("spawned",key) ;
+	return sock_name ;
+}
+
+// return the name of the socket the relay to relay_service listens to, launching it if necessary, or empty if no relay can be used (cf. job_relay.cc)
+::string mk_relay(::string const& relay_service) {
+	Trace trace("mk_relay",relay_service) ;
+	::string sock_name = JobRelay::sock_name(relay_service) ;
+	if (+JobRelay::connect_relay(sock_name)) { trace("found") ; return sock_name ; }
+	//
+	bool ok = false ;
+	try {
+		AutoCloseFd stdin_fd  = open_read ("/dev/null"                                                                  ) ; stdin_fd .no_std() ;
+		AutoCloseFd stderr_fd = open_write(dir_guard(g_phy_root_dir_s+PrivateAdminDirS+"relays/"+host()+".log")) ; stderr_fd.no_std() ; // relay is shared by all jobs ...
+		Child child {                                                                                                                          // ... its errors cannot be reported to any of them
+			.as_session = true
+		,	.cmd_line   = { *g_lmake_dir_s+"_bin/job_relay" , relay_service }
+		,	.stdin_fd   = stdin_fd
+		,	.stdout_fd  = Child::PipeFd
+		,	.stderr_fd  = stderr_fd
+		} ;
+		child.spawn() ;
+		char c ;
+		ok = ::read(child.stdout,&c,1)==1 ;                                                                                                    // relay sends a byte when it is ready to serve
+		child.wait() ;                                                                                                                         // relay has detached itself, we just reap the intermediate process
+	} catch (::string const& e) {
+		trace("cannot_spawn",e) ;
+	}
+	if ( !ok && !JobRelay::connect_relay(sock_name) ) { trace("failed") ; return {} ; }                                                       // if we lost a race, the winner is ok
+	trace("spawned") ;
+	return sock_name ;
+}
+
 ::string g_to_unlnk ;                                                                                            // XXX : suppress when CentOS7 bug is fixed
-::vector_s cmd_line() {
-	::vector_s cmd_line = ::move(g_start_info.interpreter) ;                                                     // avoid copying as interpreter is used only here
+::vector_s cmd_line(::string const& zygote_sock_name) {
+	::vector_s cmd_line ;
+	if (+zygote_sock_name) cmd_line = { *g_lmake_dir_s+"_bin/zygote_client" , zygote_sock_name , ::to_string(g_start_info.interpreter.size()) } ;
+	for( ::string& a : g_start_info.interpreter ) cmd_line.push_back(::move(a)) ;                                 // avoid copying as interpreter is used only here
 	if ( g_start_info.use_script || (g_start_info.cmd.first.size()+g_start_info.cmd.second.size())>ARG_MAX/2 ) { // env+cmd line must not be larger than ARG_MAX, keep some margin for env
 		// XXX : fix the bug with CentOS7 where the write seems not to be seen and old script is executed instead of new one
 		// correct code :
@@ -258,11 +366,11 @@ void crc_thread_func( size_t id , vmap_s<TargetDigest>* targets , ::vector<NodeI
 	return msg ;
 }
 
-int main( int argc , char* argv[] ) {
+static int _job_main( int argc , char* argv[] ) {
 	Pdate        start_overhead = Pdate(New) ;
 	ServerSockFd server_fd      { New }      ;             // server socket must be listening before connecting to server and last to the very end to ensure we can handle heartbeats
 	//
-	swear_prod(argc==8,argc) ;                             // syntax is : job_exec server:port/*start*/ server:port/*mngt*/ server:port/*end*/ seq_id job_idx root_dir trace_file
+	swear_prod(argc==8||argc==9,argc) ;                   // syntax is : job_exec server:port/*start*/ server:port/*mngt*/ server:port/*end*/ seq_id job_idx root_dir trace_file [server:port/*relay*/]
 	g_service_start  =                     argv[1]  ;
 	g_service_mngt   =                     argv[2]  ;
 	g_service_end    =                     argv[3]  ;
@@ -283,23 +391,29 @@ int main( int argc , char* argv[] ) {
 	block_sigs({SIGCHLD}) ;                                                                                // necessary to capture it using signalfd
 	app_init(false/*read_only_ok*/,No/*chk_version*/) ;
 	//
-	{	Trace trace("main",Pdate(New),::vector_view(argv,8)) ;
+	{	Trace trace("main",Pdate(New),::vector_view(argv,argc)) ;
 		trace("pid",::getpid(),::getpgrp()) ;
 		trace("start_overhead",start_overhead) ;
 		//
+		if (argc>8) g_relay_sock_name = mk_relay(argv[8]) ;
+		//
 		bool found_server = false ;
-		try {
-			ClientSockFd fd {g_service_start,NConnectionTrials} ;
-			fd.set_timeout(Delay(100)) ;                                                                   // ensure we dont stay stuck in case server is in the coma ...
-			found_server = true ;                                                                          //  ... 100 = 100 simultaneous connections, 10 jobs/s
-			//             vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
-			/**/           OMsgBuf().send                ( fd , JobRpcReq{JobRpcProc::Start,g_seq_id,g_job,server_fd.port()} ) ;
-			g_start_info = IMsgBuf().receive<JobRpcReply>( fd                                                                ) ;
-			//             ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
-		} catch (::string const& e) {
-			trace("no_start_info",g_service_start,STR(found_server),e) ;
-			if (found_server) exit(Rc::Fail                                                       ) ;      // this is typically a ^C
-			else              exit(Rc::Fail,"cannot communicate with server",g_service_start,':',e) ;      // this may be a server config problem, better to report
+		for( bool relayed : {+g_relay_sock_name,false} ) {                                                 // if relay fails, retry directly
+			try {
+				ClientSockFd fd = JobRelay::connect( relayed?g_relay_sock_name:""s , JobRelayProc::Start , g_service_start , NConnectionTrials ) ;
+				fd.set_timeout(Delay(100)) ;                                                               // ensure we dont stay stuck in case server is in the coma ...
+				found_server = true ;                                                                      //  ... 100 = 100 simultaneous connections, 10 jobs/s
+				//             vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+				/**/           OMsgBuf().send                ( fd , JobRpcReq{JobRpcProc::Start,g_seq_id,g_job,server_fd.port()} ) ;
+				g_start_info = IMsgBuf().receive<JobRpcReply>( fd                                                                ) ;
+				//             ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
+				break ;
+			} catch (::string const& e) {
+				if (relayed) { trace("relay_failed",e) ; g_relay_sock_name.clear() ; found_server = false ; continue ; }
+				trace("no_start_info",g_service_start,STR(found_server),e) ;
+				if (found_server) exit(Rc::Fail                                                       ) ;  // this is typically a ^C
+				else              exit(Rc::Fail,"cannot communicate with server",g_service_start,':',e) ;  // this may be a server config problem, better to report
+			}
 		}
 		trace("g_start_info",Pdate(New),g_start_info) ;
 		switch (g_start_info.proc) {
@@ -327,8 +441,10 @@ int main( int argc , char* argv[] ) {
 		//
 		::map_ss              cmd_env       ;
 		::vmap_s<MountAction> enter_actions ;
+		bool                  entered       = false ;
 		try {
-			if ( g_start_info.enter( enter_actions , cmd_env , end_report.phy_tmp_dir_s , end_report.dynamic_env , g_gather.first_pid , g_job , g_phy_root_dir_s , g_seq_id ) ) {
+			entered = g_start_info.enter( enter_actions , cmd_env , end_report.phy_tmp_dir_s , end_report.dynamic_env , g_gather.first_pid , g_job , g_phy_root_dir_s , g_seq_id ) ;
+			if (entered) {
 				RealPath real_path { g_start_info.autodep_env } ;
 				for( auto& [f,a] : enter_actions ) {
 					RealPath::SolveReport sr = real_path.solve(f,true/*no_follow*/) ;
@@ -359,9 +475,12 @@ int main( int argc , char* argv[] ) {
 		g_gather.live_out          =        g_start_info.live_out               ;
 		g_gather.method            =        g_start_info.method                 ;
 		g_gather.network_delay     =        g_start_info.network_delay          ;
+		g_gather.job_access_cache  =        g_start_info.autodep_cache && !g_start_info.job_space.chroot_dir_s ; // shared memory is in /dev/shm, which may not be shared with a chroot'ed job
+		g_gather.report_ring       =        g_start_info.autodep_ring && !g_start_info.job_space.chroot_dir_s ; // .
 		g_gather.seq_id            =        g_seq_id                            ;
 		g_gather.server_master_fd  = ::move(server_fd                         ) ;
 		g_gather.service_mngt      =        g_service_mngt                      ;
+		g_gather.relay_sock_name   =        g_relay_sock_name                   ;
 		g_gather.timeout           =        g_start_info.timeout                ;
 		//
 		if (!g_start_info.method)                                                                          // if no autodep, consider all static deps are fully accessed as we have no precise report
@@ -386,7 +505,7 @@ int main( int argc , char* argv[] ) {
 			g_gather.new_target( start_overhead , g_start_info.stdout , "<stdout>" ) ;
 			g_gather.child_stdout.no_std() ;
 		}
-		g_gather.cmd_line = cmd_line() ;
+		g_gather.cmd_line = cmd_line(mk_zygote(cmd_env,entered)) ;
 		//              vvvvvvvvvvvvvvvvvvvvv
 		Status status = g_gather.exec_child() ;
 		//              ^^^^^^^^^^^^^^^^^^^^^
@@ -427,24 +546,81 @@ int main( int argc , char* argv[] ) {
 		,	.stats{
 				.cpu { Delay(rsrcs.ru_utime) + Delay(rsrcs.ru_stime) }
 			,	.job { g_gather.end_date-g_gather.start_date         }
-			,	.mem = size_t(rsrcs.ru_maxrss<<10)
+			,	.mem              = size_t(rsrcs.ru_maxrss<<10)
+			,	.n_access_reports = g_gather.n_access_reports
 			}
 		} ;
 	}
 End :
 	{	Trace trace("end",end_report.digest.status) ;
-		try {
-			ClientSockFd fd           { g_service_end , NConnectionTrials } ;
-			Pdate        end_overhead = New                                 ;
-			end_report.digest.stats.total = end_overhead - start_overhead ;                                // measure overhead as late as possible
-			//vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
-			OMsgBuf().send( fd , end_report ) ;
-			//^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
-			trace("done",end_overhead) ;
-		} catch (::string const& e) { exit(Rc::Fail,"after job execution : ",e) ; }
+		for( bool relayed : {+g_relay_sock_name,false} ) {                                                 // if relay fails, retry directly
+			try {
+				ClientSockFd fd           = JobRelay::connect( relayed?g_relay_sock_name:""s , JobRelayProc::End , g_service_end , NConnectionTrials ) ;
+				Pdate        end_overhead = New                                                                                                       ;
+				end_report.digest.stats.total = end_overhead - start_overhead ;                            // measure overhead as late as possible
+				//vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+				OMsgBuf().send( fd , end_report ) ;
+				//^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
+				JobRelay::wait_ack(fd) ;                                                                   // ensure server has received report if relayed
+				trace("done",end_overhead) ;
+				break ;
+			} catch (::string const& e) {
+				if (relayed) { trace("relay_failed",e) ; continue ; }
+				exit(Rc::Fail,"after job execution : ",e) ;
+			}
+		}
 	}
 	try                       { g_start_info.exit() ;                             }
 	catch (::string const& e) { exit(Rc::Fail,"cannot cleanup namespaces : ",e) ; }
 	//
 	return 0 ;
 }
+
+// when launched with no argument, job_exec is a fork server (the pool) from which jobs are forked, saving exec and initialization of job_exec for each job
+// it is not a persistent worker : each forked job_exec connects to server and sets up its job space as if it had been spawned
+// it reads job command lines from stdin and exits when stdin is closed
+// it reports on stdout the pid of each forked job_exec (or -1 if fork failed) as well as the exit status of each of them, as it is their parent
+static int _pool_main() {
+	block_sigs({SIGCHLD}) ;                                                            // necessary to capture it using signalfd
+	AutoCloseFd   child_fd = open_sigs_fd({SIGCHLD}) ;
+	Epoll         epoll    { New }                   ;
+	auto report = [](JobPoolMsg const& msg)->bool/*ok*/ {
+		return ::write(Fd::Stdout,&msg,sizeof(msg))==sizeof(msg) ;
+	} ;
+	epoll.add_read(Fd::Stdin) ;
+	epoll.add_read(child_fd ) ;
+	for(;;) {
+		for( Epoll::Event const& event : epoll.wait() ) {
+			if (event.fd()==child_fd) {
+				struct signalfd_siginfo si ;
+				if (::read(child_fd,&si,sizeof(si))!=sizeof(si)) return 0 ;
+				int wstatus ;
+				for( pid_t pid ; (pid=::waitpid(-1,&wstatus,WNOHANG))>0 ;)
+					if (!report({.exited=true,.pid=pid,.wstatus=wstatus})) return 0 ;    // server does not need us any more
+				continue ;
+			}
+			::vector_s cmd_line ;
+			try                     { cmd_line = IMsgBuf().receive<::vector_s>(Fd::Stdin) ; }
+			catch (::string const&) { return 0 ;                                           } // server does not need us any more
+			pid_t pid = ::fork() ;
+			if (pid==0) {                                                              // in child : behave exactly as if spawned by server
+				unblock_sigs({SIGCHLD}) ;
+				::setsid() ;
+				::close(Fd::Stdin ) ;
+				::close(Fd::Stdout) ;
+				child_fd.close() ;
+				epoll.fd.close() ;
+				::vector<char*> argv ; argv.reserve(cmd_line.size()+1) ;
+				for( ::string& a : cmd_line ) argv.push_back(a.data()) ;
+				/**/                          argv.push_back(nullptr ) ;
+				return _job_main( cmd_line.size() , argv.data() ) ;
+			}
+			if (!report({.exited=false,.pid=pid,.wstatus=0})) return 0 ;
+		}
+	}
+}
+
+int main( int argc , char* argv[] ) {
+	if (argc==1) return _pool_main()          ;
+	else         return _job_main(argc,argv) ;
+}
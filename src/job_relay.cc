@@ -0,0 +1,191 @@
+// This file is part of the open-lmake distribution (git@github.com:cesar-douady/open-lmake.git)
+// Copyright (c) 2023 Doliam
+// This program is free software: you can redistribute/modify under the terms of the GPL-v3 (https://www.gnu.org/licenses/gpl-3.0.html).
+// This program is distributed WITHOUT ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+#include "fd.hh"
+#include "msg.hh"
+#include "time.hh"
+
+#include "rpc_job_relay.hh"
+
+// carry connections between jobs running on this host and server over a single link (cf. rpc_job_relay.hh for a description of the protocol)
+// usage : job_relay <relay_service>
+// this program is launched by job_exec when its backend is configured to use a relay
+// it detaches itself as soon as it is ready to serve and exits when server closes link or when no job has used it for a while
+
+using namespace Time ;
+
+using Proc = JobRelayProc ;
+
+static constexpr Delay IdleTimeout { 600 } ; // relay exits when no job has used it for that long
+
+ENUM( EventKind
+,	Master  // listening socket
+,	Link    // connection to server
+,	Pending // job connection waiting for its proc
+,	Chan    // open channel
+)
+
+struct Chan {
+	Fd       fd     ;
+	bool     by_job = false ; // if true <=> channel has been opened by job (else by server)
+	bool     rd_eof = false ; // if true <=> we have told server there will be no more data from fd
+	bool     wr_eof = false ; // if true <=> server has told us there will be no more data to write to fd
+	bool     shut   = false ; // if true <=> fd has been shut down for writing, which occurs once out is empty after wr_eof
+	uint32_t events = 0     ; // current epoll registration of fd
+	::string out    ;         // data waiting to be written to fd
+} ;
+
+int main( int argc , char* argv[] ) {
+	if (argc!=2) exit(Rc::Usage,"usage : ",argv[0]," relay_service") ;
+	::string relay_service = argv[1]                          ;
+	::string sock_name     = JobRelay::sock_name(relay_service) ;
+	::signal(SIGPIPE,SIG_IGN) ;                                                                               // a job or the server may disappear while we write to it
+	//
+	AutoCloseFd        master_fd = ::socket( AF_UNIX , SOCK_STREAM|SOCK_CLOEXEC , 0 ) ;
+	struct sockaddr_un addr      = { .sun_family=AF_UNIX , .sun_path={} }            ;
+	if (sock_name.size()+1>sizeof(addr.sun_path)) exit(Rc::Usage,"relay service name too long : ",relay_service) ;
+	::memcpy( addr.sun_path+1 , sock_name.data() , sock_name.size() ) ;                                     // abstract socket : sun_path starts with a null
+	if (::bind( master_fd , reinterpret_cast<struct sockaddr*>(&addr) , offsetof(struct sockaddr_un,sun_path)+1+sock_name.size() )!=0) return 0 ; // another relay won the race, let it serve
+	if (::listen(master_fd,SOMAXCONN)!=0                                                                                               ) exit(Rc::System,"cannot listen to ",sock_name) ;
+	ClientSockFd link_fd ;
+	try                       { link_fd.connect(relay_service,3/*n_trials*/) ;         }
+	catch (::string const& e) { exit(Rc::Fail,"cannot connect to ",relay_service," : ",e) ; }
+	//
+	if (::write(Fd::Stdout,"1",1)!=1) exit(Rc::System,"cannot report readiness") ;                        // tell job_exec we are ready
+	if (::fork()!=0                 ) return 0 ;                                                           // detach from job_exec, which waits for us
+	{	AutoCloseFd null = ::open("/dev/null",O_WRONLY|O_CLOEXEC) ;
+		::dup2(null,Fd::Stdout) ;                                                                          // release pipe to job_exec
+	}
+	//
+	Epoll                 epoll       { New } ;
+	IMsgBuf               link_buf    ;
+	::string              link_out    ;         // data waiting to be sent to server
+	uint32_t              link_events = 0     ; // current epoll registration of link_fd
+	::uset<Fd>            pendings    ;         // job connections waiting for their proc
+	::umap<uint32_t,Chan> chans       ;
+	::umap<Fd,uint32_t>   fd_chans    ;
+	uint32_t              next_chan   = 0     ;
+	Pdate                 last_active = New   ;
+	size_t                n_job_chans = 0     ; // number of channels opened by jobs , for statistics
+	size_t                n_srv_chans = 0     ; // number of channels opened by server, .
+	epoll.add_read( master_fd , EventKind::Master ) ;
+	//
+	auto flush_link = [&]()->void {                                                                        // never block on server, it may itself be blocked sending to us
+		if (!SockFd::s_send_some(link_fd,link_out)) exit(Rc::Fail) ;                                       // server is gone, nothing to relay any more
+		epoll.mod( link_fd , EventKind::Link , link_events , uint32_t(EPOLLIN)|(+link_out?uint32_t(EPOLLOUT):0u) ) ;
+	} ;
+	auto send = [&]( Proc proc , uint32_t chan , ::string&& data={} )->void {
+		link_out += OMsgBuf::s_send(JobRelayMsg{ .proc=proc , .chan=chan , .port=0 , .data=::move(data) }) ;
+		flush_link() ;
+	} ;
+	auto flush_chan = [&](uint32_t id)->void {                                                             // write what can be, shut down when done, update epoll and close when all is over
+		Chan& c = chans.at(id) ;
+		if ( +c.out && !SockFd::s_send_some(c.fd,c.out) ) c.wr_eof = true ;                                 // job is gone, ignore further data
+		if ( c.wr_eof && !c.out && !c.shut              ) { ::shutdown(c.fd,SHUT_WR) ; c.shut = true ; }
+		epoll.mod( c.fd , EventKind::Chan , c.events , (c.rd_eof?0u:uint32_t(EPOLLIN))|(+c.out?uint32_t(EPOLLOUT):0u) ) ;
+		if ( !c.rd_eof || !c.shut ) return ;
+		fd_chans.erase(c.fd) ;
+		::close(c.fd) ;
+		chans.erase(id) ;
+	} ;
+	flush_link() ;                                                                                         // register link_fd
+	//
+	for(;;) {
+		Delay timeout = Delay::Forever ;
+		if ( !pendings && !chans ) {
+			timeout = last_active+IdleTimeout-Pdate(New) ;
+			if (timeout<=Delay()) break ;                                                                    // idle for too long
+		}
+		::vector<Epoll::Event> events = epoll.wait(timeout) ;
+		for( Epoll::Event const& event : events ) {
+			EventKind kind = event.data<EventKind>() ;
+			Fd        efd  = event.fd()              ;
+			switch (kind) {
+				case EventKind::Master : {
+					Fd fd = ::accept4( master_fd , nullptr , nullptr , SOCK_CLOEXEC ) ;
+					if (!fd                      ) break ;                                                   // job may have given up, nothing to do
+					if (!SockFd::s_same_user(fd)) { ::close(fd) ; break ; }                                   // abstract sockets are visible to all users, only serve ours
+					epoll.add_read( fd , EventKind::Pending ) ;
+					pendings.insert(fd) ;
+				} break ;
+				case EventKind::Pending : {
+					char p    = 0                   ;
+					bool ok   = ::read(efd,&p,1)==1 ;
+					Proc proc = Proc(p)             ;
+					epoll.del(efd) ;
+					pendings.erase(efd) ;
+					if ( !ok || !( proc==Proc::Start || proc==Proc::Mngt || proc==Proc::End ) ) {              // bad job
+						::close(efd) ;
+						break ;
+					}
+					uint32_t id = next_chan ;
+					do next_chan = (next_chan+1)&~JobRelayMsg::ServerChan ; while (chans.contains(next_chan)) ;
+					chans[id]     = { .fd=efd , .by_job=true  , .rd_eof=false , .wr_eof=false , .shut=false , .events=0 , .out={} } ;
+					fd_chans[efd] = id                                                                                          ;
+					flush_chan(id) ;                                                                         // register efd
+					send(proc,id) ;
+					n_job_chans++ ;
+					last_active = New ;
+				} break ;
+				case EventKind::Chan : {
+					auto it = fd_chans.find(efd) ; if (it==fd_chans.end()) break ;                             // channel has been closed while processing previous events
+					uint32_t id = it->second   ;
+					Chan&    c  = chans.at(id) ;
+					if ( !c.rd_eof && (event.events&~uint32_t(EPOLLOUT)) ) {                                   // readable, or error/hang up
+						char    buf[1<<16]                  ;
+						ssize_t cnt = ::read(efd,buf,sizeof(buf)) ;
+						if (cnt>0) {                   send( Proc::Data  , id , ::string(buf,cnt) ) ; }
+						else       { c.rd_eof = true ; send( Proc::Close , id                     ) ; }
+					}
+					flush_chan(id) ;
+				} break ;
+				case EventKind::Link : {
+					if (event.events&EPOLLOUT) flush_link() ;
+					if (!(event.events&~uint32_t(EPOLLOUT))) break ;
+					JobRelayMsg msg ;
+					try                     { if (!link_buf.receive_step(link_fd,msg)) break ; }
+					catch (::string const&) { goto Done ;                                      }         // server closed link, we are done
+					auto it = chans.find(msg.chan) ;
+					switch (msg.proc) {
+						case Proc::Connect : {
+							ClientSockFd job_fd ;
+							try                     { job_fd.connect( SockFd::LoopBackAddr , msg.port ) ; }
+							catch (::string const&) { send(Proc::Err,msg.chan) ; break ;                     } // job is not reachable, let server decide what to do
+							Fd fd = job_fd.detach() ;
+							chans[msg.chan] = { .fd=fd , .by_job=false , .rd_eof=false , .wr_eof=false , .shut=false , .events=0 , .out={} } ;
+							fd_chans[fd]    = msg.chan                                                                                   ;
+							flush_chan(msg.chan) ;                                                               // register fd
+							n_srv_chans++ ;
+							last_active = New ;
+						} break ;
+						case Proc::Data :
+							if ( it==chans.end() || it->second.wr_eof ) break ;                                  // channel is already closed, ignore
+							it->second.out += msg.data ;
+							flush_chan(msg.chan) ;
+						break ;
+						case Proc::Close :
+							if ( it==chans.end() || it->second.wr_eof ) break ;
+							if (it->second.by_job) it->second.out += '\0' ;                                      // acknowledge reception by server
+							it->second.wr_eof = true ;
+							flush_chan(msg.chan) ;
+						break ;
+						case Proc::Err : {                                                                       // server could not open channel
+							if ( it==chans.end() || !it->second.by_job ) break ;
+							Chan& c = it->second ;
+							c.out.clear() ;                                                                      // close without acknowledgment, so job connects directly
+							c.rd_eof = true ;                                                                    // server knows nothing about channel, dont tell it
+							c.wr_eof = true ;
+							flush_chan(msg.chan) ;
+						} break ;
+						default : break ;                                                                        // ignore unexpected messages
+					}
+				} break ;
+			DF}
+		}
+	}
+Done :
+	::cerr << "relayed "<<n_job_chans<<" connections from jobs and "<<n_srv_chans<<" connections to jobs" << endl ; // stderr is our log
+	return 0 ;
+}
@@ -46,6 +46,8 @@ void print_start(JobRpcReply const& jrr) {
 	//
 	::cout << "addr         : "  << hex<<jrr.addr<<dec          <<'\n' ;
 	::cout << "auto_mkdir   : "  << jrr.autodep_env.auto_mkdir  <<'\n' ;
+	::cout << "autodep_cache: "  << jrr.autodep_cache           <<'\n' ;
+	::cout << "autodep_ring : "  << jrr.autodep_ring            <<'\n' ;
 	::cout << "chroot_dir_s : "  << jrr.job_space.chroot_dir_s  <<'\n' ;
 	::cout << "cwd_s        : "  << jrr.cwd_s                   <<'\n' ;
 	::cout << "date_prec    : "  << jrr.date_prec               <<'\n' ;
@@ -65,6 +67,7 @@ void print_start(JobRpcReply const& jrr) {
 	::cout << "tmp_sz_mb    : "  << jrr.tmp_sz_mb               <<'\n' ;
 	::cout << "tmp_view_s   : "  << jrr.job_space.tmp_view_s    <<'\n' ;
 	::cout << "use_script   : "  << jrr.use_script              <<'\n' ;
+	::cout << "zygote_sz    : "  << jrr.zygote_sz               <<'\n' ;
 	//
 	::cout << "deps :\n"           ; _print_map  (jrr.deps           )                         ;
 	::cout << "env :\n"            ; _print_map  (jrr.env            )                         ;
@@ -90,6 +93,7 @@ void print_end(JobRpcReq const& jrr) {
 	::cout << "digest.stats.job   : " << st.job            <<'\n' ;
 	::cout << "digest.stats.total : " << st.total          <<'\n' ;
 	::cout << "digest.stats.mem   : " << st.mem            <<'\n' ;
+	::cout << "digest.stats.reports : " << st.n_access_reports <<'\n' ;
 	//
 	::cout << "dynamic_env :\n"         ; _print_map(jrr.dynamic_env)            ;
 	//
@@ -7,29 +7,45 @@
 
 #include "codec.hh"
 
+#include "rpc_job_relay.hh"
+
 using namespace Disk   ;
 using namespace Py     ;
 using namespace Time   ;
 using namespace Engine ;
 
+ENUM( RelayEventKind
+,	Master // listening socket
+,	Link   // connection from a relay
+,	Chan   // our end of a channel opened by a relay
+,	Kick   // data are waiting to be sent to a relay
+,	Stop
+)
+
 namespace Backends {
 
+	struct Backend::StartAttrs {                                    // result of the evaluation of rule attributes needed to start a job and reply assembled from them
+		int                      step              = 0                   ; // number of successfully evaluated attributes among cmd, start_cmd_attrs and start_rsrcs_attrs
+		::vmap_s<DepSpec>        deps_attrs        ;
+		::pair_ss/*script,call*/ cmd               ;
+		StartCmdAttrs            start_cmd_attrs   ;
+		StartRsrcsAttrs          start_rsrcs_attrs ;
+		StartNoneAttrs           start_none_attrs  ;                       // only evaluated if step==3
+		bool                     none_attrs_static = false               ; // if true <=> start_none_attrs could not be evaluated and static info is used instead
+		::pair_ss                msg_err           ;                       // error while evaluating cmd, start_cmd_attrs or start_rsrcs_attrs
+		::pair_ss                none_msg_err      ;                       // error while evaluating start_none_attrs
+		::vmap_s<DepDigest>      deps              ;                       // deps accessed during evaluation
+		JobRpcReply              reply             { JobRpcProc::Start } ; // all but what depends on target states or on job connection
+	} ;
+
 	void send_reply( Job job , JobMngtRpcReply&& jmrr ) {
 		Lock lock { Backend::_s_mutex }             ;
 		auto it   = Backend::_s_start_tab.find(job) ;
 		if (it==Backend::_s_start_tab.end()) return ;         // job is dead without waiting for reply, curious but possible
 		Backend::StartEntry const& e = it->second ;
-		try {
-			jmrr.seq_id = e.conn.seq_id ;
-			ClientSockFd fd( e.conn.host , e.conn.port , 3/*n_trials*/ ) ;
-			OMsgBuf().send( fd , jmrr ) ;
-		} catch (...) {                                       // if we cannot connect to job, assume it is dead while we processed the request
-			Backend::_s_deferred_wakeup_thread.emplace_after(
-				g_config->network_delay
-			,	Backend::DeferredEntry { e.conn.seq_id , JobExec(job,e.conn.host,e.date) }
-			) ;
-		}
-	}
+		jmrr.seq_id = e.conn.seq_id ;
+		Backend::_s_send_to_job( e.conn.host , e.conn.port , jmrr , Backend::DeferredEntry{e.conn.seq_id,JobExec(job,e.conn.host,e.date)} , 3/*n_trials*/ ) ; // if we cannot connect to job, ...
+	}                                                                                                                                                             // ... assume it is dead while we processed the request
 
 	//
 	// Backend::*
@@ -156,11 +172,26 @@ namespace Backends {
 	Backend::JobThread                   Backend::_s_job_start_thread       ;
 	Backend::JobMngtThread               Backend::_s_job_mngt_thread        ;
 	Backend::JobThread                   Backend::_s_job_end_thread         ;
+	Backend::JobEndPrepQueue             Backend::_s_job_end_prep_queue     ;
+	::vector<::jthread>                  Backend::_s_job_end_prep_threads   ; // ensure threads are after their queue so they are stopped before it is destructed
+	::atomic<size_t>                     Backend::_s_n_job_end_preps        = 0 ;
+	Backend::StartPrepQueue              Backend::_s_start_prep_queue       ;
+	::vector<::jthread>                  Backend::_s_start_prep_threads     ; // .
+	::condition_variable_any             Backend::_s_start_prep_cond        ;
+	::atomic<size_t>                     Backend::_s_n_start_preps          = 0 ;
 	SmallIds<SmallId,true/*ThreadSafe*/> Backend::_s_small_ids              ;
 	Mutex<MutexLvl::StartJob>            Backend::_s_starting_job_mutex     ;
 	::atomic<JobIdx>                     Backend::_s_starting_job           ;
 	Backend::StartTab                    Backend::_s_start_tab              ;
 	Backend::Workload                    Backend::_s_workload               ;
+	ServerSockFd                         Backend::_s_relay_fd               ;
+	AutoCloseFd                          Backend::_s_relay_kick_fd          ;
+	Mutex<MutexLvl::Relay>               Backend::_s_relay_mutex            ;
+	::umap<in_addr_t,Fd>                 Backend::_s_relay_links            ;
+	::umap<Fd,::string>                  Backend::_s_relay_outs             ;
+	::umap<Fd,Backend::RelayPeer>        Backend::_s_relay_peers            ;
+	::umap<uint32_t,Backend::RelayWakeup> Backend::_s_relay_wakeups         ;
+	uint32_t                             Backend::_s_relay_next_chan        = 0 ;
 
 	static ::vmap_s<DepDigest> _mk_digest_deps( ::vmap_s<DepSpec>&& deps_attrs ) {
 		::vmap_s<DepDigest> res ; res.reserve(deps_attrs.size()) ;
@@ -230,13 +261,257 @@ namespace Backends {
 	void Backend::_s_wakeup_remote( Job job , StartEntry::Conn const& conn , Pdate start_date , JobMngtProc proc ) {
 		Trace trace(BeChnl,"_s_wakeup_remote",job,conn,proc) ;
 		SWEAR(conn.seq_id,job,conn) ;
+		_s_send_to_job( conn.host , conn.port , JobMngtRpcReply(proc,conn.seq_id) , DeferredEntry{conn.seq_id,JobExec(job,conn.host,start_date)} ) ;
+	}
+
+	// send msg to job listening on host:port, through the relay running on host if any
+	void Backend::_s_send_to_job( in_addr_t host , in_port_t port , JobMngtRpcReply const& msg , DeferredEntry&& de , int n_trials ) {
+		{	Lock lock { _s_relay_mutex } ;
+			if ( auto it=_s_relay_links.find(host) ; it!=_s_relay_links.end() ) {
+				uint32_t chan = JobRelayMsg::ServerChan | (_s_relay_next_chan++&~JobRelayMsg::ServerChan) ;
+				Trace trace(BeChnl,"_s_send_to_job","relay",it->second,chan,msg) ;
+				::string& out = _s_relay_outs[it->second] ;                                                                     // relay thread sends data, so we never block while holding lock
+				out += OMsgBuf::s_send(JobRelayMsg{ .proc=JobRelayProc::Connect , .chan=chan , .port=port , .data={}                   }) ;
+				out += OMsgBuf::s_send(JobRelayMsg{ .proc=JobRelayProc::Data    , .chan=chan , .port=0    , .data=OMsgBuf::s_send(msg) }) ;
+				out += OMsgBuf::s_send(JobRelayMsg{ .proc=JobRelayProc::Close   , .chan=chan , .port=0    , .data={}                   }) ;
+				_s_relay_wakeups[chan] = { .link=it->second , .host=host , .port=port , .msg=msg , .deferred=::move(de) } ;      // if link is broken, relay thread resends directly
+				static constexpr uint64_t One = 1 ;
+				ssize_t cnt = ::write(_s_relay_kick_fd,&One,sizeof(One)) ;
+				SWEAR( cnt==sizeof(One) , cnt , _s_relay_kick_fd ) ;
+				return ;
+			}
+		}
+		_s_direct_send_to_job( host , port , msg , ::move(de) , n_trials ) ;
+	}
+
+	void Backend::_s_direct_send_to_job( in_addr_t host , in_port_t port , JobMngtRpcReply const& msg , DeferredEntry&& de , int n_trials ) {
+		Trace trace(BeChnl,"_s_direct_send_to_job",SockFd::s_addr_str(host),port,msg) ;
 		try {
-			ClientSockFd fd(conn.host,conn.port) ;
-			OMsgBuf().send( fd , JobMngtRpcReply(proc,conn.seq_id) ) ;
+			ClientSockFd fd(host,port,n_trials) ;
+			OMsgBuf().send( fd , msg ) ;
 		} catch (::string const& e) {
-			trace("no_job",job,e) ;
+			trace("no_job",e) ;
 			// if job cannot be connected to, assume it is dead and pretend it died if it still exists after network delay
-			_s_deferred_wakeup_thread.emplace_after( g_config->network_delay , DeferredEntry{conn.seq_id,JobExec(job,conn.host,start_date)} ) ;
+			_s_deferred_wakeup_thread.emplace_after( g_config->network_delay , ::move(de) ) ;
+		}
+	}
+
+	// jobs connected through a relay are seen through a unix socket whose peer is not the job host
+	// return nothing if relay channel has already been closed, e.g. because link to relay was lost
+	::optional<in_addr_t> Backend::_s_peer_addr(SlaveSockFd const& fd) {
+		int       domain = 0              ;
+		socklen_t len    = sizeof(domain) ;
+		if ( ::getsockopt(fd,SOL_SOCKET,SO_DOMAIN,&domain,&len)!=0 || domain!=AF_UNIX ) return fd.peer_addr() ;
+		Lock lock { _s_relay_mutex }        ;
+		auto it   = _s_relay_peers.find(fd) ; if (it==_s_relay_peers.end()) return {} ;
+		in_addr_t res = it->second.host ;
+		_s_relay_peers.erase(it) ;
+		return res ;
+	}
+
+	struct RelayChan {
+		Fd       fd      ;         // our end of a socket pair, the other end is handled by the job thread corresponding to the channel
+		Fd       peer_fd ;         // other end of socket pair if channel is a job start connection, to forget its peer when channel is closed
+		bool     rd_eof  = false ; // if true <=> we have told relay there will be no more data from fd
+		bool     wr_eof  = false ; // if true <=> relay has told us there will be no more data to write to fd
+		bool     shut    = false ; // if true <=> fd has been shut down for writing, which occurs once out is empty after wr_eof
+		uint32_t events  = 0     ; // current epoll registration of fd
+		::string out     ;         // data waiting to be written to fd
+	} ;
+
+	struct RelayLink {
+		in_addr_t                  host   = NoSockAddr ;
+		IMsgBuf                    buf    ;
+		uint32_t                   events = 0          ; // current epoll registration of link
+		::umap<uint32_t,RelayChan> chans  ;              // channels opened by relay on behalf of jobs
+	} ;
+
+	// relays carry job connections over a single link per host (cf. job_relay.cc)
+	// each channel opened by a relay is mapped to a socket pair whose other end is adopted by the corresponding job thread, so these need not know about relays
+	// channels opened by server are only used to send a single message to a job, cf. _s_send_to_job
+	// we never block on writes as relay may itself be blocked sending to us, and job threads may be blocked sending to us while we would write to them
+	void Backend::_s_relay_thread_func(::stop_token stop) {
+		static constexpr uint64_t One = 1 ;
+		t_thread_key = 'Y' ;
+		AutoCloseFd     stop_fd = ::eventfd(0,O_CLOEXEC) ; stop_fd.no_std() ;
+		Epoll           epoll   { New }                  ;
+		::stop_callback stop_cb {                                                                                                                 // transform request_stop into an event Epoll can wait for
+			stop
+		,	[&](){
+				ssize_t cnt = ::write(stop_fd,&One,sizeof(One)) ;
+				SWEAR( cnt==sizeof(One) , cnt , stop_fd ) ;
+			}
+		} ;
+		::umap<Fd,RelayLink>           links    ;
+		::umap<Fd,::pair<Fd,uint32_t>> chan_fds ;                                                                                                 // our end of channel -> link,chan
+		Trace trace(BeChnl,"_s_relay_thread_func",_s_relay_fd,_s_relay_fd.port()) ;
+		//
+		auto flush_link = [&](Fd link_fd)->void {                                                                                                 // if link is broken, we will see it when reading it
+			RelayLink& link    = links.at(link_fd) ;
+			bool       pending = false             ;
+			{	Lock lock { _s_relay_mutex } ;
+				auto it = _s_relay_outs.find(link_fd) ;
+				if (it!=_s_relay_outs.end()) {
+					SockFd::s_send_some(link_fd,it->second) ;
+					pending = +it->second ;
+				}
+			}
+			epoll.mod( link_fd , RelayEventKind::Link , link.events , uint32_t(EPOLLIN)|(pending?uint32_t(EPOLLOUT):0u) ) ;
+		} ;
+		auto send = [&]( Fd link_fd , JobRelayMsg const& msg )->void {
+			{	Lock lock { _s_relay_mutex } ;
+				_s_relay_outs[link_fd] += OMsgBuf::s_send(msg) ;
+			}
+			flush_link(link_fd) ;
+		} ;
+		auto forget_peer = [&]( Fd link_fd , uint32_t id , RelayChan const& c )->void {                                                         // job start thread may not have asked for peer, e.g. if job died early
+			if (!c.peer_fd) return ;
+			Lock lock { _s_relay_mutex }                ;
+			auto it   = _s_relay_peers.find(c.peer_fd) ;
+			if ( it!=_s_relay_peers.end() && it->second.link==link_fd && it->second.chan==id ) _s_relay_peers.erase(it) ;                      // peer_fd may have been reused for another channel
+		} ;
+		auto flush_chan = [&]( RelayLink& link , uint32_t id )->void {                                                                           // write what can be, shut down when done, update epoll and close when all is over
+			RelayChan& c = link.chans.at(id) ;
+			if ( +c.out && !SockFd::s_send_some(c.fd,c.out) ) c.wr_eof = true ;                                                                    // job thread is done with this channel, ignore further data
+			if ( c.wr_eof && !c.out && !c.shut              ) { ::shutdown(c.fd,SHUT_WR) ; c.shut = true ; }
+			epoll.mod( c.fd , RelayEventKind::Chan , c.events , (c.rd_eof?0u:uint32_t(EPOLLIN))|(+c.out?uint32_t(EPOLLOUT):0u) ) ;
+			if ( !c.rd_eof || !c.shut ) return ;
+			forget_peer( chan_fds.at(c.fd).first , id , c ) ;
+			chan_fds.erase(c.fd) ;
+			::close(c.fd) ;
+			link.chans.erase(id) ;
+		} ;
+		auto close_link = [&](Fd link_fd)->void {
+			RelayLink&            link = links.at(link_fd) ;
+			::vector<RelayWakeup> lost ;
+			trace("close_link",link_fd,SockFd::s_addr_str(link.host),mk_key_vector(link.chans)) ;
+			for( auto& [id,c] : link.chans ) {                                                                                                    // job threads see incomplete messages, as if jobs had disappeared
+				epoll.mod( c.fd , RelayEventKind::Chan , c.events , 0 ) ;
+				forget_peer( link_fd , id , c ) ;
+				chan_fds.erase(c.fd) ;
+				::close(c.fd) ;
+			}
+			{	Lock lock { _s_relay_mutex } ;
+				if ( auto it=_s_relay_links.find(link.host) ; it!=_s_relay_links.end() && it->second==link_fd ) _s_relay_links.erase(it) ;
+				_s_relay_outs.erase(link_fd) ;
+				for( auto it=_s_relay_wakeups.begin() ; it!=_s_relay_wakeups.end() ;)
+					if (it->second.link==link_fd) { lost.push_back(::move(it->second)) ; it = _s_relay_wakeups.erase(it) ; }
+					else                            it++ ;
+			}
+			epoll.mod( link_fd , RelayEventKind::Link , link.events , 0 ) ;
+			::close(link_fd) ;
+			links.erase(link_fd) ;
+			for( RelayWakeup& w : lost ) _s_direct_send_to_job( w.host , w.port , w.msg , ::move(w.deferred) ) ;                                  // we dont know if message was delivered, resend directly
+		} ;
+		//
+		epoll.add_read(_s_relay_fd     ,RelayEventKind::Master) ;
+		epoll.add_read(_s_relay_kick_fd,RelayEventKind::Kick  ) ;
+		epoll.add_read(stop_fd         ,RelayEventKind::Stop  ) ;
+		for(;;) {
+			::vector<Epoll::Event> events = epoll.wait() ;
+			for( Epoll::Event const& event : events ) {
+				RelayEventKind kind = event.data<RelayEventKind>() ;
+				Fd             efd  = event.fd()                   ;
+				switch (kind) {
+					case RelayEventKind::Master : {
+						SlaveSockFd fd ;
+						try                       { fd = _s_relay_fd.accept() ;              }
+						catch (::string const& e) { trace("cannot_accept",e) ; continue ;   }                                                          // ignore error as this may be fd starvation and relay will exit
+						in_addr_t host    = fd.peer_addr() ;
+						Fd        link_fd = fd.detach()    ;
+						trace("new_link",link_fd,SockFd::s_addr_str(host)) ;
+						links[link_fd].host = host ;
+						{	Lock lock { _s_relay_mutex } ;
+							_s_relay_links[host] = link_fd ;                                                                                          // if several links from the same host, the last one is used
+						}
+						flush_link(link_fd) ;                                                                                                       // register link
+					} break ;
+					case RelayEventKind::Kick : {
+						uint64_t cnt ;
+						if (::read(efd,&cnt,sizeof(cnt))!=sizeof(cnt)) FAIL(efd) ;
+						for( auto const& [link_fd,_] : links ) flush_link(link_fd) ;
+					} break ;
+					case RelayEventKind::Link : {
+						auto lit = links.find(efd) ; if (lit==links.end()) continue ;                                                              // link has been closed while processing previous events
+						RelayLink& link = lit->second ;
+						if (event.events&EPOLLOUT) flush_link(efd) ;
+						if (!(event.events&~uint32_t(EPOLLOUT))) continue ;
+						JobRelayMsg msg ;
+						try                       { if (!link.buf.receive_step(efd,msg)) continue ;   }
+						catch (::string const& e) { trace("link_lost",efd,e) ; close_link(efd) ; continue ; }
+						switch (msg.proc) {
+							case JobRelayProc::Start :
+							case JobRelayProc::Mngt  :
+							case JobRelayProc::End   : {
+								int fds[2] ;
+								if (::socketpair( AF_UNIX , SOCK_STREAM|SOCK_CLOEXEC , 0 , fds )!=0) {
+									trace("no_socketpair",msg) ;
+									send( efd , {.proc=JobRelayProc::Err,.chan=msg.chan,.port=0,.data={}} ) ;                                                       // tell relay to close job connection, job will connect directly
+									break ;
+								}
+								link.chans[msg.chan].fd = fds[0]             ;
+								chan_fds[fds[0]]        = { efd , msg.chan } ;
+								flush_chan(link,msg.chan) ;                                                                                        // register fds[0]
+								trace("new_chan",efd,msg.chan,msg.proc,fds[0],fds[1]) ;
+								switch (msg.proc) {
+									case JobRelayProc::Start : {
+										link.chans[msg.chan].peer_fd = fds[1] ;
+										{	Lock lock { _s_relay_mutex } ;
+											_s_relay_peers[fds[1]] = { .host=link.host , .link=efd , .chan=msg.chan } ;
+										}
+										_s_job_start_thread.adopt(fds[1]) ;
+									} break ;
+									case JobRelayProc::Mngt : _s_job_mngt_thread.adopt(fds[1]) ; break ;
+									case JobRelayProc::End  : _s_job_end_thread .adopt(fds[1]) ; break ;
+								DF}
+							} break ;
+							case JobRelayProc::Data : {
+								auto it = link.chans.find(msg.chan) ;
+								if ( it==link.chans.end() || it->second.wr_eof ) break ;                                                           // job thread is done with this channel, ignore
+								it->second.out += msg.data ;
+								flush_chan(link,msg.chan) ;
+							} break ;
+							case JobRelayProc::Close :
+								if (msg.chan&JobRelayMsg::ServerChan) {                                                                            // job has closed connection, message has been delivered
+									Lock lock { _s_relay_mutex } ;
+									_s_relay_wakeups.erase(msg.chan) ;
+								} else if ( auto it=link.chans.find(msg.chan) ; it!=link.chans.end() && !it->second.wr_eof ) {
+									it->second.wr_eof = true ;
+									flush_chan(link,msg.chan) ;
+								}
+							break ;
+							case JobRelayProc::Err : {                                                                                             // relay could not connect to job
+								RelayWakeup w ;
+								{	Lock lock { _s_relay_mutex } ;
+									auto it = _s_relay_wakeups.find(msg.chan) ;
+									if (it==_s_relay_wakeups.end()) break ;
+									w = ::move(it->second) ;
+									_s_relay_wakeups.erase(it) ;
+								}
+								trace("relay_err",msg.chan,w.msg) ;
+								_s_direct_send_to_job( w.host , w.port , w.msg , ::move(w.deferred) ) ;
+							} break ;
+							default : trace("bad_relay_msg",msg) ;
+						}
+					} break ;
+					case RelayEventKind::Chan : {
+						auto cit = chan_fds.find(efd) ; if (cit==chan_fds.end()) continue ;                                                        // channel has been closed while processing previous events
+						auto [link_fd,id] = cit->second        ;
+						RelayLink& link   = links.at(link_fd)  ;
+						RelayChan& c      = link.chans.at(id)  ;
+						if ( !c.rd_eof && (event.events&~uint32_t(EPOLLOUT)) ) {                                                                 // readable, or error/hang up
+							char    buf[1<<16]                  ;
+							ssize_t cnt = ::read(efd,buf,sizeof(buf)) ;
+							if (cnt>0) {                   send( link_fd , {.proc=JobRelayProc::Data ,.chan=id,.port=0,.data=::string(buf,cnt)} ) ; }
+							else       { c.rd_eof = true ; send( link_fd , {.proc=JobRelayProc::Close,.chan=id,.port=0,.data={}               } ) ; } // job thread has closed its end
+						}
+						flush_chan(link,id) ;
+					} break ;
+					case RelayEventKind::Stop :
+						trace("stop") ;
+						return ;
+				DF}
+			}
 		}
 	}
 
@@ -256,21 +531,17 @@ namespace Backends {
 		JobExec                  job_exec            ;
 		Rule                     rule                = job->rule           ;
 		Rule::SimpleMatch        match               = job->simple_match() ;
-		JobRpcReply              reply               { Proc::Start }       ;
 		vmap<Node,FileAction>    pre_actions         ;
 		vmap<Node,FileActionTag> pre_action_warnings ;
-		StartCmdAttrs            start_cmd_attrs     ;
-		::pair_ss/*script,call*/ cmd                 ;
-		::vmap_s<DepSpec>        deps_attrs          ;
-		StartRsrcsAttrs          start_rsrcs_attrs   ;
-		StartNoneAttrs           start_none_attrs    ;
-		::pair_ss                start_msg_err       ;
+		StartAttrs               attrs               ;
+		bool                     precomputed         = false               ;
 		SubmitAttrs              submit_attrs        ;
 		::vmap_ss                rsrcs               ;
 		Pdate                    eta                 ;
 		bool                     keep_tmp            = false/*garbage*/    ;
 		::vector<ReqIdx>         reqs                ;
 		Trace trace(BeChnl,"_s_handle_job_start",jrr) ;
+		::optional<in_addr_t> peer_addr = _s_peer_addr(fd) ; if (!peer_addr) { trace("lost_relay") ; return false ; } // as if connection was lost
 		_s_starting_job = jrr.job ;
 		Lock lock { _s_starting_job_mutex } ;
 		// to lock for minimal time, we lock twice
@@ -278,116 +549,59 @@ namespace Backends {
 		// because the only thing that can happend between the 2 locks is that entry disappears, we can move info from entry during 1st lock
 		{	Lock lock { _s_mutex } ;                             // prevent sub-backend from manipulating _s_start_tab from main thread, lock for minimal time
 			//
-			auto        it    = _s_start_tab.find(+job,jrr.seq_id) ; if (it==_s_start_tab.end()) { trace("not_in_tab") ; return false ; }
-			StartEntry& entry = it->second                         ;
+			auto it = _s_start_tab.find(+job,jrr.seq_id) ; if (it==_s_start_tab.end()) { trace("not_in_tab") ; return false ; }
+			if (it->second.start_prep.state==StartPrepState::Running) {                                                      // waiting is faster than evaluating again
+				trace("wait_start_prep") ;
+				_s_start_prep_cond.wait( lock , [&]() {
+					it = _s_start_tab.find(+job,jrr.seq_id) ;
+					return it==_s_start_tab.end() || it->second.start_prep.state!=StartPrepState::Running ;
+				} ) ;
+				if (it==_s_start_tab.end()) { trace("not_in_tab") ; return false ; }
+			}
+			StartEntry& entry = it->second ;
 			trace("entry1",entry) ;
 			submit_attrs      = ::move(entry.submit_attrs) ;
 			rsrcs             =        entry.rsrcs         ;
 			reqs              =        entry.reqs          ;
 			tie(eta,keep_tmp) = entry.req_info()           ;
+			if (entry.start_prep.state==StartPrepState::Done) { attrs = ::move(*entry.start_attrs) ; entry.start_attrs = {} ; precomputed = true ; }
+			entry.start_prep.set(StartPrepState::None) ;                                                                      // if still queued, preparation is now useless
 		}
-		trace("submit_attrs",submit_attrs) ;
-		::vmap_s<DepDigest>& deps          = submit_attrs.deps ;
-		size_t               n_submit_deps = deps.size()       ;
-		int                  step          = 0                 ;
-		deps_attrs = rule->deps_attrs.eval(match) ;              // this cannot fail as it was already run to construct job
-		try {
+		trace("submit_attrs",submit_attrs,STR(precomputed)) ;
+		if (!precomputed) attrs = _s_prep_start( job , match , rsrcs , submit_attrs ) ;
+		::vmap_s<DepDigest>& deps             = submit_attrs.deps      ;
+		size_t               n_submit_deps    = deps.size()            ;
+		int&                 step             = attrs.step             ;
+		JobRpcReply&         reply            = attrs.reply            ;
+		StartNoneAttrs&      start_none_attrs = attrs.start_none_attrs ;
+		::pair_ss&           start_msg_err    = attrs.msg_err          ;
+		for( auto& d_dd : attrs.deps ) deps.push_back(::move(d_dd)) ;
+		if (step==3) {
 			try {
-				cmd               = rule->cmd              .eval(match,rsrcs,&deps) ; step = 1 ;
-				start_cmd_attrs   = rule->start_cmd_attrs  .eval(match,rsrcs,&deps) ; step = 2 ;
-				start_rsrcs_attrs = rule->start_rsrcs_attrs.eval(match,rsrcs,&deps) ; step = 3 ;
-				//
 				pre_actions = job->pre_actions( match , true/*mark_target_dirs*/ ) ; step = 4 ;
 				for( auto const& [t,a] : pre_actions )
 					switch (a.tag) {
 						case FileActionTag::UnlinkWarning  :
 						case FileActionTag::UnlinkPolluted : pre_action_warnings.emplace_back(t,a.tag) ; ; break ;
 					DN}
-			} catch (::string const& e) { throw ::pair_ss(e,{}) ; }
-		} catch (::pair_ss const& e) {
-			start_msg_err.first  <<set_nl<< e.first  ;
-			start_msg_err.second <<set_nl<< e.second ;
-			switch (step) {
-				case 0 : start_msg_err.first <<set_nl<< rule->cmd              .s_exc_msg(false/*using_static*/) ; break ;
-				case 1 : start_msg_err.first <<set_nl<< rule->start_cmd_attrs  .s_exc_msg(false/*using_static*/) ; break ;
-				case 2 : start_msg_err.first <<set_nl<< rule->start_rsrcs_attrs.s_exc_msg(false/*using_static*/) ; break ;
-				case 3 : start_msg_err.first <<set_nl<< "cannot wash targets"                                    ; break ;
-			DF}
+			} catch (::string const& e) {
+				start_msg_err.first <<set_nl<< e <<set_nl<< "cannot wash targets" ;
+			}
 		}
-		trace("deps",step,deps) ;
-		// record as much info as possible in reply
-		::uset_s env_keys ;
-		switch (step) {
-			case 4 :
-				// do not generate error if *_none_attrs is not available, as we will not restart job when fixed : do our best by using static info
-				try {
-					try                       { start_none_attrs = rule->start_none_attrs.eval(match,rsrcs,&deps) ; }
-					catch (::string const& e) { throw ::pair_ss(e,{}) ;                                             }
-				} catch (::pair_ss const& e) {
-					start_msg_err    = e                           ;
-					start_none_attrs = rule->start_none_attrs.spec ;
-					jrr.msg <<set_nl<< rule->start_none_attrs.s_exc_msg(true/*using_static*/) ;
-				}
-				keep_tmp |= start_none_attrs.keep_tmp ;
-				//
-				for( auto [t,a] : pre_actions ) reply.pre_actions.emplace_back(t->name(),a) ;
-			[[fallthrough]] ;
-			case 3 :
-				reply.method  = start_rsrcs_attrs.method  ;
-				reply.timeout = start_rsrcs_attrs.timeout ;
-				//
-				for( ::pair_ss& kv : start_rsrcs_attrs.env ) { env_keys.insert(kv.first) ; reply.env.push_back(::move(kv)) ; }
-			[[fallthrough]] ;
-			case 2 :
-				reply.interpreter             = ::move(start_cmd_attrs.interpreter) ;
-				reply.autodep_env.auto_mkdir  =        start_cmd_attrs.auto_mkdir   ;
-				reply.autodep_env.ignore_stat =        start_cmd_attrs.ignore_stat  ;
-				reply.job_space               = ::move(start_cmd_attrs.job_space  ) ;
-				reply.use_script              =        start_cmd_attrs.use_script   ;
-				//
-				for( ::pair_ss& kv : start_cmd_attrs.env )
-					if (env_keys.insert(kv.first).second) {
-						reply.env.push_back(::move(kv)) ;
-					} else if (step==5) {
-						step = 4 ;
-						start_msg_err.first <<set_nl<< "env variable "<<kv.first<<" is defined both in environ_cmd and environ_resources" ;
-					}
-			[[fallthrough]] ;
-			case 1 :
-				reply.cmd = ::move(cmd) ;
-			[[fallthrough]] ;
-			case 0 : {
-				VarIdx ti = 0 ;
-				for( ::string const& tn : match.static_matches() ) reply.static_matches.emplace_back( tn , rule->matches[ti++].second.flags ) ;
-				for( ::string const& p  : match.star_patterns () ) reply.star_matches  .emplace_back( p  , rule->matches[ti++].second.flags ) ;
-				//
-				if (rule->stdin_idx !=Rule::NoVar) reply.stdin                     = deps_attrs          [rule->stdin_idx ].second.txt ;
-				if (rule->stdout_idx!=Rule::NoVar) reply.stdout                    = reply.static_matches[rule->stdout_idx].first      ;
-				/**/                               reply.addr                      = fd.peer_addr()                                    ;
-				/**/                               reply.autodep_env.lnk_support   = g_config->lnk_support                             ;
-				/**/                               reply.autodep_env.reliable_dirs = g_config->reliable_dirs                           ;
-				/**/                               reply.autodep_env.src_dirs_s    = *g_src_dirs_s                                     ;
-				/**/                               reply.cwd_s                     = rule->cwd_s                                       ;
-				/**/                               reply.date_prec                 = g_config->date_prec                               ;
-				/**/                               reply.keep_tmp                  = keep_tmp                                          ;
-				/**/                               reply.key                       = g_config->key                                     ;
-				/**/                               reply.kill_sigs                 = ::move(start_none_attrs.kill_sigs)                ;
-				/**/                               reply.live_out                  = submit_attrs.live_out                             ;
-				/**/                               reply.network_delay             = g_config->network_delay                           ;
-				//
-				for( ::pair_ss& kv : start_none_attrs.env ) if (env_keys.insert(kv.first).second) reply.env.push_back(::move(kv)) ; // in case of key conflict, ignore environ_ancillary
-				//
-				for( auto const& [k,v] : rsrcs ) if (k=="tmp") { reply.tmp_sz_mb = from_string_with_units<'M'>(v) ; break ; }
-			} break ;
-		DF}
-		//
-		reply.deps = _mk_digest_deps(::move(deps_attrs)) ;
-		if (+deps) {
-			::umap_s<VarIdx> dep_idxes ; for( VarIdx i=0 ; i<reply.deps.size() ; i++ ) dep_idxes[reply.deps[i].first] = i ;
-			for( auto const& [dn,dd] : deps )
-				if ( auto it=dep_idxes.find(dn) ; it!=dep_idxes.end() )                                       reply.deps[it->second].second |= dd ;   // update existing dep
-				else                                                    { dep_idxes[dn] = reply.deps.size() ; reply.deps.emplace_back(dn,dd) ;      } // create new dep
+		trace("deps",step,deps,"eval_cache",size_t(DynamicEvalCacheBase::s_n_hits),size_t(DynamicEvalCacheBase::s_n_misses)) ;
+		// complete reply with what depends on target states and on job connection
+		if (step==4) {
+			if (attrs.none_attrs_static) {
+				start_msg_err = ::move(attrs.none_msg_err) ;
+				jrr.msg <<set_nl<< rule->start_none_attrs.s_exc_msg(true/*using_static*/) ;
+			}
+			keep_tmp |= start_none_attrs.keep_tmp ;
+			//
+			for( auto [t,a] : pre_actions ) reply.pre_actions.emplace_back(t->name(),a) ;
 		}
+		reply.addr     = *peer_addr ;
+		reply.keep_tmp = keep_tmp   ;
+		//
 		bool deps_done = false ;                             // true if all deps are done for at least a non-zombie req
 		for( Req r : reqs ) if (!r.zombie()) {
 			for( auto const& [dn,dd] : ::vector_view(deps.data()+n_submit_deps,deps.size()-n_submit_deps) )
@@ -479,6 +693,147 @@ namespace Backends {
 		return false/*keep_fd*/ ;
 	}
 
+	// evaluate rule attributes needed to start job, this is where Python code may be run when job starts
+	// this only depends on info known when job is launched, so it can be done before job connects (cf. _s_start_prep_func)
+	Backend::StartAttrs Backend::_s_eval_start_attrs( Job job , Rule::SimpleMatch const& match , ::vmap_ss const& rsrcs ) {
+		Rule       rule = job->rule ;
+		StartAttrs res  ;
+		res.deps_attrs = rule->deps_attrs.eval(match) ;                                                   // this cannot fail as it was already run to construct job
+		try {
+			try {
+				res.cmd               = rule->cmd              .eval(match,rsrcs,&res.deps) ; res.step = 1 ;
+				res.start_cmd_attrs   = rule->start_cmd_attrs  .eval(match,rsrcs,&res.deps) ; res.step = 2 ;
+				res.start_rsrcs_attrs = rule->start_rsrcs_attrs.eval(match,rsrcs,&res.deps) ; res.step = 3 ;
+			} catch (::string const& e) { throw ::pair_ss(e,{}) ; }
+		} catch (::pair_ss const& e) {
+			res.msg_err.first  <<set_nl<< e.first  ;
+			res.msg_err.second <<set_nl<< e.second ;
+			switch (res.step) {
+				case 0 : res.msg_err.first <<set_nl<< rule->cmd              .s_exc_msg(false/*using_static*/) ; break ;
+				case 1 : res.msg_err.first <<set_nl<< rule->start_cmd_attrs  .s_exc_msg(false/*using_static*/) ; break ;
+				case 2 : res.msg_err.first <<set_nl<< rule->start_rsrcs_attrs.s_exc_msg(false/*using_static*/) ; break ;
+			DF}
+			return res ;
+		}
+		// do not generate error if *_none_attrs is not available, as we will not restart job when fixed : do our best by using static info
+		try {
+			try                       { res.start_none_attrs = rule->start_none_attrs.eval(match,rsrcs,&res.deps) ; }
+			catch (::string const& e) { throw ::pair_ss(e,{}) ;                                                     }
+		} catch (::pair_ss const& e) {
+			res.none_msg_err      = e                           ;
+			res.start_none_attrs  = rule->start_none_attrs.spec ;
+			res.none_attrs_static = true                        ;
+		}
+		return res ;
+	}
+
+	// evaluate start attributes and assemble reply, except what depends on target states or on job connection
+	Backend::StartAttrs Backend::_s_prep_start( Job job , Rule::SimpleMatch const& match , ::vmap_ss const& rsrcs , SubmitAttrs const& submit_attrs ) {
+		Rule             rule              = job->rule                                  ;
+		StartAttrs       res               = _s_eval_start_attrs( job , match , rsrcs ) ;
+		int&             step              = res.step                                   ;
+		JobRpcReply&     reply             = res.reply                                  ;
+		StartCmdAttrs&   start_cmd_attrs   = res.start_cmd_attrs                        ;
+		StartRsrcsAttrs& start_rsrcs_attrs = res.start_rsrcs_attrs                      ;
+		StartNoneAttrs&  start_none_attrs  = res.start_none_attrs                       ;
+		::uset_s         env_keys          ;
+		switch (step) {
+			case 3 :
+				reply.method  = start_rsrcs_attrs.method  ;
+				reply.timeout = start_rsrcs_attrs.timeout ;
+				//
+				for( ::pair_ss& kv : start_rsrcs_attrs.env ) { env_keys.insert(kv.first) ; reply.env.push_back(::move(kv)) ; }
+			[[fallthrough]] ;
+			case 2 :
+				reply.interpreter             = ::move(start_cmd_attrs.interpreter) ;
+				reply.autodep_env.auto_mkdir  =        start_cmd_attrs.auto_mkdir   ;
+				reply.autodep_env.ignore_stat =        start_cmd_attrs.ignore_stat  ;
+				reply.job_space               = ::move(start_cmd_attrs.job_space  ) ;
+				reply.use_script              =        start_cmd_attrs.use_script   ;
+				if ( start_cmd_attrs.use_zygote && rule->is_python && submit_attrs.tag==BackendTag::Local )                                   // forked jobs live in the zygote cgroup/allocation ...
+					reply.zygote_sz = rule->cmd.append_dbg_info(rule->cmd.spec.cmd).size() ;                                                  // ... which only local jobs share, static part of cmd, cf DynamicCmd::eval
+				//
+				for( ::pair_ss& kv : start_cmd_attrs.env )
+					if (env_keys.insert(kv.first).second) {
+						reply.env.push_back(::move(kv)) ;
+					} else if (step==5) {
+						step = 4 ;
+						res.msg_err.first <<set_nl<< "env variable "<<kv.first<<" is defined both in environ_cmd and environ_resources" ;
+					}
+			[[fallthrough]] ;
+			case 1 :
+				reply.cmd = ::move(res.cmd) ;
+			[[fallthrough]] ;
+			case 0 : {
+				VarIdx ti = 0 ;
+				for( ::string const& tn : match.static_matches() ) reply.static_matches.emplace_back( tn , rule->matches[ti++].second.flags ) ;
+				for( ::string const& p  : match.star_patterns () ) reply.star_matches  .emplace_back( p  , rule->matches[ti++].second.flags ) ;
+				//
+				if (rule->stdin_idx !=Rule::NoVar) reply.stdin                     = res.deps_attrs      [rule->stdin_idx ].second.txt ;
+				if (rule->stdout_idx!=Rule::NoVar) reply.stdout                    = reply.static_matches[rule->stdout_idx].first      ;
+				/**/                               reply.autodep_env.lnk_support   = g_config->lnk_support                             ;
+				/**/                               reply.autodep_env.reliable_dirs = g_config->reliable_dirs                           ;
+				/**/                               reply.autodep_env.src_dirs_s    = *g_src_dirs_s                                     ;
+				/**/                               reply.autodep_cache             = start_none_attrs.autodep_cache                    ;
+				/**/                               reply.autodep_ring              = start_none_attrs.autodep_ring                     ;
+				/**/                               reply.cwd_s                     = rule->cwd_s                                       ;
+				/**/                               reply.date_prec                 = g_config->date_prec                               ;
+				/**/                               reply.key                       = g_config->key                                     ;
+				/**/                               reply.kill_sigs                 = ::move(start_none_attrs.kill_sigs)                ;
+				/**/                               reply.live_out                  = submit_attrs.live_out                             ;
+				/**/                               reply.network_delay             = g_config->network_delay                           ;
+				//
+				for( ::pair_ss& kv : start_none_attrs.env ) if (env_keys.insert(kv.first).second) reply.env.push_back(::move(kv)) ; // in case of key conflict, ignore environ_ancillary
+				//
+				for( auto const& [k,v] : rsrcs ) if (k=="tmp") { reply.tmp_sz_mb = from_string_with_units<'M'>(v) ; break ; }
+			} break ;
+		DF}
+		//
+		reply.deps = _mk_digest_deps(::move(res.deps_attrs)) ;
+		::umap_s<VarIdx> dep_idxes ; for( VarIdx i=0 ; i<reply.deps.size() ; i++ ) dep_idxes[reply.deps[i].first] = i ;
+		auto add_deps = [&]( ::vmap_s<DepDigest> const& deps ) {
+			for( auto const& [dn,dd] : deps )
+				if ( auto it=dep_idxes.find(dn) ; it!=dep_idxes.end() )                                       reply.deps[it->second].second |= dd ;   // update existing dep
+				else                                                    { dep_idxes[dn] = reply.deps.size() ; reply.deps.emplace_back(dn,dd) ;      } // create new dep
+		} ;
+		add_deps(submit_attrs.deps) ;
+		add_deps(res.deps         ) ;
+		return res ;
+	}
+
+	// prepare start of launched jobs while they are on their way, so that job start only has to wash targets and send reply
+	void Backend::_s_start_prep_func( ::stop_token stop , size_t id ) {
+		t_thread_key = 'A' ;
+		Trace trace(BeChnl,"_s_start_prep_func",id) ;
+		for(;;) {
+			auto [popped,entry] = _s_start_prep_queue.pop(stop) ;
+			if (!popped) break ;
+			auto [job,seq_id] = entry ;
+			::vmap_ss   rsrcs        ;
+			SubmitAttrs submit_attrs ;
+			{	Lock lock { _s_mutex } ;
+				auto it = _s_start_tab.find(+job,seq_id) ;
+				if ( it==_s_start_tab.end() || it->second.start_prep.state!=StartPrepState::Queued ) { trace("useless",job,seq_id) ; continue ; } // job is gone or has already connected
+				it->second.start_prep.set(StartPrepState::Running) ;
+				rsrcs        = it->second.rsrcs        ;
+				submit_attrs = it->second.submit_attrs ;
+			}
+			StartAttrs attrs = _s_prep_start( job , job->simple_match() , rsrcs , submit_attrs ) ;
+			{	Lock lock { _s_mutex } ;
+				auto it = _s_start_tab.find(+job,seq_id) ;
+				if (it==_s_start_tab.end()) {
+					trace("lost",job,seq_id) ;
+				} else {
+					it->second.start_attrs = ::make_unique<StartAttrs>(::move(attrs)) ;
+					it->second.start_prep.set(StartPrepState::Done) ;
+					trace("prepared",job,seq_id) ;
+				}
+			}
+			_s_start_prep_cond.notify_all() ;                                                                                                   // job start may be waiting for us
+		}
+		trace("done") ;
+	}
+
 	bool/*keep_fd*/ Backend::_s_handle_job_mngt( JobMngtRpcReq&& jmrr , SlaveSockFd const& fd ) {
 		switch (jmrr.proc) {
 			case JobMngtProc::None       : return false/*keep_fd*/ ;      // if connection is lost, ignore it
@@ -550,12 +905,28 @@ namespace Backends {
 		}
 		trace("info") ;
 		job->end_exec() ;
-		//vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
-		g_engine_queue.emplace( Proc::End , ::move(je) , ::move(jrr) , ::move(rsrcs) ) ; // /!\ _s_starting_job ensures Start has been queued before we enqueue End
-		//^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
+		_s_n_job_end_preps++ ;                                                          // before enqueuing so engine cannot miss it
+		_s_job_end_prep_queue.emplace( ::move(je) , ::move(jrr) , ::move(rsrcs) ) ;     // /!\ _s_starting_job ensures Start has been queued before we enqueue End
 		return false/*keep_fd*/ ;
 	}
 
+	// do on a pool of threads what can be done without the engine so as to offload the engine thread, which is the bottleneck when jobs end at a high rate
+	void Backend::_s_job_end_prep_func( ::stop_token stop , size_t id ) {
+		t_thread_key = 'D' ;
+		Trace trace(BeChnl,"_s_job_end_prep_func",id) ;
+		for(;;) {
+			auto [popped,entry] = _s_job_end_prep_queue.pop(stop) ;
+			if (!popped) break ;
+			auto& [je,jrr,rsrcs] = entry ;
+			JobEndPrep prep { je , jrr.digest , rsrcs } ;
+			//vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+			g_engine_queue.emplace( Proc::End , ::move(je) , ::move(jrr) , ::move(rsrcs) , ::move(prep) ) ;
+			//^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
+			_s_n_job_end_preps-- ;                                                        // after enqueuing so engine cannot miss it
+		}
+		trace("done") ;
+	}
+
 	// kill all if ri==0
 	void Backend::_s_kill_req(Req r) {
 		Trace trace(BeChnl,"s_kill_req",r) ;
@@ -619,6 +990,7 @@ namespace Backends {
 		::vmap_ss                rsrcs        ;
 		SubmitAttrs              submit_attrs ;
 		Pdate                    start_date   ;
+		bool                     probed       = false/*garbage*/ ;
 		for( Job job ;; job=Job(+job+1) ) {
 			if (stop.stop_requested()) break ;                                                                        // exit even if sleep_until does not wait
 			{	Lock lock { _s_mutex }                    ;                                                           // lock _s_start_tab for minimal time
@@ -631,8 +1003,10 @@ namespace Backends {
 				if (!entry.old) { entry.old = true ; continue ; }                                                     // entry is too new, wait until next round ==> no check, no wait
 				start_date = entry.date ;
 				conn       = entry.conn ;
+				probed     = true       ;
 				if (+start_date) goto Wakeup ;
-				lost_report = s_heartbeat(entry.tag,job) ;
+				probed      = s_heartbeat_probes(entry.tag,job) ;                                                     // if answered from a bulk probe done at wrap around, no need to wait
+				lost_report = s_heartbeat       (entry.tag,job) ;
 				if (lost_report.second==HeartbeatState::Alive) goto Next ;                                            // job is still alive
 				if (!lost_report.first                       ) lost_report.first = "vanished before start" ;
 				//
@@ -663,17 +1037,17 @@ namespace Backends {
 		Wakeup :
 			_s_wakeup_remote(job,conn,start_date,JobMngtProc::Heartbeat) ;
 		Next :
-			if (!g_config->heartbeat_tick.sleep_for(stop)) break ;                                                    // limit job checks
+			if ( probed && !g_config->heartbeat_tick.sleep_for(stop) ) break ;                                        // limit job checks
 			continue ;
 		WrapAround :
-			for( Tag t : All<Tag> ) if (s_ready(t)) {
+			job = {} ;
+			Delay d = g_config->heartbeat + g_config->network_delay ;                                                 // ensure jobs have had a minimal time to start and signal it
+			if (!(last_wrap_around+d).sleep_until(stop,false/*flush*/)) break ;                                      // limit job checks
+			last_wrap_around = Pdate(New) ;
+			for( Tag t : All<Tag> ) if (s_ready(t)) {                                                                 // take bulk snapshot after sleeping so it is fresh during the sweep
 				Lock lock { _s_mutex } ;
 				s_heartbeat(t) ;
 			}
-			job = {} ;
-			Delay d = g_config->heartbeat + g_config->network_delay ;                                                 // ensure jobs have had a minimal time to start and signal it
-			if ((last_wrap_around+d).sleep_until(stop,false/*flush*/)) { last_wrap_around = Pdate(New) ; continue ; } // limit job checks
-			else                                                       {                                 break    ; }
 		}
 		trace("done") ;
 	}
@@ -686,9 +1060,20 @@ namespace Backends {
 			_s_job_end_thread        .open( 'E' , _s_handle_job_end         , JobExecBacklog ) ;
 			_s_deferred_report_thread.open( 'R' , _s_handle_deferred_report                  ) ;
 			_s_deferred_wakeup_thread.open( 'W' , _s_handle_deferred_wakeup                  ) ;
+			_s_job_end_prep_threads.reserve(NJobEndPrepThreads) ;
+			for( size_t i=0 ; i<NJobEndPrepThreads ; i++ ) _s_job_end_prep_threads.emplace_back(_s_job_end_prep_func,i) ;
+			size_t n_start_prep_threads = ::max( NStartPrepThreads , size_t(g_config->n_py_evaluators) ) ;             // ensure all python evaluators can be used concurrently
+			_s_start_prep_threads.reserve(n_start_prep_threads) ;
+			for( size_t i=0 ; i<n_start_prep_threads ; i++ ) _s_start_prep_threads.emplace_back(_s_start_prep_func,i) ;
 		}
 		Trace trace(BeChnl,"s_config",STR(dynamic)) ;
 		if (!dynamic) _s_job_exec = *g_lmake_dir_s+"_bin/job_exec" ;
+		if ( !_s_relay_fd && ::any_of( config.begin() , config.end() , [](Config::Backend const& cfg)->bool { return cfg.configured && cfg.relay ; } ) ) { // relay may be enabled dynamically
+			trace("relay") ;
+			_s_relay_fd      = {New,JobExecBacklog}                                  ;
+			_s_relay_kick_fd = AutoCloseFd( ::eventfd(0,O_CLOEXEC) , true/*no_std*/ ) ;
+			static ::jthread relay_thread { _s_relay_thread_func } ;
+		}
 		//
 		Lock lock{_s_mutex} ;
 		for( Tag t : All<Tag> ) if (+t) {
@@ -744,6 +1129,12 @@ namespace Backends {
 		,	no_slash(*g_root_dir_s)
 		,	::to_string(entry.conn.seq_id%g_config->trace.n_jobs)
 		} ;
+		bool precompute = g_config->backends[+tag].precompute_start || g_config->n_py_evaluators ;                      // with python evaluators, evaluations can be run concurrently
+		if (g_config->backends[+tag].relay) cmd_line.push_back(_s_relay_fd.service(s_tab[+tag]->addr)) ;
+		if (precompute) {                                                                                                 // prepare start while job is on its way
+			if (_s_n_start_preps<MaxStartPreps) { entry.start_prep.set(StartPrepState::Queued) ; _s_start_prep_queue.emplace( job , entry.conn.seq_id ) ; }
+			else                                  trace("too_many_start_preps") ;
+		}
 		trace("cmd_line",cmd_line) ;
 		return cmd_line ;
 	}
@@ -21,6 +21,13 @@ ENUM(HeartbeatState
 ,	Err
 )
 
+ENUM(StartPrepState // state of the preparation of job start ahead of time (cf. backends.*.precompute_start)
+,	None
+,	Queued
+,	Running
+,	Done
+)
+
 namespace Backends {
 
 	struct Backend ;
@@ -83,6 +90,29 @@ namespace Backends {
 			::array<::atomic<Delay::Tick>,NReqs+1> _submitted_cost ; // use plain integer so as to use atomic increment/decrement instructions because schedule/cancel are called w/o lock
 		} ;
 
+		struct StartAttrs ; // defined in backend.cc as it needs rule definitions
+
+		struct StartPrep {  // count entries whose start is prepared ahead of time so as to bound their number
+			// cxtors & casts
+			StartPrep(                ) = default ;
+			StartPrep(StartPrep&& prep) { *this = ::move(prep) ; }
+			~StartPrep(               ) { set(StartPrepState::None) ; }
+			StartPrep& operator=(StartPrep&& prep) {
+				StartPrepState s = prep.state ;
+				prep.set(StartPrepState::None) ;
+				set(s) ;
+				return *this ;
+			}
+			// services
+			void set(StartPrepState s) {
+				if      ( !state && +s ) _s_n_start_preps++ ;
+				else if ( +state && !s ) _s_n_start_preps-- ;
+				state = s ;
+			}
+			// data
+			StartPrepState state = StartPrepState::None ;
+		} ;
+
 		struct StartEntry {
 			friend ::ostream& operator<<( ::ostream& , StartEntry const& ) ;
 			struct Conn {
@@ -113,6 +143,9 @@ namespace Backends {
 			SubmitAttrs      submit_attrs ;
 			bool             old          = false        ; // becomes true the first time heartbeat passes (only old entries are checked by heartbeat, so first time is skipped for improved perf)
 			Tag              tag          = Tag::Unknown ;
+			//
+			StartPrep                start_prep  ;         // if precompute_start, state of start preparation ahead of time
+			::unique_ptr<StartAttrs> start_attrs ;         // if start_prep is Done, start attributes and reply evaluated before job connects
 		} ;
 
 		struct DeferredEntry {
@@ -137,9 +170,24 @@ namespace Backends {
 			Status release( ::map<Job,StartEntry>::iterator , Status=Status::Ok ) ; // much like erase, but manage retry count
 		} ;
 
-		using JobThread      = ServerThread    <JobRpcReq    ,false/*Flush*/> ;
-		using JobMngtThread  = ServerThread    <JobMngtRpcReq,false/*Flush*/> ;
-		using DeferredThread = TimedDequeThread<DeferredEntry,false/*Flush*/> ;
+		struct RelayPeer {                                               // job start connection through a relay
+			in_addr_t host = NoSockAddr ;                                // host of relay
+			Fd        link ;                                             // link and channel carrying connection, to forget peer when channel is closed
+			uint32_t  chan = 0          ;                                // .
+		} ;
+		struct RelayWakeup {                                             // message sent to a job through a relay, kept until relay confirms delivery
+			Fd              link     ;
+			in_addr_t       host     = NoSockAddr ;
+			in_port_t       port     = 0          ;
+			JobMngtRpcReply msg      ;
+			DeferredEntry   deferred ;
+		} ;
+
+		using JobThread       = ServerThread    <JobRpcReq                               ,false/*Flush*/> ;
+		using JobMngtThread   = ServerThread    <JobMngtRpcReq                           ,false/*Flush*/> ;
+		using DeferredThread  = TimedDequeThread<DeferredEntry                           ,false/*Flush*/> ;
+		using JobEndPrepQueue = ThreadDeque     <::tuple<JobExec,JobRpcReq,::vmap_ss>,true /*Flush*/> ;
+		using StartPrepQueue  = ThreadDeque     <::pair<Job,SeqId>                    ,true /*Flush*/> ;
 		// statics
 		static bool             s_is_local  (Tag) ;
 		static bool             s_ready     (Tag) ;
@@ -160,12 +208,14 @@ namespace Backends {
 		static void s_new_req_etas(     ) ;
 		static void s_launch      (     ) ;
 		//
-		static Pdate s_submitted_eta(Req r) { return _s_workload.submitted_eta(r) ; }
+		static Pdate  s_submitted_eta  (Req r) { return _s_workload.submitted_eta(r) ; }
+		static size_t s_n_job_end_preps(     ) { return _s_n_job_end_preps           ; }                                // job ends not yet handed to engine
 		// called by job_exec thread
 		static ::string/*msg*/          s_start    ( Tag , Job          ) ;                                             // called by job_exec  thread, sub-backend lock must have been takend by caller
 		static ::pair_s<bool/*retry*/>  s_end      ( Tag , Job , Status ) ;                                             // .
 		static void                     s_heartbeat( Tag                ) ;                                             // called by heartbeat thread, sub-backend lock must have been takend by caller
 		static ::pair_s<HeartbeatState> s_heartbeat( Tag , Job          ) ;                                             // called by heartbeat thread, sub-backend lock must have been takend by caller
+		static bool                     s_heartbeat_probes( Tag , Job   ) ;                                             // .
 		//
 	protected :
 		static void s_register( Tag t , Backend& be ) {
@@ -174,12 +224,20 @@ namespace Backends {
 	private :
 		static void            _s_kill_req              ( Req={}                                                    ) ; // kill all if req==0
 		static void            _s_wakeup_remote         ( Job , StartEntry::Conn const& , Pdate start , JobMngtProc ) ;
+		static void            _s_send_to_job           ( in_addr_t , in_port_t , JobMngtRpcReply const& , DeferredEntry&& , int n_trials=1 ) ;
+		static void            _s_direct_send_to_job    ( in_addr_t , in_port_t , JobMngtRpcReply const& , DeferredEntry&& , int n_trials=1 ) ;
+		static ::optional<in_addr_t> _s_peer_addr       ( SlaveSockFd const&                                        ) ;
+		static void            _s_relay_thread_func     ( ::stop_token                                              ) ;
 		static void            _s_heartbeat_thread_func ( ::stop_token                                              ) ;
 		static bool/*keep_fd*/ _s_handle_job_start      ( JobRpcReq    && , SlaveSockFd const& ={}                  ) ;
 		static bool/*keep_fd*/ _s_handle_job_mngt       ( JobMngtRpcReq&& , SlaveSockFd const& ={}                  ) ;
 		static bool/*keep_fd*/ _s_handle_job_end        ( JobRpcReq    && , SlaveSockFd const& ={}                  ) ;
 		static void            _s_handle_deferred_report( DeferredEntry&&                                           ) ;
 		static void            _s_handle_deferred_wakeup( DeferredEntry&&                                           ) ;
+		static void            _s_job_end_prep_func     ( ::stop_token , size_t id                                  ) ;
+		static void            _s_start_prep_func       ( ::stop_token , size_t id                                  ) ;
+		static StartAttrs      _s_eval_start_attrs      ( Job , Rule::SimpleMatch const& , ::vmap_ss const& rsrcs   ) ;
+		static StartAttrs      _s_prep_start            ( Job , Rule::SimpleMatch const& , ::vmap_ss const& rsrcs , SubmitAttrs const& ) ;
 		// static data
 	public :
 		static Backend* s_tab[N<Tag>] ;
@@ -192,11 +250,26 @@ namespace Backends {
 		static JobThread                            _s_job_start_thread       ;
 		static JobMngtThread                        _s_job_mngt_thread        ;
 		static JobThread                            _s_job_end_thread         ;
+		static JobEndPrepQueue                      _s_job_end_prep_queue     ;                        // job ends are prepared on a pool of threads before being handed to engine
+		static ::vector<::jthread>                  _s_job_end_prep_threads   ;
+		static ::atomic<size_t>                     _s_n_job_end_preps        ;                        // number of job ends in _s_job_end_prep_queue or being prepared
+		static StartPrepQueue                       _s_start_prep_queue       ;                        // launched jobs whose start is prepared ahead of time
+		static ::vector<::jthread>                  _s_start_prep_threads     ;
+		static ::condition_variable_any             _s_start_prep_cond        ;                        // notified when a start preparation is over, protected by _s_mutex
+		static ::atomic<size_t>                     _s_n_start_preps          ;                        // number of entries whose start_prep is not None
 		static SmallIds<SmallId,true/*ThreadSafe*/> _s_small_ids              ;
 		static ::atomic<JobIdx>                     _s_starting_job           ;                        // this job is starting when _starting_job_mutex is locked
 		static Mutex<MutexLvl::StartJob>            _s_starting_job_mutex     ;
 		static StartTab                             _s_start_tab              ;                        // use map instead of umap because heartbeat iterates over while tab is moving
 		static Workload                             _s_workload               ;                        // book keeping of workload
+		static ServerSockFd                         _s_relay_fd               ;                        // job relays connect here (cf. job_relay.cc)
+		static AutoCloseFd                          _s_relay_kick_fd          ;                        // eventfd telling relay thread that data are waiting in _s_relay_outs
+		static Mutex<MutexLvl::Relay>               _s_relay_mutex            ;                        // protects following fields
+		static ::umap<in_addr_t,Fd>                 _s_relay_links            ;                        // host -> link to the relay running on this host
+		static ::umap<Fd,::string>                  _s_relay_outs             ;                        // link -> data waiting to be sent, only relay thread writes to links and it never blocks
+		static ::umap<Fd,RelayPeer>                 _s_relay_peers            ;                        // job start connections through a relay -> relay info
+		static ::umap<uint32_t,RelayWakeup>         _s_relay_wakeups          ;                        // channels opened by server, not yet closed by relay
+		static uint32_t                             _s_relay_next_chan        ;
 		// services
 	public :
 		// PER_BACKEND : these virtual functions must be implemented by sub-backend, some of them have default implementations that do nothing when meaningful
@@ -219,6 +292,7 @@ namespace Backends {
 		virtual ::pair_s<bool/*retry*/>  end      (Job,Status) { return {}                         ; } // tell sub-backend job ended, return a message and whether to retry jobs with garbage status
 		virtual void                     heartbeat(          ) {                                     } // regularly called between launch and start
 		virtual ::pair_s<HeartbeatState> heartbeat(Job       ) { return {{},HeartbeatState::Alive} ; } // regularly called between launch and start, initially with enough delay for job to connect
+		virtual bool             heartbeat_probes(Job) const { return true                         ; } // if false, heartbeat(Job) is answered without probing daemon, no need to rate limit
 		//
 		virtual ::vmap_ss mk_lcl( ::vmap_ss&& /*rsrcs*/ , ::vmap_s<size_t> const& /*capacity*/ ) const { return {} ; } // map resources for this backend to local resources knowing local capacity
 		//
@@ -265,6 +339,7 @@ namespace Backends {
 	inline ::pair_s<bool/*retry*/>  Backend::s_end      ( Tag t , Job j , Status s ) { _s_mutex.swear_locked() ; Trace trace(BeChnl,"s_end"      ,t,j) ; return s_tab[+t]->end      (j,s) ; }
 	inline void                     Backend::s_heartbeat( Tag t                    ) { _s_mutex.swear_locked() ; Trace trace(BeChnl,"s_heartbeat",t  ) ; return s_tab[+t]->heartbeat(   ) ; }
 	inline ::pair_s<HeartbeatState> Backend::s_heartbeat( Tag t , Job j            ) { _s_mutex.swear_locked() ; Trace trace(BeChnl,"s_heartbeat",t,j) ; return s_tab[+t]->heartbeat(j  ) ; }
+	inline bool                     Backend::s_heartbeat_probes( Tag t , Job j     ) { _s_mutex.swear_locked() ;                                          return s_tab[+t]->heartbeat_probes(j) ; }
 
 }
 
@@ -5,8 +5,6 @@
 
 #include "core.hh"
 
-// XXX : rework to maintain an ordered list of waiting_queues in ReqEntry to avoid walking through all rsrcs for each launched job
-
 // a job may have 3 states :
 // - waiting : job has been submitted and is retained here until we can spawn it
 // - queued  : job has been spawned but has not yet started
@@ -96,12 +94,13 @@ namespace Backends {
 
 	template<class RsrcsAsk> struct _WaitingEntry {
 		_WaitingEntry() = default ;
-		_WaitingEntry( RsrcsAsk const& rsa , SubmitAttrs const& sa , bool v ) : rsrcs_ask{rsa} , n_reqs{1} , submit_attrs{sa} , verbose{v} {}
+		_WaitingEntry( RsrcsAsk const& rsa , SubmitAttrs const& sa , bool v , Delay et ) : rsrcs_ask{rsa} , n_reqs{1} , submit_attrs{sa} , verbose{v} , exec_time{et} {}
 		// data
 		RsrcsAsk    rsrcs_ask    ;
 		ReqIdx      n_reqs       = 0     ; // number of reqs waiting for this job
 		SubmitAttrs submit_attrs ;
 		bool        verbose      = false ;
+		Delay       exec_time    ;         // estimated exec time, 0 if unknown, snapshot at submit time as job data may only be read from main thread
 	} ;
 	template<class RsrcsAsk > ::ostream& operator<<( ::ostream& os , _WaitingEntry<RsrcsAsk> const& we ) {
 		/**/            os << "WaitingEntry(" << we.rsrcs_ask <<','<< we.n_reqs <<','<< we.submit_attrs ;
@@ -111,21 +110,25 @@ namespace Backends {
 
 	template< class SpawnId , class Rsrcs > struct _SpawnedEntry {
 		// ctors & casts
-		void create(Rsrcs const& rs) {
+		void create( Rsrcs const& rs , Delay et ) {
 			SWEAR(!live) ;
-			rsrcs   = rs    ;
-			id      = 0     ;
-			started = false ;
-			verbose = false ;
-			live    = true  ;
+			rsrcs     = rs    ;
+			exec_time = et    ;
+			date      = New   ;
+			id        = 0     ;
+			started   = false ;
+			verbose   = false ;
+			live      = true  ;
 		}
 		// data
-		Rsrcs             rsrcs   ;
-		::atomic<SpawnId> id      = 0     ;
-		::atomic<bool   > failed  = false ; // if true <=> job could not ben launched
-		bool              started = false ; // if true <=> start() has been called for this job, for assert only
-		bool              verbose = false ;
-		::atomic<bool   > live    = false ; // if false <=> entry waiting for suppression
+		Rsrcs             rsrcs     ;
+		Delay             exec_time ;         // copied from waiting entry
+		Pdate             date      ;         // date at which job was spawned
+		::atomic<SpawnId> id        = 0     ;
+		::atomic<bool   > failed    = false ; // if true <=> job could not ben launched
+		bool              started   = false ; // if true <=> start() has been called for this job, for assert only
+		bool              verbose   = false ;
+		::atomic<bool   > live      = false ; // if false <=> entry waiting for suppression
 	} ;
 	template< class SpawnId , class Rsrcs > ::ostream& operator<<( ::ostream& os , _SpawnedEntry<SpawnId,Rsrcs> const& se ) {
 		os << "SpawnedEntry(" ;
@@ -148,6 +151,14 @@ namespace Backends {
 		using WaitingEntry = _WaitingEntry<RsrcsAsk>      ;
 		using SpawnedEntry = _SpawnedEntry<SpawnId,Rsrcs> ;
 
+		struct LaunchDescr {
+			Job                job      ;
+			::vector<ReqIdx>   reqs     ;
+			::vector_s         cmd_line ;
+			Pdate              prio     ;
+			SpawnedEntry*      entry    = nullptr ;
+		} ;
+
 		struct SpawnedTab : ::umap<Job,SpawnedEntry> {
 			using Base = ::umap<Job,SpawnedEntry> ;
 			using typename Base::iterator       ;
@@ -160,11 +171,11 @@ namespace Backends {
 			bool   operator!() const { return !+*this ; }                    // .
 			size_t size     () const { return _sz     ; }                    // .
 			//
-			iterator create( GenericBackend const& be , Job j , RsrcsAsk const& rsrcs_ask ) {
-				Rsrcs    rsrcs = be.acquire_rsrcs(rsrcs_ask) ;
-				iterator res   = Base::try_emplace(j).first  ;
+			iterator create( GenericBackend const& be , Job j , WaitingEntry const& we ) {
+				Rsrcs    rsrcs = be.acquire_rsrcs(we.rsrcs_ask) ;
+				iterator res   = Base::try_emplace(j).first     ;
 				SWEAR(!res->second.live) ;
-				res->second.create(rsrcs) ;
+				res->second.create(rsrcs,we.exec_time) ;
 				_sz++ ;
 				return res ;
 			}
@@ -200,41 +211,107 @@ namespace Backends {
 			Job         job      ;
 		} ;
 
+		struct QueueHead {
+			// services
+			bool operator<(QueueHead const& other) const { return pressure<other.pressure ; } // for use in a max-heap : higher pressure on top
+			// data
+			CoarseDelay pressure  ;
+			RsrcsAsk    rsrcs_ask ;
+		} ;
+
 		struct ReqEntry {
+			using WaitingQueues = ::umap<RsrcsAsk,set<PressureEntry>> ;
 			ReqEntry() = default ;
 			ReqEntry( JobIdx nj , bool v ) : n_jobs{nj} , verbose{v} {}
-			// service
+			// accesses
+			bool is_valid(QueueHead const& qh) const {                                           // heads are lazily invalidated when their queue is modified
+				auto it = waiting_queues.find(qh.rsrcs_ask) ;
+				return it!=waiting_queues.end() && it->second.begin()->pressure==qh.pressure ;
+			}
+			// services
 			void clear() {
 				waiting_queues.clear() ;
 				waiting_jobs  .clear() ;
+				queue_heads   .clear() ;
+			}
+			void insert_waiting( RsrcsAsk const& rsa , PressureEntry const& pe ) {
+				::set<PressureEntry>& q        = waiting_queues[rsa]                         ;
+				bool                  new_head = !q || pe.pressure>q.begin()->pressure ;     // if same pressure, current head is still valid
+				q.insert(pe) ;
+				if (new_head) push_head(rsa,pe.pressure) ;
+			}
+			void erase_waiting( WaitingQueues::iterator it , PressureEntry const& pe , bool force_push=false ) { // force_push if the head of it has been popped
+				::set<PressureEntry>& q         = it->second                      ;
+				CoarseDelay           old_press = q.begin()->pressure             ;
+				size_t                n_erased  = q.erase(pe) ; SWEAR(n_erased,pe.job) ;
+				if      (!q                                            ) waiting_queues.erase(it) ;                   // last entry for this rsrcs, erase the entire queue
+				else if ( force_push || q.begin()->pressure!=old_press ) push_head(it->first,q.begin()->pressure) ;
+			}
+			void push_head( RsrcsAsk const& rsa , CoarseDelay pressure ) {
+				if (queue_heads.size()>2*waiting_queues.size()+16) {                             // too many invalid heads, rebuild from scratch to keep size bounded
+					queue_heads.clear() ;
+					for( auto const& [r,q] : waiting_queues ) queue_heads.push_back({q.begin()->pressure,r}) ;
+					::make_heap( queue_heads.begin() , queue_heads.end() ) ;
+					return ;                                                                     // rsa is necessarily included
+				}
+				queue_heads.push_back({pressure,rsa}) ;
+				::push_heap( queue_heads.begin() , queue_heads.end() ) ;
+			}
+			QueueHead pop_head() {
+				::pop_heap( queue_heads.begin() , queue_heads.end() ) ;
+				QueueHead res = ::move(queue_heads.back()) ;
+				queue_heads.pop_back() ;
+				return res ;
 			}
 			// data
-			::umap<RsrcsAsk,set<PressureEntry>> waiting_queues ;
-			::umap<Job,CoarseDelay            > waiting_jobs   ;
-			JobIdx                              n_jobs         = 0     ; // manage -j option (if >0 no more than n_jobs can be launched on behalf of this req)
-			bool                                verbose        = false ;
+			WaitingQueues                  waiting_queues ;
+			::vector<QueueHead>            queue_heads    ;                                      // max-heap of queue heads, each non-empty queue has at least a valid entry (cf. is_valid)
+			::umap<Job,CoarseDelay       > waiting_jobs   ;
+			JobIdx                         n_jobs         = 0     ;                              // manage -j option (if >0 no more than n_jobs can be launched on behalf of this req)
+			bool                           verbose        = false ;
 		} ;
 
+		// statics
+		static Delay _s_exec_time(Job j) {                   // estimated exec time, 0 if unknown, job data may only be read from main thread
+			if (+j->exec_time) return j->exec_time       ; // last run of this very job is the best estimate
+			else               return j->rule->exec_time ; // else use rule average
+		}
+
 		// specialization
 		virtual void sub_config( vmap_ss const& , bool /*dynamic*/ ) {}
 		//
 		virtual bool call_launch_after_start() const { return false ; }
 		virtual bool call_launch_after_end  () const { return false ; }
 		//
-		virtual bool/*ok*/   fit_eventually( RsrcsDataAsk const&             ) const { return true ; } // true if job with such resources can be spawned eventually
-		virtual bool/*ok*/   fit_now       ( RsrcsAsk     const&             ) const = 0 ;             // true if job with such resources can be spawned now
-		virtual Rsrcs        acquire_rsrcs ( RsrcsAsk     const&             ) const = 0 ;             // acquire maximum possible asked resources
-		virtual void         start_rsrcs   ( Rsrcs        const&             ) const {}                // handle resources at start of job
-		virtual void         end_rsrcs     ( Rsrcs        const&             ) const {}                // handle resources at end   of job
-		virtual ::vmap_ss    export_       ( RsrcsData    const&             ) const = 0 ;             // export resources in   a publicly manageable form
-		virtual RsrcsDataAsk import_       ( ::vmap_ss        && , Req , Job ) const = 0 ;             // import resources from a publicly manageable form
+		virtual bool/*ok*/   fit_eventually( RsrcsDataAsk const&             ) const { return true         ; } // true if job with such resources can be spawned eventually
+		virtual bool/*ok*/   fit_now       ( RsrcsAsk     const&             ) const = 0 ;                     // true if job with such resources can be spawned now
+		virtual void         new_launch    (                                 ) const {}                        // called before each launch round
+		virtual bool/*ok*/   fit_now_job   ( RsrcsAsk     const& rsa , Delay ) const { return fit_now(rsa) ; } // same as fit_now, jobs are presented by decreasing pressure within a launch round
+		virtual Rsrcs        acquire_rsrcs ( RsrcsAsk     const&             ) const = 0 ;                     // acquire maximum possible asked resources
+		virtual void         start_rsrcs   ( Rsrcs        const&             ) const {}                        // handle resources at start of job
+		virtual void         end_rsrcs     ( Rsrcs        const&             ) const {}                        // handle resources at end   of job
+		virtual ::vmap_ss    export_       ( RsrcsData    const&             ) const = 0 ;                     // export resources in   a publicly manageable form
+		virtual RsrcsDataAsk import_       ( ::vmap_ss        && , Req , Job ) const = 0 ;                     // import resources from a publicly manageable form
 		//
 		virtual ::string                 start_job           ( Job , SpawnedEntry const&          ) const { return  {}                        ; }
 		virtual ::pair_s<bool/*retry*/>  end_job             ( Job , SpawnedEntry const& , Status ) const { return {{},false/*retry*/       } ; }
 		virtual ::pair_s<HeartbeatState> heartbeat_queued_job( Job , SpawnedEntry const&          ) const { return {{},HeartbeatState::Alive} ; } // only called before start
+		// classify all queued jobs at once, jobs absent from result are probed individually with heartbeat_queued_job
+		virtual ::umap<Job,::pair_s<HeartbeatState>> heartbeat_queued_jobs( ::vmap<Job,SpawnedEntry const*> const& ) const { return {} ; }      // .
 		virtual void                     kill_queued_job     (       SpawnedEntry const&          ) const = 0 ;                                   // .
 		//
 		virtual SpawnId launch_job( ::stop_token , Job , ::vector<ReqIdx> const& , Pdate prio , ::vector_s const& cmd_line , Rsrcs const& , bool verbose ) const = 0 ;
+		// jobs sharing the same resources and selected in the same launch round are launched together, up to launch_batch_sz() at a time
+		// return ids in the same order as descrs, a null id marks a job that could not be launched, throw if none could be launched
+		virtual size_t            launch_batch_sz(                                                                                 ) const { return 1 ; }
+		virtual ::vector<SpawnId> launch_jobs    ( ::stop_token st , ::vector<LaunchDescr const*> const& descrs , Rsrcs const& rs , bool verbose ) const {
+			::vector<SpawnId> res ; res.reserve(descrs.size()) ;
+			for( LaunchDescr const* ld : descrs ) {
+				try                       { res.push_back(launch_job( st , ld->job , ld->reqs , ld->prio , ld->cmd_line , rs , verbose )) ; }
+				catch (::string const& e) { Trace trace(BeChnl,"launch_jobs","fail",ld->job,e) ; res.push_back(0) ;                          }
+			}
+			return res ;
+		}
 
 		// services
 		virtual void config( vmap_ss const& dct , bool dynamic ) {
@@ -275,8 +352,8 @@ namespace Backends {
 			Trace trace(BeChnl,"submit",rsa,pressure) ;
 			//
 			re.waiting_jobs[job] = pressure ;
-			waiting_jobs.emplace( job , WaitingEntry(rsa,submit_attrs,re.verbose) ) ;
-			re.waiting_queues[rsa].insert({pressure,job}) ;
+			waiting_jobs.emplace( job , WaitingEntry(rsa,submit_attrs,re.verbose,_s_exec_time(job)) ) ;
+			re.insert_waiting(rsa,{pressure,job}) ;
 			if (!_oldest_submitted_job.load()) _oldest_submitted_job = New ;
 		}
 		virtual void add_pressure( Job job , Req req , SubmitAttrs const& submit_attrs ) {
@@ -300,7 +377,7 @@ namespace Backends {
 			trace("adjusted_pressure",pressure) ;
 			//
 			re.waiting_jobs[job] = pressure ;
-			re.waiting_queues[we.rsrcs_ask].insert({pressure,job}) ;                                                // job must be known
+			re.insert_waiting(we.rsrcs_ask,{pressure,job}) ;                                                        // job must be known
 			we.submit_attrs |= submit_attrs ;
 			we.verbose      |= re.verbose   ;
 			we.n_reqs++ ;
@@ -310,14 +387,14 @@ namespace Backends {
 			auto      it = waiting_jobs.find(job) ;
 			//
 			if (it==waiting_jobs.end()) return ;                                                                    // job is not waiting anymore, ignore
-			WaitingEntry        & we           = it->second                         ;
-			CoarseDelay         & old_pressure = re.waiting_jobs  .at(job         ) ;                               // job must be known
-			::set<PressureEntry>& q            = re.waiting_queues.at(we.rsrcs_ask) ;                               // including for this req
-			CoarseDelay           pressure     = submit_attrs.pressure              ;
+			WaitingEntry& we           = it->second                           ;
+			CoarseDelay & old_pressure = re.waiting_jobs  .at  (job         ) ;                                     // job must be known
+			auto          qit          = re.waiting_queues.find(we.rsrcs_ask) ; SWEAR(qit!=re.waiting_queues.end()) ; // including for this req
+			CoarseDelay   pressure     = submit_attrs.pressure                ;
 			Trace trace("set_pressure","pressure",pressure) ;
 			we.submit_attrs |= submit_attrs ;
-			q.erase ({old_pressure,job}) ;
-			q.insert({pressure    ,job}) ;
+			re.erase_waiting ( qit          , {old_pressure,job} ) ;
+			re.insert_waiting( we.rsrcs_ask , {pressure    ,job} ) ;
 			old_pressure = pressure ;
 		}
 	protected :
@@ -345,6 +422,18 @@ namespace Backends {
 		}
 		virtual void heartbeat() {
 			if (_oldest_submitted_job.load()+g_config->heartbeat<Pdate(New)) launch() ;                             // prevent jobs from being accumulated for too long
+			::vmap<Job,SpawnedEntry const*> queued_jobs ;
+			for( auto const& [j,se] : spawned_jobs ) if ( se.live && !se.started && se.id ) queued_jobs.emplace_back(j,&se) ;
+			_bulk_heartbeats.clear() ;
+			if (+queued_jobs) {
+				::umap<Job,::pair_s<HeartbeatState>> digests = heartbeat_queued_jobs(queued_jobs) ;                // one query for the whole sweep rather than one per job
+				for( auto const& [j,se] : queued_jobs )                                                             // record spawn id so result is not applied to a later spawn of the same job
+					if ( auto it=digests.find(j) ; it!=digests.end() ) _bulk_heartbeats.try_emplace( j , se->id.load() , ::move(it->second) ) ;
+			}
+			Trace trace(BeChnl,"heartbeat",T,queued_jobs.size(),_bulk_heartbeats.size()) ;
+		}
+		virtual bool heartbeat_probes(Job j) const {
+			return !_bulk_heartbeat(j) ;
 		}
 		virtual ::pair_s<HeartbeatState> heartbeat(Job j) {                                                         // called on jobs that did not start after at least newwork_delay time
 			auto it = spawned_jobs.find(j) ;
@@ -362,7 +451,14 @@ namespace Backends {
 					else           return {{}                    ,HeartbeatState::Alive} ;                          // book keeping is not updated yet
 				}
 			}
-			::pair_s<HeartbeatState> digest = heartbeat_queued_job(j,se) ;
+			::pair_s<HeartbeatState> digest ;
+			if ( auto bit=_bulk_heartbeats.find(j) ; bit!=_bulk_heartbeats.end() ) {
+				if (bit->second.first==se.id) digest = ::move(bit->second.second) ;
+				else                          digest = heartbeat_queued_job(j,se) ;                                // job has been respawned since sweep, result is stale
+				_bulk_heartbeats.erase(bit) ;
+			} else {
+				digest = heartbeat_queued_job(j,se) ;
+			}
 			if (digest.second!=HeartbeatState::Alive) {
 				Trace trace(BeChnl,"heartbeat",j,se.id,digest.second) ;
 				spawned_jobs.erase(*this,it) ;
@@ -408,79 +504,88 @@ namespace Backends {
 			_launch_queue.wakeup() ;
 		}
 		void _launch(::stop_token st) {
-			struct LaunchDescr {
-				::vector<ReqIdx>   reqs     ;
-				::vector_s         cmd_line ;
-				Pdate              prio     ;
-				SpawnedEntry*      entry    = nullptr ;
-			} ;
+			new_launch() ;
 			for( auto [req,eta] : Req::s_etas() ) {                                                                 // /!\ it is forbidden to dereference req without taking Req::s_reqs_mutex first
 				Trace trace(BeChnl,"launch",req) ;
-				::vmap<Job,LaunchDescr> launch_descrs ;
+				::vector<LaunchDescr> launch_descrs ;
 				{	Lock lock { _s_mutex } ;
 					auto rit = reqs.find(+req) ;
 					if (rit==reqs.end()) continue ;
-					JobIdx                               n_jobs = rit->second.n_jobs         ;
-					::umap<RsrcsAsk,set<PressureEntry>>& queues = rit->second.waiting_queues ;
+					ReqEntry&           req_entry = rit->second ;
+					::vector<QueueHead> not_fit   ;                                                                     // heads that do not fit now, resources do not free up while we hold the lock
 					for(;;) {
-						if ( n_jobs && spawned_jobs.size()>=n_jobs ) break ;                                        // cannot have more than n_jobs running jobs because of this req, process next req
-						auto candidate = queues.end() ;
-						for( auto it=queues.begin() ; it!=queues.end() ; it++ ) {
-							if ( candidate!=queues.end() && it->second.begin()->pressure<=candidate->second.begin()->pressure ) continue ;
-							if (fit_now(it->first)) candidate = it ;                                                                       // continue to find a better candidate
-						}
-						if (candidate==queues.end()) break ;                                                                               // nothing for this req, process next req
+						if ( req_entry.n_jobs && spawned_jobs.size()>=req_entry.n_jobs ) break ;                    // cannot have more than n_jobs running jobs because of this req, process next req
+						if (!req_entry.queue_heads                                     ) break ;                    // nothing for this req, process next req
+						QueueHead candidate = req_entry.pop_head() ;                                                // best candidate is the highest pressure queue that fits
+						if (!req_entry.is_valid(candidate)) continue ;                                              // queue has been modified since candidate was pushed
+						//
+						auto                  qit          = req_entry.waiting_queues.find(candidate.rsrcs_ask)       ;
+						::set<PressureEntry>& pressure_set = qit->second                                              ;
+						PressureEntry         pressure1    = *pressure_set.begin()                                    ;
+						Job                   j            = pressure1.job                                            ;
+						auto                  wit          = waiting_jobs.find(j)                                     ;
+						if (!fit_now_job(candidate.rsrcs_ask,wit->second.exec_time)) { not_fit.push_back(::move(candidate)) ; continue ; }
 						//
-						::set<PressureEntry>& pressure_set = candidate->second                                     ;
-						auto                  pressure1    = pressure_set.begin()                                  ; SWEAR(pressure1!=pressure_set.end(),candidate->first) ; // a candidate ...
-						Pdate                 prio         = eta-pressure1->pressure                               ;                                                         // ... with no pressure ?
-						Job                   j            = pressure1->job                                        ;
-						auto                  wit          = waiting_jobs.find(j)                                  ;
-						SpawnedEntry&         se           = spawned_jobs.create(*this,j,candidate->first)->second ;
+						Pdate                 prio         = eta-pressure1.pressure                                   ;
+						SpawnedEntry&         se           = spawned_jobs.create(*this,j,wit->second)->second         ;
 						//
 						se.verbose = wit->second.verbose ;
 						::vector<ReqIdx> rs { +req } ;
 						for( auto const& [r,re] : reqs )
 							if      (!re.waiting_jobs.contains(j)) SWEAR(r!=req,r)  ;
 							else if (r!=req                      ) rs.push_back(+r) ;
-						launch_descrs.emplace_back( j , LaunchDescr{ rs , acquire_cmd_line(T,j,rs,export_(*se.rsrcs),wit->second.submit_attrs) , prio , &se } ) ;
+						launch_descrs.push_back({ j , rs , acquire_cmd_line(T,j,rs,export_(*se.rsrcs),wit->second.submit_attrs) , prio , &se }) ;
 						waiting_jobs.erase(wit) ;
 						//
 						for( Req r : rs ) {
 							ReqEntry& re   = reqs.at(r)              ;
 							auto      wit1 = re.waiting_jobs.find(j) ;
-							if (r!=req) {
-								auto                  wit2 = re.waiting_queues.find(candidate->first) ;
-								::set<PressureEntry>& pes  = wit2->second                             ;
-								PressureEntry         pe   { wit1->second , j }                       ;                // /!\ pressure is job pressure for r, not for req
-								SWEAR(pes.contains(pe)) ;
-								if (pes.size()==1) re.waiting_queues.erase(wit2) ;                                     // last entry for this rsrcs, erase the entire queue
-								else               pes              .erase(pe  ) ;
-							}
+							if (r!=req) re.erase_waiting( re.waiting_queues.find(candidate.rsrcs_ask) , {wit1->second,j} ) ; // /!\ pressure is job pressure for r, not for req
 							re.waiting_jobs.erase(wit1) ;
 						}
-						if (pressure_set.size()==1) queues      .erase(candidate) ;                                    // last entry for this rsrcs, erase the entire queue
-						else                        pressure_set.erase(pressure1) ;
+						req_entry.erase_waiting( qit , pressure1 , true/*force_push*/ ) ;                           // candidate has been popped, push new head if any
+					}
+					for( QueueHead& qh : not_fit ) if (req_entry.is_valid(qh)) req_entry.push_head(qh.rsrcs_ask,qh.pressure) ; // restore heads for next time
+				}
+				::vector<::vector<LaunchDescr const*>> batches ;                                                       // jobs with same resources, in launch order
+				for( LaunchDescr const& ld : launch_descrs ) {
+					SpawnedEntry const& se  = *ld.entry        ;
+					auto                bit = batches.begin() ;
+					for(; bit!=batches.end() ; bit++ ) {
+						SpawnedEntry const& se0 = *bit->front()->entry ;
+						if ( se0.rsrcs==se.rsrcs && se0.verbose==se.verbose && bit->size()<launch_batch_sz() ) break ;
 					}
+					if (bit==batches.end()) batches.push_back({&ld}) ;
+					else                    bit->push_back(&ld)      ;
 				}
-				for( auto& [ji,ld] : launch_descrs ) {
+				for( ::vector<LaunchDescr const*>& batch : batches ) {
 					Lock lock { id_mutex } ;
-					SpawnedEntry& se = *ld.entry ;
-					if (!se.live) continue ;                                                                           // job was cancelled before being launched
+					::erase_if( batch , [](LaunchDescr const* ld)->bool { return !ld->entry->live ; } ) ;             // job was cancelled before being launched
+					if (!batch) continue ;
+					SpawnedEntry const& se0 = *batch.front()->entry ;
+					::vector<SpawnId>   ids ;
 					try {
-						SpawnId id = launch_job( st , ji , ld.reqs , ld.prio , ld.cmd_line , se.rsrcs , se.verbose ) ; // XXX : manage errors, for now rely on heartbeat
-						SWEAR(id,ji) ;                                                                                 // null id is used to mark absence of id
-						se.id = id ;
-						trace("child",ji,ld.prio,id,ld.cmd_line) ;
+						ids = launch_jobs( st , batch , se0.rsrcs , se0.verbose ) ;                                    // XXX : manage errors, for now rely on heartbeat
+						SWEAR( ids.size()==batch.size() , ids.size() , batch.size() ) ;
 					} catch (::string const& e) {
-						trace("fail",ji,ld.prio,e) ;
-						se.failed = true ;
-						_launch_queue.wakeup() ;                                               // we may have new jobs to launch as we did not launch all jobs we were supposed to
+						trace("fail",batch.size(),e) ;
+						ids.assign(batch.size(),0) ;
+					}
+					for( size_t i=0 ; i<batch.size() ; i++ ) {
+						LaunchDescr const& ld = *batch[i] ;
+						if (ids[i]) {                                                                                  // null id is used to mark absence of id
+							ld.entry->id = ids[i] ;
+							trace("child",ld.job,ld.prio,ids[i],ld.cmd_line) ;
+						} else {
+							trace("fail",ld.job,ld.prio) ;
+							ld.entry->failed = true ;
+							_launch_queue.wakeup() ;                                                                   // we may have new jobs to launch as we did not launch all jobs we were supposed to
+						}
 					}
 				}
 				{	Lock lock { _s_mutex } ;
-					for( auto const& [ji,_] : launch_descrs ) {
-						auto it=spawned_jobs.find(ji) ; if (it==spawned_jobs.end()) continue ;
+					for( LaunchDescr const& ld : launch_descrs ) {
+						auto it=spawned_jobs.find(ld.job) ; if (it==spawned_jobs.end()) continue ;
 						if (it->second.failed) spawned_jobs.erase(*this,it) ;                  // job could not be launched, release resources
 						/**/                   spawned_jobs.flush(      it) ;                  // collect unused entry now that we hold _s_mutex
 					}
@@ -498,8 +603,15 @@ namespace Backends {
 	protected :
 		Mutex<MutexLvl::BackendId> mutable id_mutex ;
 	private :
+		bool/*fresh*/ _bulk_heartbeat(Job j) const {                                                               // true if sweep result for j applies to its current spawn
+			auto bit = _bulk_heartbeats.find(j) ; if (bit==_bulk_heartbeats.end()) return false ;
+			auto it  = spawned_jobs    .find(j) ; if (it ==spawned_jobs    .end()) return false ;
+			return bit->second.first==it->second.id ;
+		}
+		// data
 		WakeupThread<false/*Flush*/> mutable _launch_queue         ;
 		::atomic<Pdate>                      _oldest_submitted_job ; // if no date, no new job
+		::umap<Job,::pair<SpawnId,::pair_s<HeartbeatState>>> _bulk_heartbeats ; // result of last heartbeat_queued_jobs with spawn id it applies to, consumed by heartbeat(Job)
 
 	} ;
 
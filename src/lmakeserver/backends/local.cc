@@ -3,6 +3,7 @@
 // This program is free software: you can redistribute/modify under the terms of the GPL-v3 (https://www.gnu.org/licenses/gpl-3.0.html).
 // This program is distributed WITHOUT ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
 
+#include <poll.h>
 #include <sys/sysinfo.h>
 #include <sys/resource.h>
 
@@ -34,6 +35,10 @@ namespace Backends::Local {
 		// services
 		RsrcsData& operator+=(RsrcsData const& rsrcs) { SWEAR(size()==rsrcs.size(),size(),rsrcs.size()) ; for( size_t i=0 ; i<size() ; i++ ) (*this)[i] += rsrcs[i] ; return *this ; }
 		RsrcsData& operator-=(RsrcsData const& rsrcs) { SWEAR(size()==rsrcs.size(),size(),rsrcs.size()) ; for( size_t i=0 ; i<size() ; i++ ) (*this)[i] -= rsrcs[i] ; return *this ; }
+		bool fit_in(RsrcsData const& capacity) const {                                                        // true if all resources fit within capacity
+			for( size_t i=0 ; i<size() ; i++ ) if ( (*this)[i] > capacity[i] ) return false ;
+			return true ;
+		}
 	} ;
 
 	struct RsrcsDataAsk : ::vector<RsrcAsk> {
@@ -49,6 +54,11 @@ namespace Backends::Local {
 			for( size_t i=0 ; i<size() ; i++ ) if ( (*this)[i].min > capacity[i] ) return false ;
 			return true ;
 		}
+		RsrcsData min() const {
+			RsrcsData res ; res.reserve(size()) ;
+			for( RsrcAsk const& ra : *this ) res.push_back(ra.min) ;
+			return res ;
+		}
 		RsrcsData within( RsrcsData const& occupied , RsrcsData const& capacity ) const {                     // what fits within capacity on top of occupied
 			RsrcsData res ; res.reserve(size()) ;
 			for( size_t i=0 ; i<size() ; i++ ) {
@@ -100,7 +110,7 @@ namespace Backends::Local {
 
 		// statics
 	private :
-		static void _s_wait_job(pid_t pid) { // execute in a separate thread
+		static void _s_wait_job(pid_t pid) {                 // execute in a separate thread
 			Trace trace(BeChnl,"wait",pid) ;
 			::waitpid(pid,nullptr,0) ;
 			trace("waited",pid) ;
@@ -112,8 +122,19 @@ namespace Backends::Local {
 
 		// services
 
-		virtual void sub_config( ::vmap_ss const& dct , bool dynamic ) {
-			Trace trace(BeChnl,"Local::config",STR(dynamic),dct) ;
+		virtual void sub_config( ::vmap_ss const& cfg , bool dynamic ) {
+			Trace trace(BeChnl,"Local::config",STR(dynamic),cfg) ;
+			::vmap_ss dct ;                                                                                         // all entries but options are resources
+			backfill = false ;
+			pool     = false ;
+			for( auto const& [k,v] : cfg ) {
+				if ( k=="backfill" || k=="pool" ) {
+					try         { ( k=="pool" ? pool : backfill ) = from_string<bool>(v) ; }
+					catch (...) { throw "wrong value for entry "+k+" : "+v ;               }
+					continue ;
+				}
+				dct.emplace_back(k,v) ;
+			}
 			if (dynamic) {
 				/**/                                         if (rsrc_keys.size()!=dct.size()) throw "cannot change resource names while lmake is running"s ;
 				for( size_t i=0 ; i<rsrc_keys.size() ; i++ ) if (rsrc_keys[i]!=dct[i].first  ) throw "cannot change resource names while lmake is running"s ;
@@ -126,8 +147,10 @@ namespace Backends::Local {
 			}
 			capacity_ = RsrcsData( dct , rsrc_idxs  ) ;
 			occupied  = RsrcsData( rsrc_keys.size() ) ;
+			_usage.resize(rsrc_keys.size()) ;
 			//
 			SWEAR( rsrc_keys.size()==capacity_.size() , rsrc_keys.size() , capacity_.size() ) ;
+			public_capacity.clear() ;
 			for( size_t i=0 ; i<capacity_.size() ; i++ ) public_capacity.emplace_back( rsrc_keys[i] , capacity_[i] ) ;
 			trace("capacity",capacity()) ;
 			_wait_queue.open( 'T' , _s_wait_job ) ;
@@ -157,37 +180,85 @@ namespace Backends::Local {
 		virtual bool/*ok*/ fit_now(RsrcsAsk const& rsa) const {
 			return rsa->fit_in(occupied,capacity_) ;
 		}
+		virtual void new_launch() const {
+			_reserved = false ;
+		}
+		// with backfill, the first job that does not fit reserves the date at which it will fit according to running jobs etas
+		// then other jobs may only be launched if they do not delay this reservation, i.e. if they end before it or if they use resources it does not need
+		virtual bool/*ok*/ fit_now_job( RsrcsAsk const& rsa , Delay exec_time ) const {
+			if (!backfill ) return fit_now(rsa) ;
+			if (!_reserved) {
+				if (fit_now(rsa)) return true ;                                                                     // no reservation yet, we are in pressure order
+				_reserve(*rsa) ;
+				return false ;
+			}
+			if (!fit_now(rsa)) return false ;
+			if ( +exec_time && Pdate(New)+exec_time<=_reserved_date ) {                                             // job ends before reservation
+				_n_backfilled++ ;
+				return true ;
+			}
+			RsrcsData rsd = rsa->within(occupied,capacity_) ;                                                       // this is what acquire_rsrcs will acquire
+			if (!rsd.fit_in(_spare)) return false ;
+			_spare -= rsd ;                                                                                         // job uses resources that are not needed by reserved job
+			_n_backfilled++ ;
+			return true ;
+		}
 		virtual Rsrcs acquire_rsrcs(RsrcsAsk const& rsa) const {
 			RsrcsData rsd = rsa->within(occupied,capacity_) ;
+			_account() ;
 			occupied += rsd ;
+			_n_launched++ ;
 			Trace trace(BeChnl,"occupied_rsrcs",rsd,'+',occupied) ;
 			return {New,rsd} ;
 		}
 		virtual void end_rsrcs(Rsrcs const& rs) const {
+			_account() ;
 			occupied -= *rs ;
 			Trace trace(BeChnl,"occupied_rsrcs",rs,'-',occupied) ;
 		}
+		virtual void close_req(Req req) {
+			GenericBackend::close_req(req) ;
+			Trace trace(BeChnl,"Local::stats",_n_launched,_n_backfilled,_elapsed) ;
+			for( size_t i=0 ; i<rsrc_keys.size() ; i++ ) trace(rsrc_keys[i],"utilization",_utilization(i)) ;
+		}
 		//
+		// jobs forked from the job_exec pool are not our children, their ids are their negated pids
 		virtual ::string start_job( Job , SpawnedEntry const& e ) const {
-			return "pid:"s+e.id.load() ;
+			return "pid:"s+::abs(e.id.load()) ;
 		}
 		virtual ::pair_s<bool/*retry*/> end_job( Job , SpawnedEntry const& se , Status ) const {
-			_wait_queue.push(se.id) ;                                                                               // defer wait in case job_exec process does some time consuming book-keeping
+			if (se.id>0) _wait_queue.push(se.id) ;                                                                  // defer wait in case job_exec process does some time consuming book-keeping
+			else         _pool_forget(-se.id) ;
 			return {{},true/*retry*/} ;                                                                             // retry if garbage
 		}
 		virtual ::pair_s<HeartbeatState> heartbeat_queued_job( Job , SpawnedEntry const& se ) const {               // called after job_exec has had time to start
 			SWEAR(se.id) ;
 			int wstatus = 0 ;
+			if (se.id<0) {                                                                                          // pool reaps its jobs and reports their exit status
+				Lock lock { _pool_mutex } ;
+				_pool_recv(false/*block*/) ;
+				auto it = _pool_jobs.find(-se.id) ;
+				if (it==_pool_jobs.end()) return {{}/*msg*/,kill_process(-se.id,0)?HeartbeatState::Alive:HeartbeatState::Lost} ; // pool is gone and cannot report, best effort
+				if (!it->second         ) return {{}/*msg*/,HeartbeatState::Alive} ;                                // process is still alive
+				wstatus = *it->second ;
+				_pool_jobs.erase(it) ;
+				if (!wstatus_ok(wstatus)) return {{}/*msg*/,HeartbeatState::Err  } ;
+				else                      return {{}/*msg*/,HeartbeatState::Lost } ;
+			}
 			if      (::waitpid(se.id,&wstatus,WNOHANG)==0) return {{}/*msg*/,HeartbeatState::Alive} ;               // process is still alive
 			else if (!wstatus_ok(wstatus)                ) return {{}/*msg*/,HeartbeatState::Err  } ;               // process just died with an error
 			else                                           return {{}/*msg*/,HeartbeatState::Lost } ;               // process died long before (already waited) or just died with no error
 		}
 		virtual void kill_queued_job(SpawnedEntry const& se) const {
 			if (!se.live) return ;
-			kill_process(se.id,SIGHUP) ;                                                                            // jobs killed here have not started yet, so we just want to kill job_exec
-			_wait_queue.push(se.id) ;                                                                               // defer wait in case job_exec process does some time consuming book-keeping
+			kill_process(::abs(se.id),SIGHUP) ;                                                                     // jobs killed here have not started yet, so we just want to kill job_exec
+			if (se.id>0) _wait_queue.push(se.id) ;                                                                  // defer wait in case job_exec process does some time consuming book-keeping
+			else         _pool_forget(-se.id) ;
 		}
 		virtual pid_t launch_job( ::stop_token , Job , ::vector<ReqIdx> const& , Pdate /*prio*/ , ::vector_s const& cmd_line , Rsrcs const& , bool /*verbose*/ ) const {
+			if (pool)
+				try                       { return -_pool_launch(cmd_line) ;                    }
+				catch (::string const& e) { Trace trace(BeChnl,"pool_err",e) ; _pool_close() ; } // pool is not usable, spawn job directly and restart pool next time
 			Child child { .as_session=true , .cmd_line=cmd_line , .stdin_fd=Child::NoneFd , .stdout_fd=Child::NoneFd } ;
 			child.spawn() ;
 			pid_t pid = child.pid ;
@@ -195,14 +266,112 @@ namespace Backends::Local {
 			return pid ;
 		}
 
+	private :
+		pid_t _pool_launch(::vector_s const& cmd_line) const {
+			Lock lock { _pool_mutex } ;
+			if (!_pool_pid) {
+				Child child { .as_session=true , .cmd_line={cmd_line[0]} , .stdin_fd=Child::PipeFd , .stdout_fd=Child::PipeFd } ; // job_exec with no argument is a pool
+				child.spawn() ;
+				_pool_pid = child.pid                ;
+				_pool_in  = ::move(child.stdin ) ; _pool_in .cloexec() ;                                            // pool must see eof when we close it, even if jobs are spawned in between
+				_pool_out = ::move(child.stdout) ; _pool_out.cloexec() ;                                            // .
+				child.mk_daemon() ;                                                                                 // we have recorded the pid to wait and the fds to communicate
+				Trace trace(BeChnl,"pool_start",_pool_pid) ;
+			}
+			OMsgBuf().send( _pool_in , cmd_line ) ;
+			pid_t pid = _pool_recv(true/*block*/) ;
+			if (pid<=0) throw "cannot fork job from job_exec pool"s ;
+			return pid ;
+		}
+		// record exit status reported by pool, return pid of forked job_exec if one is reported (waiting for it if block), 0 otherwise
+		pid_t _pool_recv(bool block) const {
+			if (!_pool_pid) return 0 ;
+			for(;;) {
+				struct pollfd pfd { .fd=_pool_out , .events=POLLIN , .revents=0 } ;
+				if ( !block && ::poll(&pfd,1,0/*timeout*/)<=0 ) return 0 ;
+				JobPoolMsg msg ;
+				if (::read(_pool_out,&msg,sizeof(msg))!=sizeof(msg)) return -1 ;                                  // pool is dead
+				if (!msg.exited) {
+					if (msg.pid>0) _pool_jobs[msg.pid] = {} ;                                                       // record before its exit status may be reported
+					return msg.pid ;
+				}
+				auto it = _pool_jobs.find(msg.pid) ;
+				if (it!=_pool_jobs.end()) it->second = msg.wstatus ;                                                // else job is already forgotten
+			}
+		}
+		void _pool_forget(pid_t pid) const {
+			Lock lock { _pool_mutex } ;
+			_pool_jobs.erase(pid) ;
+		}
+		void _pool_close() const {
+			Lock lock { _pool_mutex } ;
+			_pool_in .close() ;                                                                                     // pool exits when it sees eof
+			_pool_out.close() ;
+			if (_pool_pid) _wait_queue.push(_pool_pid) ;
+			_pool_pid = 0 ;
+			_pool_jobs.clear() ;                                                                                    // pool can no more report, jobs are probed for liveness
+		}
+		void _reserve(RsrcsDataAsk const& rsda) const {
+			Pdate                                    now  { New } ;
+			::vector<::pair<Pdate,RsrcsData const*>> etas ;                                                        // running jobs sorted by estimated end date
+			for( auto const& [_,se] : spawned_jobs ) {
+				if (!se.live) continue ;
+				etas.emplace_back( +se.exec_time ? ::max(se.date+se.exec_time,now) : Pdate::Future , &*se.rsrcs ) ; // jobs with unknown exec time are assumed to end last
+			}
+			::sort( etas , [](::pair<Pdate,RsrcsData const*> const& a , ::pair<Pdate,RsrcsData const*> const& b )->bool { return a.first<b.first ; } ) ;
+			RsrcsData occ = occupied ;
+			_reserved_date = now ;
+			for( auto const& [eta,rsd] : etas ) {
+				if (rsda.fit_in(occ,capacity_)) break ;
+				occ            -= *rsd ;
+				_reserved_date  = eta  ;
+			}
+			_reserved = true ;
+			if (rsda.fit_in(occ,capacity_)) { _spare = capacity_ ; _spare -= occ ; _spare -= rsda.min() ; }
+			else                            { _spare = RsrcsData(capacity_.size()) ; _reserved_date = now ; } // cannot happen if spawned jobs account for all occupied resources, be conservative
+			Trace trace(BeChnl,"reserve",rsda,_reserved_date,_spare) ;
+		}
+		void _account() const {                                                                                     // accumulate resource usage while there is work to do
+			Pdate now { New } ;
+			if ( +_account_date && ( +spawned_jobs || +waiting_jobs ) ) {
+				double dt = double(now-_account_date) ;
+				for( size_t i=0 ; i<occupied.size() ; i++ ) _usage[i] += occupied[i]*dt ;
+				_elapsed += dt ;
+			}
+			_account_date = now ;
+		}
+		double _utilization(size_t i) const {
+			if ( !_elapsed || !capacity_[i] ) return 0 ;
+			return _usage[i] / (capacity_[i]*_elapsed) ;
+		}
+
 		// data
+	public :
 		::umap_s<size_t>  rsrc_idxs       ;
 		::vector_s        rsrc_keys       ;
 		RsrcsData         capacity_       ;
 		RsrcsData mutable occupied        ;
 		::vmap_s<size_t>  public_capacity ;
+		bool              backfill        = false ;                                                                 // if true, jobs that do not fit reserve resources and smaller jobs only run ahead if they dont delay them
+		bool              pool            = false ;                                                                 // if true, jobs are forked from a pre-started job_exec rather than spawned
 	private :
 		DequeThread<pid_t> mutable _wait_queue ;
+		// job_exec pool, accessed from launch and heartbeat threads under _pool_mutex
+		Mutex<MutexLvl::JobPool>      mutable _pool_mutex ;
+		pid_t                         mutable _pool_pid   = 0 ;
+		AutoCloseFd                   mutable _pool_in    ;                                                         // to   pool : job command lines
+		AutoCloseFd                   mutable _pool_out   ;                                                         // from pool : forked pids and exit status of forked jobs
+		::umap<pid_t,::optional<int>> mutable _pool_jobs  ;                                                         // exit status, if reported, of live jobs forked from pool
+		// backfill, only accessed from launch thread
+		bool      mutable _reserved      = false ;                                                                  // if true <=> a job that does not fit has reserved resources during current launch round
+		Pdate     mutable _reserved_date ;                                                                          // date at which reserved job is expected to fit
+		RsrcsData mutable _spare         ;                                                                          // resources available at _reserved_date that reserved job does not need
+		// stats
+		JobIdx           mutable _n_launched   = 0 ;
+		JobIdx           mutable _n_backfilled = 0 ;                                                                // number of jobs launched ahead of a reserved job
+		Pdate            mutable _account_date ;
+		double           mutable _elapsed      = 0 ;                                                                // time during which there was work to do
+		::vector<double> mutable _usage        ;                                                                    // integral of occupied resources over _elapsed
 
 	} ;
 
@@ -73,7 +73,18 @@ namespace std {
 
 namespace Backends::Sge {
 
-	using SgeId = uint32_t ;
+	// array tasks are identified by their array job id in the low 32 bits and their task index in the high 32 bits, plain jobs have a null task index
+	using SgeId = uint64_t ;
+	inline SgeId    mk_sge_id ( uint32_t job , uint32_t task=0 ) { return SgeId(task)<<32 | job ; }
+	inline uint32_t sge_job_id(SgeId id                        ) { return uint32_t(id)           ; }
+	inline uint32_t sge_task  (SgeId id                        ) { return uint32_t(id>>32)       ; }
+	inline ::string sge_id_str(SgeId id                        ) {
+		::string res = ::to_string(sge_job_id(id)) ;
+		if (sge_task(id)) res <<'.'<< sge_task(id) ;                                                      // this is the syntax understood by qdel
+		return res ;
+	}
+
+	static constexpr size_t MaxArrayCmdSz = 1<<20 ; // max size of task command lines in a single qsub, so as to stay well within ARG_MAX
 
 	Mutex<MutexLvl::Sge> _sge_mutex ; // ensure no more than a single outstanding request to daemon
 
@@ -133,7 +144,8 @@ namespace Backends::Sge {
 						/**/       if (k=="cluster"          ) { sge_cluster       =                       v  ; continue ; }
 						/**/       if (k=="cpu_resource"     ) { cpu_rsrc          =                       v  ; continue ; } break ;
 						case 'd' : if (k=="default_prio"     ) { dflt_prio         = from_string<int16_t >(v) ; continue ; } break ;
-						case 'm' : if (k=="mem_resource"     ) { mem_rsrc          =                       v  ; continue ; } break ;
+						case 'm' : if (k=="max_array_sz"     ) { max_array_sz      = from_string<uint32_t>(v) ; continue ; }
+						/**/       if (k=="mem_resource"     ) { mem_rsrc          =                       v  ; continue ; } break ;
 						case 'n' : if (k=="n_max_queued_jobs") { n_max_queued_jobs = from_string<uint32_t>(v) ; continue ; } break ;
 						case 'r' : if (k=="repo_key"         ) { repo_key          =                       v  ; continue ; }
 						/**/       if (k=="root_dir"         ) { sge_root_dir_s    = with_slash           (v) ; continue ; } break ;
@@ -195,37 +207,96 @@ namespace Backends::Sge {
 		}
 		virtual ::string start_job( Job , SpawnedEntry const& se ) const {
 			SWEAR(+se.rsrcs) ;
-			return "sge_id:"s+se.id.load() ;
+			return "sge_id:"+sge_id_str(se.id) ;
 		}
 		// XXX : implement end_job to give explanations if verbose (mimic slurm)
 		virtual ::pair_s<HeartbeatState> heartbeat_queued_job( Job , SpawnedEntry const& se ) const {
-			if (sge_exec_client({"qstat","-j",::to_string(se.id)}).second) return { {}/*msg*/                      , HeartbeatState::Alive } ;
-			else                                                           return { "lost job "+::to_string(se.id) , HeartbeatState::Lost  } ; // XXX : try to distinguish between Lost and Err
+			bool alive ;
+			if (!sge_task(se.id)) {
+				alive = sge_exec_client({"qstat","-j",::to_string(sge_job_id(se.id))}).second ;
+			} else {                                                                                                        // qstat -j only tells array is alive, look for task itself in last qstat -xml
+				uint32_t array = sge_job_id(se.id) ;
+				if (!_qstat_arrays.contains(array)) _qstat({array}) ;                                                       // array was launched after last qstat (or it failed), tasks of array share the new one
+				alive = _qstat_ids.contains(se.id) || _qstat_ids.contains(mk_sge_id(array)) ;
+			}
+			if (alive) return { {}/*msg*/                  , HeartbeatState::Alive } ;
+			else       return { "lost job "+sge_id_str(se.id) , HeartbeatState::Lost  } ;                                   // XXX : try to distinguish between Lost and Err
+		}
+		virtual ::umap<Job,::pair_s<HeartbeatState>> heartbeat_queued_jobs( ::vmap<Job,SpawnedEntry const*> const& jobs ) const {
+			::umap<Job,::pair_s<HeartbeatState>> res    ;
+			::uset<uint32_t>                     arrays ; for( auto const& [_,se] : jobs ) if (sge_task(se->id)) arrays.insert(sge_job_id(se->id)) ;
+			if (!_qstat(::move(arrays))) return res ;                                                                       // no info : jobs are probed individually
+			for( auto const& [j,se] : jobs )
+				if ( _qstat_ids.contains(se->id) || _qstat_ids.contains(mk_sge_id(sge_job_id(se->id))) ) res.try_emplace( j , ::string() , HeartbeatState::Alive ) ; // jobs unknown to daemon are probed individually
+			return res ;
 		}
 		virtual void kill_queued_job(SpawnedEntry const& se) const {
 			if (se.live) _s_sge_cancel_thread.push(::pair(this,se.id.load())) ;                                                                // asynchronous (as faster and no return value) cancel
 		}
-		virtual SgeId launch_job( ::stop_token , Job j , ::vector<ReqIdx> const& reqs , Pdate /*prio*/ , ::vector_s const& cmd_line , Rsrcs const& rs , bool verbose ) const {
-			::vector_s sge_cmd_line = {
+		// a single request to daemon for all jobs, tasks of arrays are recorded individually
+		bool/*ok*/ _qstat(::uset<uint32_t>&& arrays) const {
+			::pair_s<bool/*ok*/> digest = sge_exec_client( {"qstat","-xml"} , true/*gather_stdout*/ ) ;
+			if (digest.second) { _qstat_ids = _s_alive_ids(digest.first,arrays) ; _qstat_arrays = ::move(arrays) ; }
+			else               { _qstat_ids.clear()                           ; _qstat_arrays.clear()            ; }
+			return digest.second ;
+		}
+		// ids alive in qstat -xml output, tasks of jobs in arrays are listed individually, other jobs are listed with task 0
+		static ::uset<SgeId> _s_alive_ids( ::string const& xml , ::uset<uint32_t> const& arrays ) {
+			static constexpr ::string_view IdTag    = "<JB_job_number>" ;
+			static constexpr ::string_view TasksTag = "<tasks>"         ;                                                    // present for array tasks, e.g. 1-10:1 when pending or 4 when running
+			::uset<SgeId> ids ;
+			for( size_t pos=xml.find(IdTag) ; pos!=Npos ;) {
+				pos += IdTag.size() ;
+				size_t end = xml.find('<'  ,pos) ; if (end==Npos) break ;
+				size_t nxt = xml.find(IdTag,end) ;
+				uint32_t job = 0 ;
+				try                     { job = from_string<uint32_t>(::string_view(xml).substr(pos,end-pos)) ; }
+				catch (::string const&) { pos = nxt ; continue ;                                                  }         // ignore garbage
+				size_t tpos = arrays.contains(job) ? xml.find(TasksTag,end) : Npos ;
+				if ( tpos==Npos || tpos>nxt ) {
+					ids.insert(mk_sge_id(job)) ;                                                                            // all tasks of job are alive if it is an array
+				} else {
+					tpos += TasksTag.size() ;
+					::string_view tasks = ::string_view(xml).substr( tpos , xml.find('<',tpos)-tpos ) ;
+					try {
+						for( ::string const& r : split(tasks,',') ) {                                                         // tasks is a list of ranges such as 1-10:2
+							size_t   dash  = r.find('-')                                                                ;
+							size_t   colon = r.find(':')                                                                ;
+							uint32_t first = from_string<uint32_t>(r.substr(0,::min(dash,colon)))                       ;
+							uint32_t last  = dash ==Npos ? first : from_string<uint32_t>(r.substr(dash+1,colon-dash-1)) ;
+							uint32_t step  = colon==Npos ? 1     : from_string<uint32_t>(r.substr(colon+1)            ) ;
+							for( uint32_t t=first ; t<=last ; t+=::max(step,1u) ) ids.insert(mk_sge_id(job,t)) ;
+						}
+					} catch (::string const&) {}                                                                            // ignore garbage
+				}
+				pos = nxt ;
+			}
+			return ids ;
+		}
+		::vector_s _qsub_cmd_line( ::string&& name , ::vector<ReqIdx> const& reqs , Rsrcs const& rs ) const {
+			::vector_s res = {
 				"qsub"
 			,	"-b"     , "y"
 			,	"-o"     , "/dev/null"                                                                                                         // XXX : if verbose, collect stdout/sderr
 			,	"-j"     , "y"
 			,	"-shell" , "n"
 			,	"-terse"
-			,	"-N"     , sge_mk_name(repo_key+Job(j)->name())
+			,	"-N"     , sge_mk_name(::move(name))
 			} ;
 			SWEAR(+reqs) ;                                                                                                                     // why launch a job if for no req ?
 			int16_t prio = ::numeric_limits<int16_t>::min() ; for( ReqIdx r : reqs ) prio = ::max( prio , req_prios[r] ) ;
 			//
-			if ( prio                                             ) { sge_cmd_line.push_back("-p"   ) ; sge_cmd_line.push_back(               to_string(prio     )) ; }
-			if ( +cpu_rsrc && rs->cpu                             ) { sge_cmd_line.push_back("-l"   ) ; sge_cmd_line.push_back(cpu_rsrc+'='+::to_string(rs->cpu  )) ; }
-			if ( +mem_rsrc && rs->mem                             ) { sge_cmd_line.push_back("-l"   ) ; sge_cmd_line.push_back(mem_rsrc+'='+::to_string(rs->mem  )) ; }
-			if ( +tmp_rsrc && (rs->tmp!=0&&rs->tmp!=uint32_t(-1)) ) { sge_cmd_line.push_back("-l"   ) ; sge_cmd_line.push_back(tmp_rsrc+'='+::to_string(rs->tmp  )) ; }
-			for( auto const& [k,v] : rs ->tokens )                  { sge_cmd_line.push_back("-l"   ) ; sge_cmd_line.push_back(k       +'='+::to_string(v        )) ; }
-			if ( +rs->hard                                        ) {                                   for( ::string const& s : rs->hard ) sge_cmd_line.push_back(s) ; }
-			if ( +rs->soft                                        ) { sge_cmd_line.push_back("-soft") ; for( ::string const& s : rs->soft ) sge_cmd_line.push_back(s) ; }
-			//
+			if ( prio                                             ) { res.push_back("-p"   ) ; res.push_back(               to_string(prio     )) ; }
+			if ( +cpu_rsrc && rs->cpu                             ) { res.push_back("-l"   ) ; res.push_back(cpu_rsrc+'='+::to_string(rs->cpu  )) ; }
+			if ( +mem_rsrc && rs->mem                             ) { res.push_back("-l"   ) ; res.push_back(mem_rsrc+'='+::to_string(rs->mem  )) ; }
+			if ( +tmp_rsrc && (rs->tmp!=0&&rs->tmp!=uint32_t(-1)) ) { res.push_back("-l"   ) ; res.push_back(tmp_rsrc+'='+::to_string(rs->tmp  )) ; }
+			for( auto const& [k,v] : rs ->tokens )                  { res.push_back("-l"   ) ; res.push_back(k       +'='+::to_string(v        )) ; }
+			if ( +rs->hard                                        ) {                          for( ::string const& s : rs->hard ) res.push_back(s) ; }
+			if ( +rs->soft                                        ) { res.push_back("-soft") ; for( ::string const& s : rs->soft ) res.push_back(s) ; }
+			return res ;
+		}
+		virtual SgeId launch_job( ::stop_token , Job j , ::vector<ReqIdx> const& reqs , Pdate /*prio*/ , ::vector_s const& cmd_line , Rsrcs const& rs , bool verbose ) const {
+			::vector_s sge_cmd_line = _qsub_cmd_line( repo_key+Job(j)->name() , reqs , rs ) ;
 			for( ::string const& c : cmd_line ) sge_cmd_line.push_back(c) ;
 			//
 			::pair_s<bool/*ok*/> digest = sge_exec_client( ::move(sge_cmd_line) , true/*gather_stdout*/ ) ;                                    // need to gather sge id
@@ -233,6 +304,38 @@ namespace Backends::Sge {
 			if (!digest.second) throw "cannot submit SGE job "+Job(j)->name() ;
 			return from_string<SgeId>(digest.first) ;
 		}
+		virtual size_t launch_batch_sz() const { return max_array_sz ; }
+		// submit jobs as arrays, task i runs the i-th command line, passed as a shell quoted positional argument
+		static constexpr char TaskScript[] = R"(shift $((SGE_TASK_ID-1)) ; eval "exec $1")" ;
+		virtual ::vector<SgeId> launch_jobs( ::stop_token st , ::vector<LaunchDescr const*> const& descrs , Rsrcs const& rs , bool verbose ) const {
+			if (descrs.size()==1) return Base::launch_jobs(st,descrs,rs,verbose) ;                                                           // no need for an array
+			::vector<SgeId> res ; res.reserve(descrs.size()) ;
+			for( size_t i=0 ; i<descrs.size() ;) {
+				::vector<ReqIdx> reqs  ;
+				::vector_s       tasks ;
+				size_t           sz    = 0 ;
+				for(; i<descrs.size() ; i++ ) {
+					::string task ; First first ; for( ::string const& c : descrs[i]->cmd_line ) task <<first(""," ")<< mk_shell_str(c) ;
+					if ( +tasks && sz+task.size()>MaxArrayCmdSz ) break ;                                                                      // split array to fit in qsub command line
+					sz += task.size() ;
+					tasks.push_back(::move(task)) ;
+					for( ReqIdx r : descrs[i]->reqs ) if (::find(reqs.begin(),reqs.end(),r)==reqs.end()) reqs.push_back(r) ;
+				}
+				Job        j0           = descrs[i-tasks.size()]->job                            ;                                            // array is named after its first job
+				::vector_s sge_cmd_line = _qsub_cmd_line( repo_key+j0->name() , reqs , rs ) ;
+				sge_cmd_line.insert( sge_cmd_line.end() , { "-t" , "1-"+::to_string(tasks.size()) , "/bin/sh" , "-c" , TaskScript , "sh"/*$0*/ } ) ;
+				for( ::string& t : tasks ) sge_cmd_line.push_back(::move(t)) ;
+				//
+				::pair_s<bool/*ok*/> digest = sge_exec_client( ::move(sge_cmd_line) , true/*gather_stdout*/ ) ;                                // need to gather sge id
+				Trace trace(BeChnl,"Sge::launch_jobs",repo_key,j0,tasks.size(),digest,rs,STR(verbose)) ;
+				uint32_t array_id = 0 ;
+				if (digest.second)
+					try                     { array_id = from_string<uint32_t>(digest.first.substr(0,digest.first.find('.'))) ; }                // qsub -terse reports <id>.<tasks> for arrays
+					catch (::string const&) { trace("bad_id") ;                                                                     }
+				for( uint32_t t=1 ; t<=tasks.size() ; t++ ) res.push_back( array_id ? mk_sge_id(array_id,t) : 0 ) ;                            // null id marks a job that could not be launched
+			}
+			return res ;
+		}
 
 		::pair_s<bool/*ok*/> sge_exec_client( ::vector_s&& cmd_line , bool gather_stdout=false ) const {
 			::map_ss add_env = { { "SGE_ROOT" , no_slash(sge_root_dir_s) } } ;
@@ -260,19 +363,23 @@ namespace Backends::Sge {
 		}
 
 		// data
-		SpawnedMap mutable spawned_rsrcs     ;      // number of spawned jobs queued in sge queue
-		::vector<int16_t>  req_prios         ;      // indexed by req
-		uint32_t           n_max_queued_jobs = -1 ; // no limit by default
-		::string           repo_key          ;      // a short identifier of the repository
-		int16_t            dflt_prio         = 0  ; // used when not specified with lmake -b
-		::string           cpu_rsrc          ;      // key to use to ask for cpu
-		::string           mem_rsrc          ;      // key to use to ask for memory (in MB)
-		::string           tmp_rsrc          ;      // key to use to ask for tmp    (in MB)
+		SpawnedMap mutable spawned_rsrcs     ;        // number of spawned jobs queued in sge queue
+		::vector<int16_t>  req_prios         ;        // indexed by req
+		uint32_t           n_max_queued_jobs = -1   ; // no limit by default
+		uint32_t           max_array_sz      = 1000 ; // max number of jobs submitted as a single array, 1 means no arrays
+		::string           repo_key          ;        // a short identifier of the repository
+		int16_t            dflt_prio         = 0    ; // used when not specified with lmake -b
+		::string           cpu_rsrc          ;        // key to use to ask for cpu
+		::string           mem_rsrc          ;        // key to use to ask for memory (in MB)
+		::string           tmp_rsrc          ;        // key to use to ask for tmp    (in MB)
 		::string           sge_bin_dir_s     ;
 		::string           sge_cell          ;
 		::string           sge_cluster       ;
 		::string           sge_root_dir_s    ;
-		Daemon             daemon            ;      // info sensed from sge daemon
+		Daemon             daemon            ;        // info sensed from sge daemon
+		// last qstat -xml, only accessed from heartbeat thread
+		::uset<SgeId>    mutable _qstat_ids    ;
+		::uset<uint32_t> mutable _qstat_arrays ; // arrays whose tasks are listed in _qstat_ids
 	} ;
 
 	DequeThread<::pair<SgeBackend const*,SgeId>> SgeBackend::_s_sge_cancel_thread ;
@@ -385,7 +492,7 @@ namespace Backends::Sge {
 
 
 	void sge_cancel(::pair<SgeBackend const*,SgeId> const& info) {
-		info.first->sge_exec_client({"qdel",to_string(info.second)}) ; // if error, job is most certainly already dead, nothing to do
+		info.first->sge_exec_client({"qdel",sge_id_str(info.second)}) ; // if error, job is most certainly already dead, nothing to do
 	}
 
 	::string sge_mk_name(::string&& s) {
@@ -92,7 +92,16 @@ namespace std {
 
 namespace Backends::Slurm {
 
-	using SlurmId = uint32_t ;
+	// array tasks are identified by their array job id in the low 32 bits and their task index in the high 32 bits, plain jobs have a null task index
+	using SlurmId = uint64_t ;
+	inline SlurmId  mk_slurm_id ( uint32_t job , uint32_t task=0 ) { return SlurmId(task)<<32 | job ; }
+	inline uint32_t slurm_job_id(SlurmId id                        ) { return uint32_t(id)             ; }
+	inline uint32_t slurm_task  (SlurmId id                        ) { return uint32_t(id>>32)         ; }
+	inline ::string slurm_id_str(SlurmId id                        ) {
+		::string res = ::to_string(slurm_job_id(id)) ;
+		if (slurm_task(id)) res <<'_'<< slurm_task(id) ;                                                      // this is the syntax understood by scancel
+		return res ;
+	}
 
 	Mutex<MutexLvl::Slurm> _slurm_mutex ; // ensure no more than a single outstanding request to daemon
 
@@ -101,10 +110,11 @@ namespace Backends::Slurm {
 	RsrcsData                 parse_args        (::string const& args    ) ;
 	void                      slurm_cancel      (SlurmId         slurm_id) ;
 	::pair_s<Bool3/*job_ok*/> slurm_job_state   (SlurmId         slurm_id) ;
+	::umap<SlurmId,::pair_s<Bool3/*job_ok*/>> slurm_job_states(::uset<SlurmId> const& slurm_ids) ;
 	::string                  read_stderr       (Job                     ) ;
 	Daemon                    slurm_sense_daemon(                        ) ;
 	//
-	SlurmId slurm_spawn_job( ::stop_token , ::string const& key , Job , ::vector<ReqIdx> const& , int32_t nice , ::vector_s const& cmd_line , RsrcsData const& rsrcs , bool verbose ) ;
+	SlurmId slurm_spawn_job( ::stop_token , ::string const& key , Job , ::vector<ReqIdx> const& , int32_t nice , ::vector<::vector_s const*> const& cmd_lines , RsrcsData const& rsrcs , bool verbose ) ;
 
 	constexpr Tag MyTag = Tag::Slurm ;
 
@@ -153,6 +163,7 @@ namespace Backends::Slurm {
 				try {
 					switch (k[0]) {
 						case 'c' : if(k=="config"           ) { config_file       = v.c_str()                ; continue ; } break ;
+						case 'm' : if(k=="max_array_sz"     ) { max_array_sz      = from_string<uint32_t>(v) ; continue ; } break ;
 						case 'n' : if(k=="n_max_queued_jobs") { n_max_queued_jobs = from_string<uint32_t>(v) ; continue ; } break ;
 						case 'r' : if(k=="repo_key"         ) { repo_key          =                       v  ; continue ; } break ;
 						case 'u' : if(k=="use_nice"         ) { use_nice          = from_string<bool    >(v) ; continue ; } break ;
@@ -216,7 +227,7 @@ namespace Backends::Slurm {
 		}
 		virtual ::string start_job( Job , SpawnedEntry const& se ) const {
 			SWEAR(+se.rsrcs) ;
-			return "slurm_id:"s+se.id.load() ;
+			return "slurm_id:"+slurm_id_str(se.id) ;
 		}
 		virtual ::pair_s<bool/*retry*/> end_job( Job j , SpawnedEntry const& se , Status s ) const {
 			if ( !se.verbose && s==Status::Ok ) return {{},true/*retry*/} ;                          // common case, must be fast, if job is in error, better to ask slurm why, e.g. could be OOM
@@ -242,7 +253,19 @@ namespace Backends::Slurm {
 			return { info.first , info.second!=No } ;
 		}
 		virtual ::pair_s<HeartbeatState> heartbeat_queued_job( Job j , SpawnedEntry const& se ) const {
-			::pair_s<Bool3/*job_ok*/> info = slurm_job_state(se.id) ;
+			return _mk_heartbeat( j , se , slurm_job_state(se.id) ) ;
+		}
+		virtual ::umap<Job,::pair_s<HeartbeatState>> heartbeat_queued_jobs( ::vmap<Job,SpawnedEntry const*> const& jobs ) const {
+			::uset<SlurmId> ids ; for( auto const& [_,se] : jobs ) ids.insert(se->id) ;
+			::umap<SlurmId,::pair_s<Bool3/*job_ok*/>> infos = slurm_job_states(ids) ;                        // a single request to daemon for all jobs
+			::umap<Job,::pair_s<HeartbeatState>>      res   ;
+			for( auto const& [j,se] : jobs ) {
+				auto it = infos.find(se->id) ;
+				if (it!=infos.end()) res.try_emplace( j , _mk_heartbeat(j,*se,::move(it->second)) ) ;         // jobs unknown to daemon are probed individually
+			}
+			return res ;
+		}
+		::pair_s<HeartbeatState> _mk_heartbeat( Job j , SpawnedEntry const& se , ::pair_s<Bool3/*job_ok*/>&& info ) const {
 			if (info.second==Maybe) return {{}/*msg*/,HeartbeatState::Alive} ;
 			//
 			if ( se.verbose && +info.first ) {                       // XXX : only read stderr when something to say as what appears to be a filesystem bug (seen with ceph) sometimes blocks !
@@ -255,18 +278,42 @@ namespace Backends::Slurm {
 		virtual void kill_queued_job(SpawnedEntry const& se) const {
 			if (se.live) _s_slurm_cancel_thread.push(se.id) ;        // asynchronous (as faster and no return value) cancel
 		}
+		int32_t _nice(Pdate prio) const {
+			int32_t res = use_nice ? int32_t((prio-daemon.time_origin).sec()*daemon.nice_factor) : 0 ;
+			return res & 0x7fffffff ;                                                                   // slurm will not accept negative values, default values overflow in ... 2091
+		}
 		virtual SlurmId launch_job( ::stop_token st , Job j , ::vector<ReqIdx> const& reqs , Pdate prio , ::vector_s const& cmd_line , Rsrcs const& rs , bool verbose ) const {
-			int32_t nice = use_nice ? int32_t((prio-daemon.time_origin).sec()*daemon.nice_factor) : 0 ;
-			nice &= 0x7fffffff ;                                                                         // slurm will not accept negative values, default values overflow in ... 2091
-			SlurmId id = slurm_spawn_job( st , repo_key , j , reqs , nice , cmd_line , *rs , verbose ) ;
+			int32_t nice = _nice(prio)                                                                   ;
+			SlurmId id   = slurm_spawn_job( st , repo_key , j , reqs , nice , {&cmd_line} , *rs , verbose ) ;
 			Trace trace(BeChnl,"Slurm::launch_job",repo_key,j,id,nice,cmd_line,rs,STR(verbose)) ;
 			return id ;
 		}
+		virtual size_t launch_batch_sz() const { return max_array_sz ; }
+		// submit jobs as an array, task i runs the i-th command line
+		virtual ::vector<SlurmId> launch_jobs( ::stop_token st , ::vector<LaunchDescr const*> const& descrs , Rsrcs const& rs , bool verbose ) const {
+			if ( descrs.size()==1 || verbose || rs->size()>1 ) return Base::launch_jobs(st,descrs,rs,verbose) ; // stdout/stderr files are per job and slurm does not support arrays of heterogeneous jobs
+			::vector<ReqIdx>             reqs      ;
+			::vector<::vector_s const*>  cmd_lines ;
+			Pdate                        prio      = Pdate::Future ;
+			for( LaunchDescr const* ld : descrs ) {
+				for( ReqIdx r : ld->reqs ) if (::find(reqs.begin(),reqs.end(),r)==reqs.end()) reqs.push_back(r) ;
+				cmd_lines.push_back(&ld->cmd_line) ;
+				prio = ::min( prio , ld->prio ) ;                                                      // array is as urgent as its most urgent job
+			}
+			Job      j0       = descrs[0]->job                                                          ; // array is named after its first job
+			int32_t  nice     = _nice(prio)                                                             ;
+			SlurmId  array_id = slurm_spawn_job( st , repo_key , j0 , reqs , nice , cmd_lines , *rs , verbose ) ;
+			Trace trace(BeChnl,"Slurm::launch_jobs",repo_key,j0,descrs.size(),array_id,nice,rs) ;
+			::vector<SlurmId> res ; res.reserve(descrs.size()) ;
+			for( uint32_t t=1 ; t<=descrs.size() ; t++ ) res.push_back(mk_slurm_id(slurm_job_id(array_id),t)) ;
+			return res ;
+		}
 
 		// data
 		SpawnedMap mutable  spawned_rsrcs     ;         // number of spawned jobs queued in slurm queue
 		::vector<RsrcsData> req_forces        ;         // indexed by req, resources forced by req
 		uint32_t            n_max_queued_jobs = -1    ; // no limit by default
+		uint32_t            max_array_sz      = 1000  ; // max number of jobs submitted as a single array, 1 means no arrays
 		bool                use_nice          = false ;
 		::string            repo_key          ;         // a short identifier of the repository
 		Daemon              daemon            ;         // info sensed from slurm daemon
@@ -390,11 +437,13 @@ namespace Backends::Slurm {
 		decltype(::slurm_init                             )* init                              = nullptr/*garbage*/ ;
 		decltype(::slurm_init_job_desc_msg                )* init_job_desc_msg                 = nullptr/*garbage*/ ;
 		decltype(::slurm_kill_job                         )* kill_job                          = nullptr/*garbage*/ ;
+		decltype(::slurm_kill_job2                        )* kill_job2                         = nullptr/*garbage*/ ;
 		decltype(::slurm_load_ctl_conf                    )* load_ctl_conf                     = nullptr/*garbage*/ ;
 		decltype(::slurm_list_append                      )* list_append                       = nullptr/*garbage*/ ;
 		decltype(::slurm_list_create                      )* list_create                       = nullptr/*garbage*/ ;
 		decltype(::slurm_list_destroy                     )* list_destroy                      = nullptr/*garbage*/ ;
 		decltype(::slurm_load_job                         )* load_job                          = nullptr/*garbage*/ ;
+		decltype(::slurm_load_job_user                    )* load_job_user                     = nullptr/*garbage*/ ;
 		decltype(::slurm_strerror                         )* strerror                          = nullptr/*garbage*/ ;
 		decltype(::slurm_submit_batch_het_job             )* submit_batch_het_job              = nullptr/*garbage*/ ;
 		decltype(::slurm_submit_batch_job                 )* submit_batch_job                  = nullptr/*garbage*/ ;
@@ -417,11 +466,13 @@ namespace Backends::Slurm {
 		_load_func( handler , SlurmApi::init                              , "slurm_init"                              ) ;
 		_load_func( handler , SlurmApi::init_job_desc_msg                 , "slurm_init_job_desc_msg"                 ) ;
 		_load_func( handler , SlurmApi::kill_job                          , "slurm_kill_job"                          ) ;
+		_load_func( handler , SlurmApi::kill_job2                         , "slurm_kill_job2"                         ) ;
 		_load_func( handler , SlurmApi::load_ctl_conf                     , "slurm_load_ctl_conf"                     ) ;
 		_load_func( handler , SlurmApi::list_append                       , "slurm_list_append"                       ) ;
 		_load_func( handler , SlurmApi::list_create                       , "slurm_list_create"                       ) ;
 		_load_func( handler , SlurmApi::list_destroy                      , "slurm_list_destroy"                      ) ;
 		_load_func( handler , SlurmApi::load_job                          , "slurm_load_job"                          ) ;
+		_load_func( handler , SlurmApi::load_job_user                     , "slurm_load_job_user"                     ) ;
 		_load_func( handler , SlurmApi::strerror                          , "slurm_strerror"                          ) ;
 		_load_func( handler , SlurmApi::submit_batch_het_job              , "slurm_submit_batch_het_job"              ) ;
 		_load_func( handler , SlurmApi::submit_batch_job                  , "slurm_submit_batch_job"                  ) ;
@@ -519,7 +570,9 @@ namespace Backends::Slurm {
 		int i = 0/*garbage*/ ;
 		Lock lock { _slurm_mutex } ;
 		for( i=0 ; i<SlurmCancelTrials ; i++ ) {
-			if (SlurmApi::kill_job(slurm_id,SIGKILL,KILL_FULL_JOB)==SLURM_SUCCESS) { trace("done") ; return ; }
+			int rc = slurm_task(slurm_id) ? SlurmApi::kill_job2( slurm_id_str(slurm_id).c_str() , SIGKILL , KILL_FULL_JOB , nullptr/*sibling*/ ) // only kill this task of the array
+			       :                        SlurmApi::kill_job ( slurm_job_id(slurm_id)         , SIGKILL , KILL_FULL_JOB                      ) ;
+			if (rc==SLURM_SUCCESS) { trace("done") ; return ; }
 			switch (errno) {
 				case ESLURM_INVALID_JOB_ID             :
 				case ESLURM_ALREADY_DONE               : trace("already_dead",errno) ;                return ;
@@ -531,59 +584,101 @@ namespace Backends::Slurm {
 		FAIL("cannot cancel job ",slurm_id," after ",i," retries : ",slurm_err()) ;
 	}
 
+	// accumulate state of a job component into state (initially {{},Yes}), return true if state is final
+	static bool/*done*/ _acc_job_state( ::pair_s<Bool3/*job_ok*/>& state , slurm_job_info_t const* ji ) {
+		::string& msg = state.first  ;
+		Bool3   & ok  = state.second ;
+		job_states js = job_states( ji->job_state & JOB_STATE_BASE ) ;
+		switch (js) {
+			// if slurm sees job failure, somthing weird occurred (if actual job fails, job_exec reports an error and completes successfully)
+			// possible job_states values (from slurm.h) :
+			case JOB_PENDING   :                              ok = Maybe ; return false ;                         // queued waiting for initiation
+			case JOB_RUNNING   :                              ok = Maybe ; return false ;                         // allocated resources and executing
+			case JOB_SUSPENDED :                              ok = Maybe ; return false ;                         // allocated resources, execution suspended
+			case JOB_COMPLETE  :                                           return false ;                         // completed execution successfully
+			case JOB_CANCELLED : msg = "cancelled by user"s ; ok = Yes   ; goto Done ;                            // cancelled by user
+			case JOB_TIMEOUT   : msg = "timeout"s           ; ok = No    ; goto Done ;                            // terminated on reaching time limit
+			case JOB_NODE_FAIL : msg = "node failure"s      ; ok = Yes   ; goto Done ;                            // terminated on node failure
+			case JOB_PREEMPTED : msg = "preempted"s         ; ok = Yes   ; goto Done ;                            // terminated due to preemption
+			case JOB_BOOT_FAIL : msg = "boot failure"s      ; ok = Yes   ; goto Done ;                            // terminated due to node boot failure
+			case JOB_DEADLINE  : msg = "deadline reached"s  ; ok = Yes   ; goto Done ;                            // terminated on deadline
+			case JOB_OOM       : msg = "out of memory"s     ; ok = No    ; goto Done ;                            // experienced out of memory error
+			//   JOB_END                                                                                          // not a real state, last entry in table
+			case JOB_FAILED :                                                                                     // completed execution unsuccessfully
+				// when job_exec receives a signal, the bash process which launches it (which the process seen by slurm) exits with an exit code > 128
+				// however, the user is interested in the received signal, not mapped bash exit code, so undo mapping
+				// signaled wstatus are barely the signal number
+				/**/                                      msg = "failed ("                                                                                           ;
+				if      (WIFSIGNALED(ji->exit_code)     ) msg << "signal " << WTERMSIG(ji->exit_code)           <<'-'<< ::strsignal(WTERMSIG(ji->exit_code)        ) ;
+				else if (!WIFEXITED(ji->exit_code)      ) msg << "??"                                                                                                ; // weird, could be a FAIL
+				else if (WEXITSTATUS(ji->exit_code)>0x80) msg << "signal " << (WEXITSTATUS(ji->exit_code)-0x80) <<'-'<< ::strsignal(WEXITSTATUS(ji->exit_code)-0x80) ; // cf comment above
+				else if (WEXITSTATUS(ji->exit_code)!=0  ) msg << "exit "   << WEXITSTATUS(ji->exit_code)                                                             ;
+				else                                      msg << "ok"                                                                                                ;
+				/**/                                      msg << ')'                                                                                                 ;
+				ok = No ;
+				goto Done ;
+			default : FAIL("Slurm : wrong job state return for job (",ji->job_id,") : ",js) ;
+		}
+	Done :
+		if ( +msg && ji->nodes ) msg << (::strchr(ji->nodes,' ')==nullptr?" on node : ":" on nodes : ") << ji->nodes ;
+		return true ;
+	}
+
 	::pair_s<Bool3/*job_ok*/> slurm_job_state(SlurmId slurm_id) {                                                     // Maybe means job has not completed
 		Trace trace(BeChnl,"slurm_job_state",slurm_id) ;
 		SWEAR(slurm_id) ;
 		job_info_msg_t* resp = nullptr/*garbage*/ ;
 		{	Lock lock { _slurm_mutex } ;
-			if (SlurmApi::load_job(&resp,slurm_id,SHOW_LOCAL)!=SLURM_SUCCESS) switch (errno) {
+			if (SlurmApi::load_job(&resp,slurm_job_id(slurm_id),SHOW_LOCAL)!=SLURM_SUCCESS) switch (errno) {
 				case EAGAIN                              :
 				case ESLURM_ERROR_ON_DESC_TO_RECORD_COPY : //!                                             job_ok
 				case ESLURM_NODES_BUSY                   : return { "slurm daemon busy : "   +slurm_err() , Maybe } ; // no info : heartbeat will retry, end will eventually cancel
 				default                                  : return { "cannot load job info : "+slurm_err() , Yes   } ;
 			}
 		}
-		::string                msg ;
-		Bool3                   ok  = Yes     ;
-		slurm_job_info_t const* ji  = nullptr ;
+		::pair_s<Bool3/*job_ok*/> res     { {} , Yes } ;
+		bool                      found   = false      ;
+		bool                      pending = false      ;
 		for ( uint32_t i=0 ; i<resp->record_count ; i++ ) {
-			ji = &resp->job_array[i] ;
-			job_states js = job_states( ji->job_state & JOB_STATE_BASE ) ;
-			switch (js) {
-				// if slurm sees job failure, somthing weird occurred (if actual job fails, job_exec reports an error and completes successfully)
-				// possible job_states values (from slurm.h) :
-				case JOB_PENDING   :                              ok = Maybe ; continue  ;                            // queued waiting for initiation
-				case JOB_RUNNING   :                              ok = Maybe ; continue  ;                            // allocated resources and executing
-				case JOB_SUSPENDED :                              ok = Maybe ; continue  ;                            // allocated resources, execution suspended
-				case JOB_COMPLETE  :                                           continue  ;                            // completed execution successfully
-				case JOB_CANCELLED : msg = "cancelled by user"s ; ok = Yes   ; goto Done ;                            // cancelled by user
-				case JOB_TIMEOUT   : msg = "timeout"s           ; ok = No    ; goto Done ;                            // terminated on reaching time limit
-				case JOB_NODE_FAIL : msg = "node failure"s      ; ok = Yes   ; goto Done ;                            // terminated on node failure
-				case JOB_PREEMPTED : msg = "preempted"s         ; ok = Yes   ; goto Done ;                            // terminated due to preemption
-				case JOB_BOOT_FAIL : msg = "boot failure"s      ; ok = Yes   ; goto Done ;                            // terminated due to node boot failure
-				case JOB_DEADLINE  : msg = "deadline reached"s  ; ok = Yes   ; goto Done ;                            // terminated on deadline
-				case JOB_OOM       : msg = "out of memory"s     ; ok = No    ; goto Done ;                            // experienced out of memory error
-				//   JOB_END                                                                                          // not a real state, last entry in table
-				case JOB_FAILED :                                                                                     // completed execution unsuccessfully
-					// when job_exec receives a signal, the bash process which launches it (which the process seen by slurm) exits with an exit code > 128
-					// however, the user is interested in the received signal, not mapped bash exit code, so undo mapping
-					// signaled wstatus are barely the signal number
-					/**/                                      msg = "failed ("                                                                                           ;
-					if      (WIFSIGNALED(ji->exit_code)     ) msg << "signal " << WTERMSIG(ji->exit_code)           <<'-'<< ::strsignal(WTERMSIG(ji->exit_code)        ) ;
-					else if (!WIFEXITED(ji->exit_code)      ) msg << "??"                                                                                                ; // weird, could be a FAIL
-					else if (WEXITSTATUS(ji->exit_code)>0x80) msg << "signal " << (WEXITSTATUS(ji->exit_code)-0x80) <<'-'<< ::strsignal(WEXITSTATUS(ji->exit_code)-0x80) ; // cf comment above
-					else if (WEXITSTATUS(ji->exit_code)!=0  ) msg << "exit "   << WEXITSTATUS(ji->exit_code)                                                             ;
-					else                                      msg << "ok"                                                                                                ;
-					/**/                                      msg << ')'                                                                                                 ;
-					ok = No ;
-					goto Done ;
-				default : FAIL("Slurm : wrong job state return for job (",slurm_id,") : ",js) ;
+			slurm_job_info_t const* ji = &resp->job_array[i] ;
+			if (slurm_task(slurm_id)) {                                                                                   // array task : only consider records of this task
+				if (ji->array_task_id==NO_VAL              ) { pending = true ; continue ; }                                // a single record holds all pending tasks
+				if (ji->array_task_id!=slurm_task(slurm_id))                    continue ;
 			}
+			found = true ;
+			if (_acc_job_state(res,ji)) break ;
 		}
-	Done :
-		if ( +msg && ji->nodes ) msg << (::strchr(ji->nodes,' ')==nullptr?" on node : ":" on nodes : ") << ji->nodes ;
+		if ( !found && pending ) res.second = Maybe ;                                                                     // task is still queued
 		SlurmApi::free_job_info_msg(resp) ;
-		return { msg , ok } ;
+		return res ;
+	}
+
+	::umap<SlurmId,::pair_s<Bool3/*job_ok*/>> slurm_job_states(::uset<SlurmId> const& slurm_ids) {                   // jobs unknown to daemon are absent from result
+		Trace trace(BeChnl,"slurm_job_states",slurm_ids.size()) ;
+		::umap<SlurmId,::pair_s<Bool3/*job_ok*/>> res  ;
+		job_info_msg_t*                           resp = nullptr/*garbage*/ ;
+		{	Lock lock { _slurm_mutex } ;
+			if (SlurmApi::load_job_user(&resp,::getuid(),SHOW_LOCAL)!=SLURM_SUCCESS) {                                    // only our jobs are of interest, no info : jobs are probed individually
+				trace("err",slurm_err()) ;
+				return res ;
+			}
+		}
+		::uset<SlurmId>  done    ;
+		::uset<uint32_t> pending ;                                                                                             // arrays with tasks still queued
+		for ( uint32_t i=0 ; i<resp->record_count ; i++ ) {
+			slurm_job_info_t const* ji = &resp->job_array[i] ;
+			SlurmId                 id ;
+			if      (!ji->array_job_id              ) id = ji->het_job_id ? ji->het_job_id : ji->job_id ;                     // components of heterogeneous jobs are reported under the leader id
+			else if (ji->array_task_id==NO_VAL      ) { pending.insert(ji->array_job_id) ; continue ; }                       // a single record holds all pending tasks
+			else                                      id = mk_slurm_id(ji->array_job_id,ji->array_task_id) ;
+			if ( !slurm_ids.contains(id) || done.contains(id) ) continue ;
+			if (_acc_job_state( res.try_emplace(id,::string(),Yes).first->second , ji )) done.insert(id) ;
+		}
+		for( SlurmId id : slurm_ids )
+			if ( slurm_task(id) && pending.contains(slurm_job_id(id)) && !res.contains(id) ) res.try_emplace(id,::string(),Maybe) ; // task is still queued
+		SlurmApi::free_job_info_msg(resp) ;
+		trace("done",res.size()) ;
+		return res ;
 	}
 
 	static ::string _get_log_dir_s  (Job job) { return job.ancillary_file(AncillaryTag::Backend)+'/' ; }
@@ -609,16 +704,30 @@ namespace Backends::Slurm {
 		res += '\n' ;
 		return res ;
 	}
-	SlurmId slurm_spawn_job( ::stop_token st , ::string const& key , Job job , ::vector<ReqIdx> const& reqs , int32_t nice , ::vector_s const& cmd_line , RsrcsData const& rsrcs , bool verbose ) {
+	static ::string _array_cmd_to_string(::vector<::vector_s const*> const& cmd_lines) {                                    // task i runs the i-th command line
+		::string res = "#!/bin/sh\ncase $SLURM_ARRAY_TASK_ID in\n" ;
+		for( size_t t=0 ; t<cmd_lines.size() ; t++ ) {
+			res << t+1 <<')' ;
+			for ( ::string const& s : *cmd_lines[t] ) res <<' '<< s ;
+			res << " ;;\n" ;
+		}
+		res += "esac\n" ;
+		return res ;
+	}
+	// if several command lines are provided, job is submitted as an array with one task per command line
+	SlurmId slurm_spawn_job( ::stop_token st , ::string const& key , Job job , ::vector<ReqIdx> const& reqs , int32_t nice , ::vector<::vector_s const*> const& cmd_lines , RsrcsData const& rsrcs , bool verbose ) {
 		static constexpr char* env[1] = {const_cast<char*>("")} ;
 		static ::string        wd     = no_slash(*g_root_dir_s) ;
-		Trace trace(BeChnl,"slurm_spawn_job",key,job,nice,cmd_line,rsrcs,STR(verbose)) ;
+		Trace trace(BeChnl,"slurm_spawn_job",key,job,nice,cmd_lines.size(),rsrcs,STR(verbose)) ;
 		//
 		SWEAR(rsrcs.size()> 0) ;
 		SWEAR(nice        >=0) ;
+		SWEAR( cmd_lines.size()==1 || ( rsrcs.size()==1 && !verbose ) , cmd_lines.size() , rsrcs.size() , verbose ) ; // arrays of heterogeneous jobs are not supported by slurm
 		// first element is treated specially to avoid allocation in the very frequent case of a single element
 		::string                 job_name    = key + job->name()        ;
-		::string                 script      = _cmd_to_string(cmd_line) ;
+		bool                     is_array    = cmd_lines.size()>1                                                              ;
+		::string                 script      = is_array ? _array_cmd_to_string(cmd_lines) : _cmd_to_string(*cmd_lines[0])        ;
+		::string                 array_inx   = is_array ? "1-"+::to_string(cmd_lines.size()) : ""s                                ; // keep alive until slurm is called
 		::string                 stderr_file ;                                                                                                //                 keep alive until slurm is called
 		::string                 stdout_file ;                                                                                                //                 .
 		job_desc_msg_t           job_desc0   ;                                                                                                // first element
@@ -654,6 +763,7 @@ namespace Backends::Slurm {
 			if(+r.reserv  ) j.reservation   = const_cast<char*>(r.reserv  .data()) ;
 			if(+r.gres    ) j.tres_per_node =                   gres      .data()  ;
 			if(i==0       ) j.script        =                   script    .data()  ;
+			if(is_array   ) j.array_inx     =                   array_inx .data()  ;
 			/**/            j.nice          = NICE_OFFSET+nice                     ;
 			i++ ;
 		}
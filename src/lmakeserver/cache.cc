@@ -8,6 +8,7 @@
 #include <grp.h>
 
 #include "caches/dir_cache.hh"                                                 // PER_CACHE : add include line for each cache method
+#include "caches/tiered_cache.hh"                                              // .
 
 namespace Caches {
 
@@ -15,18 +16,40 @@ namespace Caches {
 	// Cache
 	//
 
-	::map_s<Cache*> Cache::s_tab ;
+	::map_s<Cache*>        Cache::s_tab         ;
+	Mutex<MutexLvl::Cache> Cache::_s_errs_mutex ;
+	::vector_s             Cache::_s_errs       ;
 
 	void Cache::s_config(::map_s<Config::Cache> const& configs) {
 		for( auto const& [key,config] : configs ) {
 			Cache* cache = nullptr/*garbage*/ ;
 			switch (config.tag) {
-				case Tag::None : cache = new Cache    ; break ;                // base class Cache actually caches nothing
-				case Tag::Dir  : cache = new DirCache ; break ;                // PER_CACHE : add a case for each cache method
+				case Tag::None   : cache = new Cache       ; break ;           // base class Cache actually caches nothing
+				case Tag::Dir    : cache = new DirCache    ; break ;           // PER_CACHE : add a case for each cache method
+				case Tag::Tiered : cache = new TieredCache ; break ;           // .
 			DF}
 			cache->config(config) ;
 			s_tab.emplace(key,cache) ;
 		}
 	}
 
+	void Cache::s_audit_errs() {
+		::vector_s errs ;
+		{	Lock lock { _s_errs_mutex } ;
+			if (!Req::s_n_reqs()) return ;                                     // keep errors until someone can see them
+			errs = ::move(_s_errs) ;
+			_s_errs.clear() ;
+		}
+		for( ::string const& e : errs )
+			for( Req r : Req::s_reqs_by_start ) r->audit_info( Color::Warning , "cache error : "+e ) ;
+	}
+
+	void Cache::_s_record_err(::string&& e) {
+		Trace trace("_s_record_err",e) ;
+		{	Lock lock { _s_errs_mutex } ;
+			_s_errs.push_back(::move(e)) ;
+		}
+		g_engine_queue.emplace(GlobalProc::Wakeup) ;                            // ensure engine loop reports error even if idle
+	}
+
 }
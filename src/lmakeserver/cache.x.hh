@@ -31,10 +31,18 @@ namespace Caches {
 			Id             id        = {}   ; // if completed&&hit==Yes   : an id to easily retrieve matched results when calling download
 		} ;
 		// statics
-		static void s_config(::map_s<Config::Cache> const&) ;
+		static void s_config    (::map_s<Config::Cache> const&) ;
+		static void s_audit_errs(                             ) ;           // report errors recorded by cache threads to running reqs, called from engine thread
+	protected :
+		static void _s_record_err(::string&&) ;                               // may be called from any thread
 		// static data
+	public :
 		static ::map_s<Cache*> s_tab ;
+	private :
+		static Mutex<MutexLvl::Cache> _s_errs_mutex ;
+		static ::vector_s             _s_errs       ;                         // protected by _s_errs_mutex
 		// services
+	public :
 		// default implementation : no caching, but enforce protocol
 		virtual void config(Config::Cache const&) {}
 		//
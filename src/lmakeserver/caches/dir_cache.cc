@@ -4,22 +4,41 @@
 // This program is distributed WITHOUT ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
 
 // cache format :
-//	- Lru contains
-//		- prev : more recently used entry. For most  recently used, contains head. For head, contains least recently used entry.
-//		- next : less recently used entry. For least recently used, contanis head. For head, contains most  recently used entry.
-//		- sz   : size of the entry. For head, total size of the cache.
-//	- global info :
-//		- LMAKE/lru : head
+//	- LRU index is a single file LMAKE/lru_index, mapped in memory by all users of the cache and containing :
+//		- header :
+//			- first    : most  recently used entry
+//			- last     : least recently used entry
+//			- total_sz : overall size of the entries
+//			- blobs_sz : overall size of the blobs, each blob being accounted once whatever the number of entries sharing it
+//		- one entry per cached job :
+//			- prev : more recently used entry, 0 if first
+//			- next : less recently used entry, 0 if last
+//			- sz   : size of the entry, excluding blobs
+//			- name : index in LMAKE/lru_names of job_dir
+//	- LRU index is protected by a byte-range lock on LMAKE/lru_index, which is only held for a short time (no data copy)
+//	- match tree in <job>/match : deps of all entries of <job> merged in a decision tree, so that match does not need to read every entry
+//		- each tree node contains edges labeled with a dep name and its digest, leading to child nodes
+//		- each tree node contains the ids (<repo_crc>) of the entries whose deps end at this node
+//		- file contains the number of nodes, then a table of node offsets, then nodes, so that match only reads the nodes it walks through
+//		- it is updated at each upload and may reference evicted entries, which are ignored
 //	- job_dir : <job>/<repo_crc> where :
 //		- <job> is made after its name with suffixes replaced by readable suffixes and rule idx by rule crc
 //		- <repo_crc> is computed after the repo as indicated in config.repo
 //	- each job has :
-//		- lru info  in <job_dir>/lru
+//		- lru idx   in <job_dir>/lru  (written once when entry is uploaded, checked against name in index as entry may have been evicted since)
 //		- meta-data in <job_dir>/data (the content of job.ancillary_file() with dep crc's instead of dep dates)
 //		- deps crcs in <job_dir>/deps (in same order as in meta-data)
+//		- blob names in <job_dir>/blobs (in target order, empty for targets not stored as blobs)
 //		- data in <job_dir>/<target_id>
 //			- target_id is the index of target as seen in meta-data
 //			- may be a regular file or a link
+//			- regular files with a known crc are hard links to LMAKE/blobs/<crc>, so that identical content is stored once across jobs and repos
+//	- blobs in LMAKE/blobs/<crc> :
+//		- the number of entries using a blob is in LMAKE/blob_refs, a file mapped in memory by all users of the cache and only accessed under LRU index lock
+//		- a blob is unlinked when its last user is evicted, link count is not used as it is out of our control
+//	- entries are prepared in LMAKE/tmp/<host>-<pid>-<n> without any lock, then renamed to their job_dir under LRU index lock
+//	- evicted entries are renamed to LMAKE/tmp/<host>-<pid>-<n> under LRU index lock and unlinked once it is released
+//	- private dirs in LMAKE/tmp older than MaxTmpAge have been left behind by a crashed process and are reclaimed when cache is configured
 
 #include "dir_cache.hh"
 
@@ -27,33 +46,151 @@ using namespace Disk ;
 
 namespace Caches {
 
-	// START_OF_VERSIONING
-
-	struct Lru {
-		::string     prev_s = DirCache::HeadS ;
-		::string     next_s = DirCache::HeadS ;
-		DirCache::Sz sz     = 0               ; // size of entry, or overall size for head
-	} ;
+	::counting_semaphore<DirCache::MaxPendingUploads> DirCache::_s_upload_slots     { MaxPendingUploads } ;
+	::umap<DirCache*,::vector<DirCache::Upload>>      DirCache::_s_upload_batch     ;
+	DirCache::DownloadQueue                           DirCache::_s_download_queue   ;
+	::vector<::jthread>                               DirCache::_s_download_threads ;
+	DequeThread<DirCache::Upload>                     DirCache::_s_upload_thread    ;
 
 	void DirCache::chk(ssize_t delta_sz) const {
-		::ifstream head_stream     { _lru_file(HeadS) } ;
-		Lru        head            ;                      if (head_stream) deserialize(head_stream,head) ;
-		::uset_s   seen            ;
-		::string   expected_prev_s = HeadS              ;
-		size_t     total_sz        = 0                  ;
-		for( ::string entry_s=head.next_s ; entry_s!=HeadS ;) {
-			auto here = deserialize<Lru>(IFStream(_lru_file(entry_s))) ;
+		LruHdr const& hdr           = lru_file.c_hdr() ;
+		::uset<LruIdx> seen         ;
+		LruIdx        expected_prev = 0                ;
+		size_t        total_sz      = 0                ;
+		for( LruIdx idx=hdr.first ; idx ;) {
+			LruEntry const& here = lru_file.c_at(idx) ;
 			//
-			SWEAR(seen.insert(entry_s).second ,entry_s) ;
-			SWEAR(here.prev_s==expected_prev_s,entry_s) ;
-			total_sz        += here.sz     ;
-			expected_prev_s  = entry_s     ;
-			entry_s          = here.next_s ;
+			SWEAR(seen.insert(idx).second   ,idx) ;
+			SWEAR(here.prev==expected_prev  ,idx) ;
+			SWEAR(+name_file.str_view(here.name),idx) ;
+			total_sz      += here.sz   ;
+			expected_prev  = idx       ;
+			idx            = here.next ;
 		}
-		SWEAR(head.prev_s==expected_prev_s  ,HeadS                    ) ;
-		SWEAR(head.sz    ==total_sz+delta_sz,head.sz,total_sz,delta_sz) ;
+		SWEAR(hdr.last    ==expected_prev     ,hdr.last                  ) ;
+		SWEAR(hdr.total_sz==total_sz+delta_sz ,hdr.total_sz,total_sz,delta_sz) ;
+	}
+
+	DirCache::LruLock::LruLock( DirCache& dc , Fd fd_ ) : fd{fd_} {
+		struct ::flock fl { .l_type=F_WRLCK , .l_whence=SEEK_SET , .l_start=0 , .l_len=1 , .l_pid=0 } ;    // lock first byte only, this is a convention among all users of the cache
+		while (::fcntl(fd,F_OFD_SETLKW,&fl)!=0) swear_prod(errno==EINTR,"cannot lock LRU index",fd,strerror(errno)) ;
+		if (dc.lru_file .base) dc.lru_file .sync_size() ;                                       // other users may have expanded the files
+		if (dc.name_file.base) dc.name_file.sync_size() ;                                       // .
+		if (dc.blob_file.base) dc.blob_file.sync_size() ;                                       // .
+	}
+
+	DirCache::LruLock::~LruLock() {
+		struct ::flock fl { .l_type=F_UNLCK , .l_whence=SEEK_SET , .l_start=0 , .l_len=1 , .l_pid=0 } ;
+		::fcntl(fd,F_OFD_SETLK,&fl) ;
 	}
 
+	// START_OF_VERSIONING
+	struct MatchTree {
+		struct Edge {
+			::string  dep   ;
+			DepDigest dd    ;
+			uint32_t  child = 0 ;
+		} ;
+		struct TreeNode {
+			::vector<Edge> edges ;
+			::vector_s     ids   ;                                                                  // entries whose deps end here
+		} ;
+		// services
+		void insert( ::string const& id , ::vmap_s<DepDigest> const& deps ) {
+			uint32_t cur = 0 ;
+			for( auto const& [dn,dd] : deps ) {
+				uint32_t nxt = 0 ;
+				for( Edge const& e : nodes[cur].edges ) if ( e.dep==dn && e.dd==dd ) { nxt = e.child ; break ; }
+				if (!nxt) {
+					nxt = nodes.size() ;
+					nodes[cur].edges.push_back({ .dep=dn , .dd=dd , .child=nxt }) ;
+					nodes.emplace_back() ;                                                          // /!\ invalidates references to nodes
+				}
+				cur = nxt ;
+			}
+			nodes[cur].ids.push_back(id) ;
+		}
+		void erase(::function<bool(::string const&)> drop) {                                    // erase entries for which drop returns true and suppress empty branches
+			for( TreeNode& n : nodes ) for( auto it=n.ids.begin() ; it!=n.ids.end() ;) if (drop(*it)) it = n.ids.erase(it) ; else it++ ;
+			::vector<TreeNode> new_nodes ;
+			_compact(new_nodes,0) ;
+			nodes = ::move(new_nodes) ;
+		}
+		void write(::string const& file) const {                                               // replace file atomically so a crash while writing never leaves a truncated tree
+			using Offset = uint64_t ;
+			uint32_t   n_nodes  = nodes.size()                                          ;
+			::vector_s datas    ; datas.reserve(n_nodes)                                ;
+			Offset     offset   = sizeof(n_nodes) + n_nodes*sizeof(Offset)             ;
+			::string   tmp_file = file+".tmp"                                           ;     // unique as writers hold the job dir lock exclusively
+			{	OFStream os { tmp_file } ;
+				for( TreeNode const& n : nodes ) datas.push_back(serialize(n)) ;
+				/**/                             serdes(os,n_nodes) ;
+				for( ::string const& d : datas ) { serdes(os,offset) ; offset += d.size() ; }
+				for( ::string const& d : datas ) os << d ;
+			}
+			if (::rename( tmp_file.c_str() , file.c_str() )!=0) throw "cannot rename "+tmp_file+" to "+file+" : "+::strerror(errno) ;
+		}
+		void read(::string const& file) {                                                      // read whole tree, only used when updating it
+			::ifstream is      { file } ; if (!is) return ;                                     // if no file, it is as if there were no entries
+			uint32_t   n_nodes = 0      ;
+			size_t     hdr_sz  ;
+			serdes(is,n_nodes) ;
+			hdr_sz = sizeof(n_nodes) + n_nodes*sizeof(uint64_t) ;
+			is.seekg(0,::ios::end) ;
+			if ( !is || size_t(is.tellg())<hdr_sz ) return ;                                    // corrupted tree, forget its entries, they will be added back as they are uploaded
+			is.seekg(hdr_sz) ;
+			nodes.resize(::max(n_nodes,uint32_t(1))) ;
+			for( uint32_t i=0 ; i<n_nodes ; i++ ) serdes(is,nodes[i]) ;
+			bool ok = bool(is) ;
+			for( TreeNode const& n : nodes ) for( Edge const& e : n.edges ) ok &= e.child<nodes.size() ;
+			if (!ok) nodes = ::vector<TreeNode>(1) ;                                            // .
+		}
+	private :
+		uint32_t _compact( ::vector<TreeNode>& new_nodes , uint32_t idx ) {                     // return new idx, 0 if branch is empty (root is never suppressed)
+			uint32_t res = new_nodes.size() ;
+			new_nodes.emplace_back() ;
+			for( Edge& e : nodes[idx].edges )
+				if ( uint32_t c=_compact(new_nodes,e.child) ) new_nodes[res].edges.push_back({ .dep=::move(e.dep) , .dd=e.dd , .child=c }) ;
+			new_nodes[res].ids = ::move(nodes[idx].ids) ;
+			if ( res && !new_nodes[res].edges && !new_nodes[res].ids ) {                        // all children have been suppressed, so we are last
+				new_nodes.pop_back() ;
+				return 0 ;
+			}
+			return res ;
+		}
+		// data
+	public :
+		::vector<TreeNode> nodes = ::vector<TreeNode>(1) ;                                      // nodes[0] is root
+	} ;
+
+	struct MatchTreeReader {                                                                    // read nodes of a match tree on demand, so that match cost does not depend on the number of entries
+		using Offset = uint64_t ;
+		// cxtors & casts
+		MatchTreeReader(::string const& file) : is{file} {
+			if (is) serdes(is,n_nodes) ;
+		}
+		// accesses
+		bool operator+() const { return n_nodes ; }                                             // if no file, it is as if there were no entries
+		bool operator!() const { return !+*this ; }
+		// services
+		MatchTree::TreeNode node(uint32_t idx) {
+			if (idx>=n_nodes) throw "corrupted match tree"s ;
+			Offset              offset ;
+			MatchTree::TreeNode res    ;
+			is.seekg( sizeof(n_nodes) + idx*sizeof(Offset) ) ; serdes(is,offset) ;
+			is.seekg( offset                               ) ; serdes(is,res   ) ;
+			if (!is) throw "corrupted match tree"s ;
+			return res ;
+		}
+		void subtree_ids( ::vector_s& res , uint32_t idx ) {
+			MatchTree::TreeNode n = node(idx) ;
+			for( ::string        & id : n.ids   ) res.push_back(::move(id)) ;
+			for( MatchTree::Edge & e  : n.edges ) subtree_ids(res,e.child) ;
+		}
+		// data
+		::ifstream is      ;
+		uint32_t   n_nodes = 0 ;
+	} ;
 	// END_OF_VERSIONING
 
 	void DirCache::config(Config::Cache const& config) {
@@ -67,9 +204,58 @@ namespace Caches {
 		try                     { chk_version(true/*may_init*/,dir_s+AdminDirS) ;                    }
 		catch (::string const&) { throw "cache version mismatch, running without "+no_slash(dir_s) ; }
 		//
-		dir_fd = open_read(no_slash(dir_s)) ; dir_fd.no_std() ;                          // avoid poluting standard descriptors
-		if (!dir_fd) throw "cannot configure cache "+no_slash(dir_s)+" : no directory" ;
+		::string lru_index_file = dir_s+AdminDirS+"lru_index" ;
+		dir_fd        = open_read(no_slash(dir_s))                                        ; dir_fd       .no_std() ; // avoid poluting standard descriptors
+		lru_fd        = ::open( lru_index_file.c_str() , O_RDWR|O_CREAT|O_CLOEXEC , 0666 ) ; lru_fd       .no_std() ; // .
+		upload_lru_fd = ::open( lru_index_file.c_str() , O_RDWR          |O_CLOEXEC        ) ; upload_lru_fd.no_std() ; // .
+		if (!dir_fd                    ) throw "cannot configure cache "+no_slash(dir_s)+" : no directory" ;
+		if ( !lru_fd || !upload_lru_fd ) throw "cannot configure cache "+no_slash(dir_s)+" : cannot open "+lru_index_file ;
+		mk_dir_s(dir_fd,AdminDirS+"blobs/"s) ;
+		blobs_fd = open_read(dir_fd,AdminDirS+"blobs"s) ; blobs_fd.no_std() ;                                                  // .
+		if (!blobs_fd                  ) throw "cannot configure cache "+no_slash(dir_s)+" : cannot open blobs dir" ;
 		sz = from_string_with_units<size_t>(strip(read_content(dir_s+AdminDirS+"size"))) ;
+		::string lru_names_file = dir_s+AdminDirS+"lru_names" ;
+		::string blob_refs_file = dir_s+AdminDirS+"blob_refs" ;
+		for( ::string const& f : { lru_names_file , blob_refs_file } ) {                                                     // create shared files as lru_index, so that umask/setgid decide who may access cache ...
+			AutoCloseFd fd = ::open( f.c_str() , O_RDWR|O_CREAT|O_CLOEXEC , 0666 ) ;                                         // ... and check access as Store::File cannot recover from an error
+			if (!fd) throw "cannot configure cache "+no_slash(dir_s)+" : cannot open "+f ;
+		}
+		{	LruLock lock { *this , lru_fd } ;                                                                                // ensure index is initialized once, even if several repos configure cache simultaneously
+			lru_file .init( lru_index_file , true/*writable*/ ) ;
+			name_file.init( lru_names_file , true/*writable*/ ) ;
+			blob_file.init( blob_refs_file , true/*writable*/ ) ;
+		}
+		// reclaim private dirs left behind by crashed uploads or evictions
+		// a dir being prepared is modified each time a file is added, and an evicted entry is only kept while LRU lock is held
+		mk_dir_s(dir_fd,AdminDirS+"tmp/"s) ;
+		time_t now = ::time(nullptr) ;
+		for( ::string const& t : lst_dir_s(dir_fd,AdminDirS+"tmp/"s,AdminDirS+"tmp/"s) ) {
+			struct ::stat st ;
+			if (::fstatat(dir_fd,t.c_str(),&st,AT_SYMLINK_NOFOLLOW)!=0          ) continue ;
+			if (st.st_mtime+MaxTmpAge>now                                      ) continue ;
+			Trace("DirCache::config","reclaim",t) ;
+			_empty_trash({with_slash(t)}) ;
+		}
+		//
+		static bool s_threads_opened = false ;
+		if (!s_threads_opened) {
+			_s_upload_thread.open('U',_s_upload_thread_func) ;
+			size_t n_download_threads = ::min( size_t(thread::hardware_concurrency()) , MaxDownloadThreads ) ;
+			_s_download_threads.reserve(n_download_threads) ;
+			for( size_t i=1 ; i<n_download_threads ; i++ ) _s_download_threads.emplace_back(_s_download_func,i) ; // downloading thread is thread 0
+			s_threads_opened = true ;
+		}
+	}
+
+	void DirCache::_s_download_func( ::stop_token stop , size_t id ) {
+		t_thread_key = 'G' ;
+		Trace trace("DirCache::_s_download_func",id) ;
+		for(;;) {
+			auto [popped,chunk] = _s_download_queue.pop(stop) ;
+			if (!popped) break ;
+			chunk() ;
+		}
+		trace("done") ;
 	}
 
 	// START_OF_VERSIONING
@@ -93,135 +279,211 @@ namespace Caches {
 	}
 	// END_OF_VERSIONING
 
-	void DirCache::_mk_room( Sz old_sz , Sz new_sz ) {
+	DirCache::LruIdx DirCache::_lru_idx(::string const& entry_s) {
+		::ifstream idx_stream { dir_s+entry_s+"lru" }       ; if (!idx_stream) return 0 ;              // no lru file, entry is not in index
+		LruIdx     idx        = deserialize<LruIdx>(idx_stream) ;
+		if ( !idx || idx>=lru_file.size()                          ) return 0 ;
+		if ( name_file.str_view(lru_file.c_at(idx).name)!=entry_s ) return 0 ;                 // entry has been evicted since lru file was written, and idx reused
+		return idx ;
+	}
+
+	DirCache::LruIdx DirCache::_lru_alloc(::string const& entry_s) {
+		NameIdx name = name_file.emplace(::c_vector_view<char>(entry_s.data(),entry_s.size())) ;
+		return lru_file.emplace(LruEntry{.name=name}) ;                                         // not linked yet, hence cannot be evicted
+	}
+
+	void DirCache::_lru_free(LruIdx idx) {
+		LruEntry& here = lru_file.at(idx) ;
+		name_file.pop(here.name) ;
+		here.name = 0 ;                                                                         // ensure stale lru files do not match
+		lru_file.pop(idx) ;
+	}
+
+	bool/*was_linked*/ DirCache::_lru_unlink(LruIdx idx) {
+		LruHdr  & hdr  = lru_file.hdr(   ) ;
+		LruEntry& here = lru_file.at (idx) ;
+		if ( !here.prev && hdr.first!=idx ) return false/*was_linked*/ ;
+		if (+here.prev) lru_file.at(here.prev).next = here.next ; else hdr.first = here.next ;
+		if (+here.next) lru_file.at(here.next).prev = here.prev ; else hdr.last  = here.prev ;
+		SWEAR( hdr.total_sz>=here.sz , hdr.total_sz , here.sz ) ;                               // total size contains this entry
+		hdr.total_sz -= here.sz ;
+		here.prev     = 0       ;
+		here.next     = 0       ;
+		return true/*was_linked*/ ;
+	}
+
+	void DirCache::_lru_first(LruIdx idx) {
+		LruHdr  & hdr  = lru_file.hdr(   ) ;
+		LruEntry& here = lru_file.at (idx) ;
+		here.prev = 0         ;
+		here.next = hdr.first ;
+		if (+hdr.first) lru_file.at(hdr.first).prev = idx ; else hdr.last = idx ;
+		hdr.first     = idx     ;
+		hdr.total_sz += here.sz ;
+	}
+
+	void DirCache::_mk_room( Sz new_sz , ::vector_s& trash_s ) {
 		if (new_sz>sz) throw "cannot store entry of size "s+new_sz+" in cache of size "+sz ;
 		//
-		::string   head_file       = _lru_file(HeadS) ;
-		::ifstream head_stream     { head_file }      ;
-		Lru        head            ;                    if (head_stream) deserialize(head_stream,head) ;
-		bool       some_removed    = false            ;
-		::string   expected_next_s = HeadS            ;                             // for assertion only
-		//
-		SWEAR( head.sz>=old_sz , head.sz , old_sz ) ;                               // total size contains old_sz
-		head.sz -= old_sz ;
-		while (head.sz+new_sz>sz) {
-			SWEAR(head.prev_s!=HeadS) ;                                             // else this would mean an empty cache and we know an empty cache can accept new_sz
-			auto here = deserialize<Lru>(IFStream(_lru_file(head.prev_s))) ;
-			SWEAR( here.next_s==expected_next_s , here.next_s , expected_next_s ) ;
-			SWEAR( head.sz    >=here.sz         , head.sz     , here.sz         ) ; // total size contains this entry
-			unlnk(dir_fd,no_slash(head.prev_s),true/*dir_ok*/) ;
-			expected_next_s  = head.prev_s         ;
-			head.sz         -= here.sz             ;
-			head.prev_s      = ::move(here.prev_s) ;
-			some_removed     = true                ;
+		LruHdr& hdr = lru_file.hdr() ;
+		while (hdr.total_sz+hdr.blobs_sz+new_sz>sz) {
+			LruIdx victim = hdr.last ;
+			if (!victim) throw "cannot make room for entry of size "s+new_sz+" in cache of size "+sz+" with "+hdr.blobs_sz+" used by blobs" ;
+			::string victim_s { name_file.str_view(lru_file.c_at(victim).name) } ;
+			_lru_unlink(victim) ;
+			_lru_free  (victim) ;
+			_evict(victim_s,trash_s) ;                                                          // only a rename, actual unlink is done once LRU lock is released
 		}
-		head.sz += new_sz ;
-		SWEAR( head.sz<=sz , head.sz , sz ) ;
-		//
-		if (some_removed) {
-			if (head.prev_s==HeadS) {
-				head.next_s = HeadS ;
-			} else {
-				::string last_file = _lru_file(head.prev_s)                ;
-				auto     last      = deserialize<Lru>(IFStream(last_file)) ;
-				last.next_s = HeadS ;
-				serialize(OFStream(last_file),last) ;
-			}
+	}
+
+	static ::vector_s _read_blobs(::string const& file) {
+		::ifstream blobs_stream { file } ; if (!blobs_stream) return {} ;                       // no blobs file, entry has no blobs
+		return deserialize<::vector_s>(blobs_stream) ;
+	}
+
+	void DirCache::_evict( ::string const& entry_s , ::vector_s& trash_s ) {
+		AutoCloseFd dfd = open_read(dir_fd,no_slash(entry_s)) ; if (!dfd) return ;             // entry does not exist
+		LockedFd    lock { dfd , true/*exclusive*/ }          ;                                 // wait for downloads taking a snapshot of entry
+		::string    t_s  = _tmp_s()                            ;
+		if (::renameat( dir_fd , no_slash(entry_s).c_str() , dir_fd , no_slash(t_s).c_str() )!=0) throw "cannot evict "+no_slash(entry_s)+" : "+::strerror(errno) ;
+		_unref_blobs(_read_blobs(dir_s+t_s+"blobs")) ;
+		trash_s.push_back(::move(t_s)) ;
+	}
+
+	void DirCache::_empty_trash(::vector_s const& trash_s) {
+		for( ::string const& t_s : trash_s ) {
+			AutoCloseFd dfd  = open_read(dir_fd,no_slash(t_s)) ;
+			LockedFd    lock { dfd , true/*exclusive*/ }       ;                                // a download may still be taking a snapshot of entry if it opened it before it was evicted
+			unlnk(dir_fd,no_slash(t_s),true/*dir_ok*/) ;
 		}
-		serialize( OFStream(dir_guard(head_file)) , head ) ;
 	}
 
-	DirCache::Sz DirCache::_lru_remove(::string const& entry_s) {
-		SWEAR(entry_s!=HeadS) ;
-		//
-		::ifstream here_stream { _lru_file(entry_s) }          ; if (!here_stream) return 0 ; // nothing to remove
-		auto       here        = deserialize<Lru>(here_stream) ;
-		if (here.prev_s==here.next_s) {
-			::string pn_file = _lru_file(here.prev_s)              ;
-			auto     pn      = deserialize<Lru>(IFStream(pn_file)) ;
-			//
-			pn.next_s = here.next_s ;
-			pn.prev_s = here.prev_s ;
-			//
-			serialize(OFStream(pn_file),pn) ;
-		} else {
-			::string   prev_file   = _lru_file(here.prev_s)                ;
-			::string   next_file   = _lru_file(here.next_s)                ;
-			auto       prev        = deserialize<Lru>(IFStream(prev_file)) ;
-			auto       next        = deserialize<Lru>(IFStream(next_file)) ;
-			//
-			prev.next_s = here.next_s ;
-			next.prev_s = here.prev_s ;
-			//
-			serialize(OFStream(prev_file),prev) ;
-			serialize(OFStream(next_file),next) ;
+	::string DirCache::_tmp_s() {
+		static ::atomic<size_t> s_cnt = 0 ;
+		return AdminDirS+"tmp/"s+host()+'-'+::getpid()+'-'+(s_cnt++)+'/' ;
+	}
+
+	// START_OF_VERSIONING
+	::string DirCache::_blob(Hash::Crc crc) const {
+		if ( !crc.valid() || !crc.is_reg() || crc==Hash::Crc::Empty ) return {} ;              // only plain regular files are worth sharing, exe bit is part of crc
+		return ::string(crc) ;
+	}
+	// END_OF_VERSIONING
+
+	uint32_t DirCache::_blob_refs(::string const& blob) const {
+		uint32_t const* refs = blob_file.search_at(blob) ;
+		return refs ? *refs : 0 ;
+	}
+
+	void DirCache::_set_blob_refs( ::string const& blob , uint32_t n ) {
+		if (n) blob_file.insert_at(blob) = n ;
+		else   blob_file.erase    (blob)     ;
+	}
+
+	void DirCache::_ref_blobs( Upload& upload , Fd tmp_fd ) {
+		LruHdr& hdr = lru_file.hdr() ;
+		for( NodeIdx ti=0 ; ti<upload.blobs.size() ; ti++ ) {
+			::string& b   = upload.blobs[ti] ; if (!b) continue ;
+			::string  dst = ::to_string(ti)  ;
+			struct ::stat dst_st  ;
+			struct ::stat blob_st ;
+			if (::fstatat(tmp_fd,dst.c_str(),&dst_st,AT_SYMLINK_NOFOLLOW)!=0) throw "cannot stat "+no_slash(upload.tmp_s)+'/'+dst ;
+			uint32_t refs   = _blob_refs(b)                                                     ;
+			bool     exists = ::fstatat(blobs_fd,b.c_str(),&blob_st,AT_SYMLINK_NOFOLLOW)==0 ;
+			if ( !refs || !exists ) {                                                           // publish our content as blob
+				if (exists) unlnk(blobs_fd,b) ;                                                 // left behind by a crashed process, not accounted for
+				if (!hard_lnk(blobs_fd,b,tmp_fd,dst)) {                                         // cannot share, keep a private copy
+					upload.sz += dst_st.st_size ;
+					b.clear() ;
+					continue ;
+				}
+				hdr.blobs_sz += dst_st.st_size ;
+				refs          = 0              ;
+			} else if (dst_st.st_ino!=blob_st.st_ino) {                                         // blob has been published since entry was prepared, share it
+				unlnk(tmp_fd,dst) ;
+				if (!hard_lnk(tmp_fd,dst,blobs_fd,b)) throw "cannot link "+no_slash(upload.tmp_s)+'/'+dst+" to blob "+b ;
+			}
+			_set_blob_refs(b,refs+1) ;
 		}
-		return here.sz ;
 	}
 
-	void DirCache::_lru_first( ::string const& entry_s , Sz sz_ ) {
-		SWEAR(entry_s!=HeadS) ;
-		//
-		::string head_file  = _lru_file(HeadS)                       ;
-		auto     head       = deserialize<Lru>(IFStream(head_file))  ;
-		::string here_file  = _lru_file(entry_s)                     ;
-		Lru      here       { .next_s=head.next_s , .sz=sz_ }        ;
-		if (head.next_s==HeadS) {
-			head.next_s = entry_s ;
-			head.prev_s = entry_s ;
-		} else {
-			::string first_file = _lru_file(head.next_s)                 ;
-			auto     first      = deserialize<Lru>(IFStream(first_file)) ;
-			head .next_s = entry_s ;
-			first.prev_s = entry_s ;
-			serialize(OFStream(first_file),first) ;
+	void DirCache::_unref_blobs(::vector_s const& blobs) {
+		LruHdr& hdr = lru_file.hdr() ;
+		for( ::string const& b : blobs ) {
+			if (!b) continue ;
+			uint32_t refs = _blob_refs(b) ;
+			if (refs>1) { _set_blob_refs(b,refs-1) ; continue ; }
+			struct ::stat st ;
+			if ( refs && ::fstatat(blobs_fd,b.c_str(),&st,AT_SYMLINK_NOFOLLOW)==0 ) {           // blob is only accounted for if it has refs
+				SWEAR( hdr.blobs_sz>=Sz(st.st_size) , hdr.blobs_sz , st.st_size ) ;
+				hdr.blobs_sz -= st.st_size ;
+			}
+			unlnk(blobs_fd,b) ;                                                                 // last user is gone, entries that link to it keep their own copy until they are unlinked
+			_set_blob_refs(b,0) ;
 		}
-		serialize(OFStream(head_file),head) ;
-		serialize(OFStream(here_file),here) ;
 	}
 
 	Cache::Match DirCache::match( Job job , Req req ) {
 		Trace trace("DirCache::match",job,req) ;
-		::string     jn_s     = _unique_name_s(job)               ;
-		::uset<Node> new_deps ;
-		AutoCloseFd  dfd      =  open_read(dir_fd,no_slash(jn_s)) ;
-		LockedFd     lock     { dfd    , false/*exclusive*/ }     ;
-		bool         found    = false                             ;
+		::string        jn_s     = _unique_name_s(job)               ;
+		::uset<Node>    new_deps ;
+		AutoCloseFd     dfd      =  open_read(dir_fd,no_slash(jn_s)) ;
+		LockedFd        lock     { dfd    , false/*exclusive*/ }     ;
+		bool            found    = false                             ;
+		MatchTreeReader tree     { dir_s+jn_s+"match" }              ;                     // nodes are read as they are walked through
 		//
+		if (!tree) {
+			trace("no_match_tree") ;
+			return { .completed=true , .hit=No } ;
+		}
+		// returns true if r is a hit
+		auto candidate = [&]( ::string const& r , ::uset<Node> const& nds )->bool {
+			if (!is_target(dfd,r+"/data")) return false ;                                   // entry has been evicted since match tree was updated
+			if (!nds) return true ;
+			if (!found) {
+				found    = true ;
+				new_deps = nds  ;                                                           // do as if new_deps contains the whole world
+			} else {
+				for( auto it=new_deps.begin() ; it!=new_deps.end() ;)
+					if (nds.contains(*it))                it++  ;
+					else                   new_deps.erase(it++) ;                           // /!\ be careful with erasing while iterating : increment it before erasing is done at it before increment
+			}
+			return false ;
+		} ;
+		// walk the tree, following all branches compatible with done deps
+		// when all deps are done, at most one branch is followed at each node as a single dep crc may match
+		struct Walk {
+			uint32_t     node     = 0     ;
+			::uset<Node> nds      = {}    ;                                                 // deps that were not done on the way
+			bool         critical = false ;                                                 // if true, a critical dep needs reconstruction
+		} ;
 		try {
-			for( ::string const& r : lst_dir_s(dfd) ) {
-				::uset<Node> nds      ;
-				auto         deps     = deserialize<::vmap_s<DepDigest>>(IFStream(dir_s+jn_s+r+"/deps")) ;
-				bool         critical = false                                                            ;
-				//
-				for( auto const& [dn,dd] : deps ) {
-					if ( critical && !dd.parallel ) break ;           // if a critical dep needs reconstruction, do not proceed past parallel deps
-					Node d{dn} ;
+			::vector<Walk> stack { Walk() } ;
+			while (+stack) {
+				Walk                w = ::move(stack.back()) ; stack.pop_back() ;
+				MatchTree::TreeNode n = tree.node(w.node)        ;                             // only read the nodes we walk through
+				for( ::string const& r : n.ids ) if (candidate(r,w.nds)) { trace("hit",r) ; return { .completed=true , .hit=Yes , .id{r} } ; }
+				for( MatchTree::Edge const& e : n.edges ) {
+					if ( w.critical && !e.dd.parallel ) {                                       // if a critical dep needs reconstruction, do not proceed past parallel deps
+						::vector_s rs ;
+						tree.subtree_ids(rs,e.child) ;
+						for( ::string const& r : rs ) candidate(r,w.nds) ;                      // cannot hit as w.nds is not empty
+						continue ;
+					}
+					Node d{e.dep} ;
 					if (!d->done(req,NodeGoal::Status)) {
-						nds.insert(d) ;
-						critical |= dd.dflags[Dflag::Critical] ;      // note critical flag to stop processing once parallel deps are exhausted
-						if (!nds) trace("not_done",dn) ;
-					} else if (!d->up_to_date(dd)) {
-						trace("diff",dn) ;
-						goto Miss ;
+						Walk nw { .node=e.child , .nds=w.nds , .critical=w.critical||e.dd.dflags[Dflag::Critical] } ; // note critical flag to stop processing once parallel deps are exhausted
+						nw.nds.insert(d) ;
+						trace("not_done",e.dep) ;
+						stack.push_back(::move(nw)) ;
+					} else if (d->up_to_date(e.dd)) {
+						stack.push_back({ .node=e.child , .nds=w.nds , .critical=w.critical }) ;
 					}
 				}
-				if (!nds) {
-					trace("hit",r) ;
-					return { .completed=true , .hit=Yes , .id{r} } ;  // hit
-				}
-				if (!found) {
-					found    = true        ;
-					new_deps = ::move(nds) ;                          // do as if new_deps contains the whole world
-				} else {
-					for( auto it=new_deps.begin() ; it!=new_deps.end() ;)
-						if (nds.contains(*it))                it++  ;
-						else                   new_deps.erase(it++) ; // /!\ be careful with erasing while iterating : increment it before erasing is done at it before increment
-				}
-			Miss : ;                                                  // missed for this entry, try next one
 			}
-		} catch (::string const&) {                                   // if directory does not exist, it is as it was empty
-			trace("dir_not_found") ;
+		} catch (::string const& e) {                                                           // match tree is corrupted, do as if no entry matched
+			trace("bad_match_tree",e) ;
+			return { .completed=true , .hit=No } ;
 		}
 		if (!found) {
 			trace("miss") ;
@@ -238,55 +500,184 @@ namespace Caches {
 	}
 
 	JobInfo DirCache::download( Job job , Id const& id , JobReason const& reason , NfsGuard& nfs_guard ) {
-		::string    jn     = _unique_name_s(job)+id ;
-		::string    jn_s   = jn+'/'                 ;
-		AutoCloseFd dfd    = open_read(dir_fd,jn)   ;
-		::vector_s  copied ;
+		::string          jn        = _unique_name_s(job)+id ;
+		::string          jn_s      = jn+'/'                 ;
+		AutoCloseFd       dfd       = open_read(dir_fd,jn)   ;
+		JobInfo           job_info  ;
+		::vector<Src>     srcs      ;
+		::atomic<NodeIdx> n_started = 0                      ;                                      // targets before n_started may have been (partially) copied
 		Trace trace("DirCache::download",job,id,jn) ;
 		try {
-			JobInfo job_info ;
-			{	LockedFd lock { dfd , false/*exclusive*/ } ;                                         // because we read the data , shared is ok
+			// take a snapshot of the entry under lock : meta-data and open fd's to data, so that lock can be released before data are copied
+			{	LockedFd lock { dfd , false/*exclusive*/ } ;                                             // because we read the data , shared is ok
+				struct ::stat dst ;
+				struct ::stat nst ;
+				if ( ::fstat(dfd,&dst)!=0 || ::fstatat(dir_fd,jn.c_str(),&nst,AT_SYMLINK_NOFOLLOW)!=0 || dst.st_ino!=nst.st_ino ) throw "entry "+jn+" has been evicted" ; // entries are moved under lock when evicted
 				job_info = { dir_s+jn_s+"data" } ;
-				// update some info
-				job_info.start.pre_start.job       = +job   ;                                        // id is not stored in cache
-				job_info.start.submit_attrs.reason = reason ;
-				//
-				copied.reserve(job_info.end.end.digest.targets.size()) ;
+				srcs.reserve(job_info.end.end.digest.targets.size()) ;
 				for( NodeIdx ti=0 ; ti<job_info.end.end.digest.targets.size() ; ti++ ) {
-					auto&           entry = job_info.end.end.digest.targets[ti] ;
-					::string const& tn    = entry.first                         ;
-					copied.push_back(tn) ;
-					nfs_guard.change(tn) ;
-					trace("copy",dfd,ti,tn) ;
-					cpy( tn , dfd , ::to_string(ti) , true/*unlnk_dst*/ , false/*mk_read_only*/ ) ;
-					entry.second.sig = FileSig(tn) ;                                                 // target digest is not stored in cache
+					auto const& [tn,td] = job_info.end.end.digest.targets[ti] ;
+					::string    src     = ::to_string(ti)                     ;
+					Src&        s       = srcs.emplace_back()                 ;
+					nfs_guard.change(tn) ;                                                               // nfs_guard is not thread-safe, call it before copying
+					s.tag = FileInfo(dfd,src).tag() ;
+					switch (s.tag) {
+						case FileTag::Reg :
+						case FileTag::Exe :
+							s.fd = ::openat( dfd , src.c_str() , O_RDONLY|O_NOFOLLOW|O_CLOEXEC ) ;                    // targets never share their inode with cache, reflink is used if possible
+							if (!s.fd) throw "cannot open "+jn_s+src+" : "+::strerror(errno) ;                         // entry is unusable, this is a miss
+						break ;
+						case FileTag::Lnk :
+							s.lnk = read_lnk(dfd,src) ;
+						break ;
+					DN}
 				}
-				job_info.end.end.digest.end_date = New ;                                             // date must be after files are copied
 			}
+			_download_targets( job_info , srcs , n_started ) ;
+			job_info.end.end.digest.end_date = New ;                                                     // date must be after files are copied
+			// update some info
+			job_info.start.pre_start.job       = +job   ;                                                // id is not stored in cache
+			job_info.start.submit_attrs.reason = reason ;
 			// ensure we take a single lock at a time to avoid deadlocks
-			// upload is the only one to take several locks
-			{	LockedFd lock2 { dir_fd , true /*exclusive*/ } ;                                     // because we manipulate LRU, need exclusive
-				Sz sz_ = _lru_remove(jn_s) ;
-				_lru_first(jn_s,sz_) ;
-				trace("done",sz_) ;
+			{	LruLock lock { *this , lru_fd } ;                                                        // short lock, only pointers in LRU index are updated
+				LruIdx  idx  = _lru_idx(jn_s)   ;
+				if ( +idx && _lru_unlink(idx) ) _lru_first(idx) ;                                        // if not linked, entry is being uploaded and will be linked when done
+				trace("done",idx) ;
 			}
 			return job_info ;
 		} catch(::string const& e) {
-			for( ::string const& f : copied ) unlnk(f) ;                                             // clean up partial job
-			trace("failed") ;
+			auto const& targets = job_info.end.end.digest.targets ;
+			for( NodeIdx ti=0 ; ti<::min(NodeIdx(n_started),NodeIdx(targets.size())) ; ti++ ) unlnk(targets[ti].first) ; // clean up partial job
+			trace("failed",e) ;
 			throw e ;
 		}
 	}
 
-	bool/*ok*/ DirCache::upload( Job job , JobDigest const& digest , NfsGuard& nfs_guard ) {              // XXX : defer upload in a dedicated thread
-		::string jn_s = _unique_name_s(job)+repo_s ;
-		Trace trace("DirCache::upload",job,jn_s) ;
+	// copy targets on a few threads as copying is mostly latency bound (typically on NFS), and record sig of each target
+	// calling thread takes its share, so that download progresses even if download threads are busy
+	void DirCache::_download_targets( JobInfo& job_info , ::vector<Src> const& srcs , ::atomic<NodeIdx>& n_started ) {
+		auto&  targets   = job_info.end.end.digest.targets                                            ;
+		size_t n_threads = ::max( ::min( _s_download_threads.size()+1 , targets.size() ) , size_t(1) ) ;
+		//
+		::vector_s     errs         ( n_threads              ) ;                                       // one slot per thread, so no need for a mutex
+		::atomic<bool> stop         = false                    ;
+		::latch        helpers_done { ptrdiff_t(n_threads-1) } ;                                       // calling thread is not a helper
+		auto copy_targets = [&]( size_t id )->void {
+			Trace trace("DirCache::_download_targets",id) ;
+			for( NodeIdx ti ; !stop && (ti=n_started++)<targets.size() ;) {
+				auto&           entry = targets[ti]   ;
+				::string const& tn    = entry.first   ;
+				Src      const& s     = srcs[ti]      ;
+				try {
+					switch (s.tag) {
+						case FileTag::Reg :
+						case FileTag::Exe :
+							trace("copy",ti,tn) ;
+							cpy( Fd::Cwd , tn , s.fd , true/*unlnk_dst*/ , false/*mk_read_only*/ ) ;     // reflink if possible
+						break ;
+						case FileTag::Lnk :
+							trace("lnk",ti,tn) ;
+							unlnk(tn) ;
+							dir_guard(tn) ;
+							lnk(Fd::Cwd,tn,s.lnk) ;
+						break ;
+						default :
+							unlnk(tn) ;
+					}
+					entry.second.sig = FileSig(tn) ;                                                     // target digest is not stored in cache
+				} catch (::string const& e) {
+					errs[id] = e    ;
+					stop     = true ;                                                                    // no need to go on, download has failed
+					return ;
+				}
+			}
+		} ;
+		for( size_t i=1 ; i<n_threads ; i++ ) _s_download_queue.emplace( [&,i]()->void { copy_targets(i) ; helpers_done.count_down() ; } ) ;
+		copy_targets(0) ;
+		helpers_done.wait() ;                                                                            // helpers refer to our local variables
+		for( ::string const& e : errs ) if (+e) throw e ;
+	}
+
+	bool/*queued*/ DirCache::upload( Job job , JobDigest const& digest , NfsGuard& nfs_guard ) {
+		::vmap_s<FileSig> targets ; targets.reserve(digest.targets.size()) ;
+		for( auto const& [tn,td] : digest.targets ) targets.emplace_back(tn,td.sig) ;
+		return upload( job , job.job_info() , ::move(targets) , nfs_guard.reliable_dirs ) ;                // job info must be read now as job may be rerun before upload thread gets a chance to run
+	}
+
+	bool/*queued*/ DirCache::upload( Job job , JobInfo&& job_info , ::vmap_s<FileSig>&& targets , bool reliable_dirs ) {
+		::optional<Upload> upload = mk_upload( job , ::move(job_info) , ::move(targets) , reliable_dirs ) ;
+		if (!upload) return false/*queued*/ ;
 		//
-		JobInfo job_info = job.job_info() ;
-		if (!job_info.end.end.proc) {                                                                     // we need a full report to cache job
+		_s_upload_slots.acquire() ;                                                                       // back-pressure : wait for upload thread if too many uploads are pending
+		//vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+		_s_upload_thread.emplace(::move(*upload)) ;
+		//^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
+		return true/*queued*/ ;
+	}
+
+	::optional<DirCache::Upload> DirCache::mk_upload( Job job , JobInfo&& job_info , ::vmap_s<FileSig>&& targets , bool reliable_dirs ) {
+		Upload upload { .self=this , .jn_s=_unique_name_s(job)+repo_s , .job_info=::move(job_info) , .targets=::move(targets) , .reliable_dirs=reliable_dirs } ;
+		Trace trace("DirCache::mk_upload",job,upload.jn_s) ;
+		//
+		if (!upload.job_info.end.end.proc) {                                                              // we need a full report to cache job
 			trace("no_ancillary_file") ;
-			return false/*ok*/ ;
+			return {} ;
+		}
+		for( auto const& [dn,dd] : upload.job_info.end.end.digest.deps ) if (!dd.is_crc) return {} ;
+		return upload ;
+	}
+
+	void DirCache::upload_now(Upload&& upload) {
+		SWEAR( upload.self==this , upload.jn_s ) ;
+		::vector<Upload> uploads ; uploads.push_back(::move(upload)) ;
+		_upload_batch(uploads) ;
+	}
+
+	void DirCache::_s_upload_thread_func(Upload&& upload) {
+		DirCache* self = upload.self ;
+		_s_upload_batch[self].push_back(::move(upload)) ;
+		if (+_s_upload_thread) return ;                                                                   // more uploads are pending, process them all at once
+		for( auto& [dc,uploads] : _s_upload_batch ) {
+			dc->_upload_batch(uploads) ;
+			_s_upload_slots.release(uploads.size()) ;
+		}
+		_s_upload_batch.clear() ;
+	}
+
+	void DirCache::_upload_batch(::vector<Upload>& uploads) {
+		Trace trace("DirCache::_upload_batch",uploads.size()) ;
+		::vector<bool> oks ( uploads.size() , false ) ;
+		// copy data without holding any lock, each entry is prepared in a private dir
+		for( size_t i=0 ; i<uploads.size() ; i++ ) {
+			Upload& u = uploads[i] ;
+			try                       { _upload(u) ; oks[i] = true ;                                         }
+			catch (::string const& e) { _s_record_err("cannot upload "+no_slash(u.jn_s)+" to "+no_slash(dir_s)+" : "+e) ; } // engine has long forgotten about upload, report asynchronously
+		}
+		// install all entries and link them in LRU under a single lock, only renames and pointer updates are done here
+		::vector_s trash_s ;
+		{	LruLock lock { *this , upload_lru_fd } ;
+			for( size_t i=0 ; i<uploads.size() ; i++ ) {
+				Upload& u = uploads[i] ;
+				if (!oks[i]) continue ;
+				try {
+					_install(u,trash_s) ;
+					trace("done",u.jn_s,u.sz) ;
+				} catch (::string const& e) {
+					oks[i] = false ;
+					unlnk(dir_fd,no_slash(u.tmp_s),true/*dir_ok*/) ;
+					_s_record_err("cannot install "+no_slash(u.jn_s)+" in "+no_slash(dir_s)+" : "+e) ;
+				}
+			}
 		}
+		_empty_trash(trash_s) ;
+		for( size_t i=0 ; i<uploads.size() ; i++ ) if (oks[i]) _update_match(uploads[i]) ;
+	}
+
+	void DirCache::_upload(Upload& upload) {
+		::string const& jn_s     = upload.jn_s     ;
+		JobInfo&        job_info = upload.job_info ;
+		NfsGuard        nfs_guard{ upload.reliable_dirs } ;
+		Trace trace("DirCache::_upload",jn_s) ;
 		// remove useless info
 		job_info.start.pre_start.seq_id    = 0  ;                                                         // no seq_id   since no execution
 		job_info.start.start    .small_id  = 0  ;                                                         // no small_id since no execution
@@ -300,50 +691,92 @@ namespace Caches {
 			td.extra_tflags = {} ;
 		}
 		job_info.end.end.digest.end_date = {} ;
-		// check deps
-		for( auto const& [dn,dd] : job_info.end.end.digest.deps ) if (!dd.is_crc) return false/*ok*/ ;
-		//
-		mk_dir_s(dir_fd,jn_s) ;
-		AutoCloseFd dfd = open_read(dir_fd,no_slash(jn_s)) ;
-		//
-		// upload is the only one to take several locks and it starts with the global lock
-		// this way, we are sure to avoid deadlocks
-		LockedFd lock2{ dir_fd , true/*exclusive*/ } ;                                                    // because we manipulate LRU and because we take several locks, need exclusive
-		LockedFd lock { dfd    , true/*exclusive*/ } ;                                                    // because we write the data , need exclusive
 		//
-		Sz old_sz = _lru_remove(jn_s) ;
-		Sz new_sz = 0                 ;
-		unlnk_inside_s(dfd) ;
+		upload.tmp_s = _tmp_s() ;
+		unlnk   (dir_fd,no_slash(upload.tmp_s),true/*dir_ok*/) ;                                          // in case a previous process with the same pid left it behind
+		mk_dir_s(dir_fd,upload.tmp_s) ;
+		AutoCloseFd dfd = open_read(dir_fd,no_slash(upload.tmp_s)) ;
 		//
-		bool made_room = false ;
 		try {
 			// store meta-data
-			::string data_file = dir_s+jn_s+"data" ;
-			::string deps_file = dir_s+jn_s+"deps" ;
+			::string data_file = dir_s+upload.tmp_s+"data" ;
+			::string deps_file = dir_s+upload.tmp_s+"deps" ;
 			//
 			job_info.write(data_file) ;
 			serialize(OFStream(deps_file),job_info.end.end.digest.deps) ;                                 // store deps in a compact format so that matching is fast
 			//
-			/**/                                       new_sz += FileInfo(data_file           ).sz ;
-			/**/                                       new_sz += FileInfo(deps_file           ).sz ;
-			for( auto const& [tn,_] : digest.targets ) new_sz += FileInfo(nfs_guard.access(tn)).sz ;
-			_mk_room(old_sz,new_sz) ;
-			made_room = true ;
-			for( NodeIdx ti=0 ; ti<digest.targets.size() ; ti++ ) {
-				auto const& entry = digest.targets[ti] ;
-				trace("copy",entry.first,dfd,ti) ;
-				cpy( dfd , ::to_string(ti) , entry.first , false/*unlnk_dst*/ , true/*mk_read_only*/ ) ;
-				if (FileSig(entry.first)!=entry.second.sig) throw "unstable "+entry.first ;               // ensure cache entry is reliable by checking file *after* copy
+			Sz total_sz = 0 ;                                                                             // including blobs
+			upload.sz = 0 ;                                                                               // excluding blobs, blob candidates are accounted for when they are installed
+			/**/                                                   upload.sz += FileInfo(data_file).sz ;
+			/**/                                                   upload.sz += FileInfo(deps_file).sz ;
+			/**/                                                   total_sz   = upload.sz              ;
+			upload.blobs.reserve(upload.targets.size()) ;
+			for( NodeIdx ti=0 ; ti<upload.targets.size() ; ti++ ) {
+				Sz       tsz  = FileInfo(nfs_guard.access(upload.targets[ti].first)).sz ;
+				::string blob = _blob(job_info.end.end.digest.targets[ti].second.crc) ;
+				/**/        total_sz  += tsz ;
+				if (!blob)  upload.sz += tsz ;
+				upload.blobs.push_back(::move(blob)) ;
+			}
+			if (total_sz>sz) throw "cannot store entry of size "s+total_sz+" in cache of size "+sz ;       // no need to copy if it cannot fit, room is made once data are copied
+			for( NodeIdx ti=0 ; ti<upload.targets.size() ; ti++ ) {
+				auto const& [tn,sig] = upload.targets[ti] ;
+				::string    dst      = ::to_string(ti)    ;
+				::string const& blob = upload.blobs[ti]   ;
+				if ( +blob && hard_lnk(dfd,dst,blobs_fd,blob) ) {                                         // content is already in cache, no copy and no need to check target stability
+					trace("share",tn,dfd,ti,blob) ;                                                       // blob may disappear before entry is installed, but we hold its content
+					continue ;
+				}
+				trace("copy",tn,dfd,ti) ;
+				cpy( dfd , dst , tn , false/*unlnk_dst*/ , true/*mk_read_only*/ ) ;                        // reflink if possible
+				if (FileSig(tn)!=sig) throw "unstable "+tn ;                                              // ensure cache entry is reliable by checking file *after* copy
 			}
 		} catch (::string const& e) {
 			trace("failed",e) ;
-			unlnk_inside_s(dfd) ;                                                                         // clean up in case of partial execution
-			_mk_room( made_room?new_sz:old_sz , 0 ) ;                                                     // finally, we did not populate the entry
-			return false/*ok*/ ;
+			unlnk(dir_fd,no_slash(upload.tmp_s),true/*dir_ok*/) ;                                         // clean up in case of partial execution
+			throw ;
+		}
+	}
+
+	void DirCache::_install( Upload& upload , ::vector_s& trash_s ) {
+		Trace trace("DirCache::_install",upload.jn_s,upload.sz) ;
+		AutoCloseFd tmp_fd = open_read(dir_fd,no_slash(upload.tmp_s)) ;
+		_ref_blobs(upload,tmp_fd) ;                                                                       // before previous content is evicted as it may share blobs with us
+		try {
+			LruIdx idx = _lru_idx(upload.jn_s) ;
+			if (+idx) {                                                                                   // previous content of entry is replaced
+				_lru_unlink(idx) ;
+				_lru_free  (idx) ;
+			}
+			_evict  (upload.jn_s,trash_s) ;                                                               // entry dir may exist even if not in index, e.g. after a crash
+			_mk_room(upload.sz  ,trash_s) ;
+			idx = _lru_alloc(upload.jn_s) ;
+			serialize(OFStream(dir_s+upload.tmp_s+"lru"  ),idx         ) ;
+			serialize(OFStream(dir_s+upload.tmp_s+"blobs"),upload.blobs) ;
+			mk_dir_s(dir_fd,dir_name_s(upload.jn_s)) ;
+			if (::renameat( dir_fd , no_slash(upload.tmp_s).c_str() , dir_fd , no_slash(upload.jn_s).c_str() )!=0) {
+				_lru_free(idx) ;
+				throw "cannot rename "+no_slash(upload.tmp_s)+" to "+no_slash(upload.jn_s)+" : "+::strerror(errno) ;
+			}
+			lru_file.at(idx).sz = upload.sz ;
+			_lru_first(idx) ;
+		} catch (::string const&) {
+			_unref_blobs(upload.blobs) ;
+			throw ;
 		}
-		_lru_first(jn_s,new_sz) ;
-		trace("done",new_sz) ;
-		return true/*ok*/ ;
+	}
+
+	void DirCache::_update_match(Upload const& upload) {
+		::string    job_s = upload.jn_s.substr(0,upload.jn_s.size()-repo_s.size()) ;
+		::string    id    = no_slash(repo_s)                                       ;
+		AutoCloseFd jfd   = open_read(dir_fd,no_slash(job_s))                      ;
+		LockedFd    lock  { jfd , true/*exclusive*/ }                              ;                  // because we write the match tree, need exclusive
+		::string    file  = dir_s+job_s+"match"                                    ;
+		MatchTree   tree  ;
+		tree.read(file) ;
+		tree.erase([&](::string const& r)->bool { return r==id || !is_target(jfd,r+"/data") ; }) ; // suppress our previous entry and evicted ones
+		tree.insert(id,upload.job_info.end.end.digest.deps) ;
+		tree.write(file) ;
 	}
 
 }
@@ -3,33 +3,123 @@
 // This program is free software: you can redistribute/modify under the terms of the GPL-v3 (https://www.gnu.org/licenses/gpl-3.0.html).
 // This program is distributed WITHOUT ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
 
+#pragma once
+
 #include "core.hh"
 
 #include <grp.h>
 
+#include <latch>
+#include <semaphore>
+
 namespace Caches {
 
-	struct DirCache : Cache {     // PER_CACHE : inherit from Cache and provide implementation
-		using Sz = Disk::DiskSz ;
-		static constexpr char HeadS[] = ADMIN_DIR_S ;
+	struct DirCache : Cache {                                                      // PER_CACHE : inherit from Cache and provide implementation
+		using Sz      = Disk::DiskSz ;
+		using LruIdx  = uint32_t     ;
+		using NameIdx = uint32_t     ;
+		using BlobIdx = uint32_t     ;
+		static constexpr char   HeadS[]            = ADMIN_DIR_S ;
+		static constexpr size_t MaxPendingUploads  = 16          ;                 // beyond that, engine waits for upload thread, which bounds memory
+		static constexpr size_t MaxDownloadThreads = 8           ;                 // targets are downloaded in parallel on a pool of threads to hide file system latency
+		static constexpr time_t MaxTmpAge          = 24*3600     ;                 // in s, private dirs in LMAKE/tmp older than that have been left behind by a crashed process
+		// START_OF_VERSIONING
+		struct LruHdr {
+			LruIdx first    = 0 ;                                                  // most  recently used entry
+			LruIdx last     = 0 ;                                                  // least recently used entry
+			Sz     total_sz = 0 ;                                                  // overall size of entries
+			Sz     blobs_sz = 0 ;                                                  // overall size of blobs, accounted once whatever the number of entries sharing them
+		} ;
+		struct LruEntry {
+			LruIdx  prev = 0 ;                                                     // more recently used entry, 0 if first or not linked
+			LruIdx  next = 0 ;                                                     // less recently used entry, 0 if last  or not linked
+			Sz      sz   = 0 ;                                                     // size of entry, excluding blobs
+			NameIdx name = 0 ;                                                     // entry_s, used to evict entry and to check per-entry lru file is not stale
+		} ;
+		using LruFile  = Store::AllocFile       < false/*AutoLock*/ , LruHdr , LruIdx  , LruEntry                  > ;
+		using NameFile = Store::VectorFile      < false/*AutoLock*/ , void   , NameIdx , char                      > ;
+		using BlobFile = Store::SinglePrefixFile< false/*AutoLock*/ , void   , BlobIdx , char , uint32_t/*refs*/ > ; // blob name -> number of entries using it
+		// END_OF_VERSIONING
+		struct LruLock {                                                           // short byte-range lock on LRU index, shared with other processes and with other threads using another fd
+			LruLock ( DirCache& , Fd ) ;
+			~LruLock(                ) ;
+			Fd fd ;
+		} ;
+		struct Src {                                                               // snapshot of a target in a cache entry, taken under entry lock
+			FileTag       tag = FileTag::None       ;
+			AutoCloseFd   fd  = {}                  ;                              // if regular and copied
+			::string      lnk = {}                  ;                              // if symbolic link
+		} ;
+		struct Upload {
+			DirCache*               self          = nullptr ;
+			::string                jn_s          = {}      ;
+			JobInfo                 job_info      = {}      ;
+			::vmap_s<Disk::FileSig> targets       = {}      ;                      // sigs as seen at end of job, targets must not have moved when copied
+			bool                    reliable_dirs = false   ;
+			::string                tmp_s         = {}      ;                      // filled in by upload thread : private dir where entry is prepared before being installed
+			::vector_s              blobs         = {}      ;                      // .                          : blob per target, empty if target is not shared
+			Sz                      sz            = 0       ;                      // .                          : excluding blobs
+		} ;
+		using DownloadQueue = ThreadDeque<::function<void()>,true/*Flush*/> ;
+		// statics
+	private :
+		static void _s_upload_thread_func(Upload&&                ) ;
+		static void _s_download_func     ( ::stop_token , size_t id ) ;
+		// static data
+		static ::counting_semaphore<MaxPendingUploads> _s_upload_slots      ;
+		static ::umap<DirCache*,::vector<Upload>>      _s_upload_batch      ;      // only accessed from upload thread
+		static DownloadQueue                           _s_download_queue    ;      // chunks of downloads executed by download threads
+		static ::vector<::jthread>                     _s_download_threads  ;      // ensure threads are after their queue so they are stopped before it is destructed
+		static DequeThread<Upload>                     _s_upload_thread     ;      // ensure _s_upload_thread is last so it is flushed before other static data are destructed
 		// services
+	public :
 		virtual void config(Config::Cache const&) ;
 		//
-		virtual Match      match   ( Job , Req                                                   ) ;
-		virtual JobInfo    download( Job , Id        const& , JobReason const& , Disk::NfsGuard& ) ;
-		virtual bool/*ok*/ upload  ( Job , JobDigest const& ,                    Disk::NfsGuard& ) ;
+		virtual Match          match   ( Job , Req                                                   ) ;
+		virtual JobInfo        download( Job , Id        const& , JobReason const& , Disk::NfsGuard& ) ;
+		virtual bool/*queued*/ upload  ( Job , JobDigest const& ,                    Disk::NfsGuard& ) ; // actual upload is done in upload thread
 		//
-		void chk(ssize_t delta_sz=0) const ;
+		// used by caches built on top of DirCache
+		bool/*queued*/     upload    ( Job , JobInfo&& , ::vmap_s<Disk::FileSig>&& targets , bool reliable_dirs ) ; // upload in upload thread
+		::optional<Upload> mk_upload ( Job , JobInfo&& , ::vmap_s<Disk::FileSig>&& targets , bool reliable_dirs ) ; // empty if job cannot be cached, must be called from engine thread
+		void               upload_now( Upload&&                                                                  ) ; // upload synchronously, from a thread of its own if this cache is never fed to upload thread
+		//
+		void chk(ssize_t delta_sz=0) const ;                                      // must be called with LruLock held
 	private :
-		::string _lru_file  ( ::string const& entry_s             ) const { return dir_s+entry_s+"lru" ; }
-		Sz       _lru_remove( ::string const& entry_s             ) ;
-		void     _lru_first ( ::string const& entry_s , Sz sz     ) ;
-		void     _mk_room   ( Sz old_sz               , Sz new_sz ) ;
+		// LRU index accesses, must be called with LruLock held
+		LruIdx             _lru_idx   ( ::string const& entry_s ) ;                // 0 if entry is not in index
+		LruIdx             _lru_alloc ( ::string const& entry_s ) ;                // allocated entry is not linked
+		void               _lru_free  ( LruIdx                  ) ;
+		bool/*was_linked*/ _lru_unlink( LruIdx                  ) ;
+		void               _lru_first ( LruIdx                  ) ;
+		void               _mk_room   ( Sz new_sz , ::vector_s& trash_s ) ;        // evict entries so that new_sz can be linked in, victims are moved to trash_s
+		void               _evict     ( ::string const& entry_s , ::vector_s& trash_s ) ; // move entry dir to a private dir in LMAKE/tmp, which is recorded in trash_s
+		uint32_t           _blob_refs    ( ::string const&            ) const ;    // number of entries using blob
+		void               _set_blob_refs( ::string const& , uint32_t )       ;
+		void               _ref_blobs    ( Upload& , Fd tmp_fd        )       ;    // share or publish blobs of an entry being installed, and account for them
+		void               _unref_blobs  ( ::vector_s const&          )       ;    // unlink blobs no more used by any entry
+		// no lock needed
+		void     _empty_trash( ::vector_s const& trash_s ) ;                       // unlink evicted entries
+		::string _tmp_s      (                           ) ;                       // a fresh private dir name in LMAKE/tmp, unique among all users of the cache
+		::string _blob       ( Hash::Crc                 ) const ;                 // blob name in blobs dir, empty if crc does not designate a shareable content
+		//
+		void       _download_targets( JobInfo& , ::vector<Src> const& , ::atomic<NodeIdx>& n_started ) ;
+		//
+		void _upload_batch( ::vector<Upload>& ) ;
+		void _upload      ( Upload&           ) ;                                  // prepare entry in upload.tmp_s without holding any lock, throw if not possible
+		void _install     ( Upload& , ::vector_s& trash_s ) ;                      // must be called with LruLock held, move entry from upload.tmp_s to its final place
+		void _update_match( Upload const&     ) ;
 		// data
-		::string repo_s ;
-		::string dir_s  ;
-		Fd       dir_fd ;
-		Sz       sz     = 0 ;
+		::string repo_s         ;
+		::string dir_s          ;
+		Fd       dir_fd         ;
+		Fd       lru_fd         ;                                                  // used to lock LRU index from engine thread
+		Fd       upload_lru_fd  ;                                                  // used to lock LRU index from upload thread, OFD locks exclude each other even within a process
+		Fd       blobs_fd       ;                                                  // content-addressed store, entry targets are hard links to blobs
+		LruFile  lru_file       ;
+		NameFile name_file      ;
+		BlobFile blob_file      ;
+		Sz       sz             = 0 ;
 	} ;
 
 }
@@ -0,0 +1,103 @@
+// This file is part of the open-lmake distribution (git@github.com:cesar-douady/open-lmake.git)
+// Copyright (c) 2023 Doliam
+// This program is free software: you can redistribute/modify under the terms of the GPL-v3 (https://www.gnu.org/licenses/gpl-3.0.html).
+// This program is distributed WITHOUT ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+#include "tiered_cache.hh"
+
+using namespace Disk ;
+
+namespace Caches {
+
+	::atomic<size_t>              TieredCache::_s_n_shared_uploads    = 0 ;
+	DequeThread<DirCache::Upload> TieredCache::_s_shared_upload_thread    ;
+
+	void TieredCache::_s_shared_upload_thread_func(DirCache::Upload&& upload) {
+		upload.self->upload_now(::move(upload)) ;                             // shared tier is never fed to DirCache upload thread, so upload_lru_fd is ours
+		_s_n_shared_uploads-- ;
+	}
+
+	void TieredCache::config(Config::Cache const& config) {
+		Config::Cache local_config  ; local_config .tag = Tag::Dir ;
+		Config::Cache shared_config ; shared_config.tag = Tag::Dir ;
+		//
+		for( auto const& [k,v] : config.dct ) {
+			switch (k[0]) {
+				case 'l' : if (k=="local"        ) { local_config .dct.emplace_back("dir" ,v) ;                                   continue ; } break ;
+				case 'r' : if (k=="repo"         ) { local_config .dct.emplace_back("repo",v) ; shared_config.dct.emplace_back(k,v) ; continue ; } break ;
+				case 's' : if (k=="shared"       ) { shared_config.dct.emplace_back("dir" ,v) ;                                   continue ; }
+				/**/       if (k=="shared_upload") { shared_upload = v=="True" || v=="1" ;                                        continue ; } break ;
+			DN}
+			throw "unexpected cache entry : "+k ;
+		}
+		//
+		try                       { local .config(local_config ) ; }
+		catch (::string const& e) { throw "local tier : " +e ;     }
+		try                       { shared.config(shared_config) ; }
+		catch (::string const& e) { throw "shared tier : "+e ;     }
+		//
+		static bool s_thread_opened = false ;
+		if (!s_thread_opened) {
+			_s_shared_upload_thread.open('V',_s_shared_upload_thread_func) ;
+			s_thread_opened = true ;
+		}
+	}
+
+	Cache::Match TieredCache::match( Job job , Req req ) {
+		Trace trace("TieredCache::match",job,req) ;
+		Match local_match = local.match(job,req) ;
+		if (local_match.hit==Yes) { trace("local_hit") ; local_match.id.insert(0,1,LocalPfx) ; return local_match ; }
+		Match shared_match = shared.match(job,req) ;
+		if (shared_match.hit==Yes) { trace("shared_hit") ; shared_match.id.insert(0,1,SharedPfx) ; return shared_match ; }
+		// no hit, ask for deps needed by either tier
+		if (local_match.hit==No) return shared_match ;
+		if (shared_match.hit==Maybe) {
+			::uset<Node> new_deps = mk_uset(local_match.new_deps) ;
+			for( Node d : shared_match.new_deps ) if (new_deps.insert(d).second) local_match.new_deps.push_back(d) ;
+		}
+		return local_match ;
+	}
+
+	JobInfo TieredCache::download( Job job , Id const& id , JobReason const& reason , NfsGuard& nfs_guard ) {
+		Trace trace("TieredCache::download",job,id) ;
+		SWEAR(+id) ;
+		Id sub_id = id.substr(1) ;
+		switch (id[0]) {
+			case LocalPfx  : return local.download(job,sub_id,reason,nfs_guard) ;
+			case SharedPfx : {
+				JobInfo job_info = shared.download(job,sub_id,reason,nfs_guard) ;
+				// promote entry to local tier, so that next hits on this host do not access shared tier
+				::vmap_s<FileSig> targets ; targets.reserve(job_info.end.end.digest.targets.size()) ;
+				for( auto const& [tn,td] : job_info.end.end.digest.targets ) targets.emplace_back(tn,td.sig) ;
+				bool promoted = local.upload( job , ::copy(job_info) , ::move(targets) , nfs_guard.reliable_dirs ) ;
+				trace("promote",STR(promoted)) ;
+				return job_info ;
+			}
+		DF}
+	}
+
+	bool/*queued*/ TieredCache::upload( Job job , JobDigest const& digest , NfsGuard& nfs_guard ) {
+		::vmap_s<FileSig> targets  ; targets.reserve(digest.targets.size()) ;
+		JobInfo           job_info = job.job_info()                        ;                    // read once for both tiers
+		for( auto const& [tn,td] : digest.targets ) targets.emplace_back(tn,td.sig) ;
+		Trace trace("TieredCache::upload",job) ;
+		bool queued = false ;
+		if (shared_upload) {
+			if (_s_n_shared_uploads<MaxPendingSharedUploads) {                                       // only engine increments, so no race between check and increment
+				::optional<DirCache::Upload> upload = shared.mk_upload( job , ::copy(job_info) , ::copy(targets) , nfs_guard.reliable_dirs ) ;
+				if (upload) {
+					_s_n_shared_uploads++ ;
+					//vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+					_s_shared_upload_thread.emplace(::move(*upload)) ;
+					//^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
+					queued = true ;
+				}
+			} else {
+				trace("shared_full") ;                                                                // shared tier cannot keep up, it is only an optimization
+			}
+		}
+		queued |= local.upload( job , ::move(job_info) , ::move(targets) , nfs_guard.reliable_dirs ) ;
+		return queued ;
+	}
+
+}
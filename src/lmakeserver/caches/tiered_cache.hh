@@ -0,0 +1,40 @@
+// This file is part of the open-lmake distribution (git@github.com:cesar-douady/open-lmake.git)
+// Copyright (c) 2023 Doliam
+// This program is free software: you can redistribute/modify under the terms of the GPL-v3 (https://www.gnu.org/licenses/gpl-3.0.html).
+// This program is distributed WITHOUT ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+#pragma once
+
+#include "dir_cache.hh"
+
+namespace Caches {
+
+	// a fast host-local DirCache in front of a shared DirCache :
+	// - match/download : read-through, local tier is tried first, shared hits are promoted to local tier
+	// - upload         : write-back, local tier is filled from the DirCache upload thread and shared tier from a thread of its own, so engine waits for neither
+	//                    if too many shared uploads are pending, new ones are dropped as shared tier is only an optimization
+	//                    until its upload is installed, a job misses in local tier, which is harmless as its targets could not be served before that anyway
+	struct TieredCache : Cache {                                               // PER_CACHE : inherit from Cache and provide implementation
+		static constexpr char   LocalPfx                = 'L' ;                // prefix of ids returned by match, so that download knows which tier to read from
+		static constexpr char   SharedPfx               = 'S' ;                // .
+		static constexpr size_t MaxPendingSharedUploads = 64  ;                // beyond that, shared uploads are dropped, which bounds memory without ever blocking engine
+		// statics
+	private :
+		static void _s_shared_upload_thread_func(DirCache::Upload&&) ;
+		// static data
+		static ::atomic<size_t>              _s_n_shared_uploads    ;          // number of uploads queued or in progress in _s_shared_upload_thread
+		static DequeThread<DirCache::Upload> _s_shared_upload_thread ;         // ensure _s_shared_upload_thread is last so it is flushed before other static data are destructed
+		// services
+	public :
+		virtual void config(Config::Cache const&) ;
+		//
+		virtual Match          match   ( Job , Req                                                   ) ;
+		virtual JobInfo        download( Job , Id        const& , JobReason const& , Disk::NfsGuard& ) ;
+		virtual bool/*queued*/ upload  ( Job , JobDigest const& ,                    Disk::NfsGuard& ) ;
+		// data
+		DirCache local         ;
+		DirCache shared        ;
+		bool     shared_upload = true ;                                        // if false, shared tier is only read, e.g. when it is populated by a reference build
+	} ;
+
+}
@@ -607,6 +607,7 @@ namespace Engine {
 								if (+start.timeout                ) push_entry( "timeout"     , start.timeout.short_str()              ) ;
 								if ( sa.tag!=BackendTag::Local    ) push_entry( "backend"     , snake_str(sa.tag)                      ) ;
 								if ( start.use_script             ) push_entry( "use_script"  , "true"                                 ) ;
+								if (+start.zygote_sz              ) push_entry( "use_zygote"  , "true"                                 ) ;
 							}
 							//
 							::map_ss allocated_rsrcs = mk_map(job_info.start.rsrcs) ;
@@ -629,6 +630,7 @@ namespace Engine {
 									push_entry( "elapsed in job" , ::to_string(double(digest.stats.job  )) , Color::None , false ) ;
 									push_entry( "elapsed total"  , ::to_string(double(digest.stats.total)) , Color::None , false ) ;
 									push_entry( "used mem"       , ::to_string(       digest.stats.mem   ) , Color::None , false ) ;
+									push_entry( "access reports" , ::to_string(       digest.stats.n_access_reports ) , Color::None , false ) ;
 									push_entry( "cost"           , ::to_string(double(job->cost         )) , Color::None , false ) ;
 								} else {
 									::string const& mem_rsrc_str = allocated_rsrcs.contains("mem") ? allocated_rsrcs.at("mem") : required_rsrcs.contains("mem") ? required_rsrcs.at("mem") : ""s ;
@@ -644,6 +646,7 @@ namespace Engine {
 									push_entry( "elapsed in job" , digest.stats.job  .short_str()                                       ) ;
 									push_entry( "elapsed total"  , digest.stats.total.short_str()                                       ) ;
 									push_entry( "used mem"       , mem_str                        , overflow?Color::Warning:Color::None ) ;
+									push_entry( "access reports" , ::to_string(digest.stats.n_access_reports)                       ) ;
 									push_entry( "cost"           , job->cost         .short_str()                                       ) ;
 								}
 							}
@@ -858,20 +861,8 @@ namespace Engine {
 					}
 					if (prio!=-Infinity) _send_job( fd , ro , always?Yes:Maybe , false/*hide*/ , job ) ; // actual job is output last as this is what user views first
 				} break ;
-				case ReqKey::InvDeps :
-					for( Job j : Persistent::job_lst() )
-						for( Dep const& d : j->deps ) if (d==target) {
-							_send_job( fd , ro , No , false/*hide*/ , j , lvl ) ;
-							break ;
-						}
-				break ;
-				case ReqKey::InvTargets :
-					for( Job j : Persistent::job_lst() )
-						for( Target const& t : j->targets ) if (t==target) {
-							_send_job( fd , ro , No , false/*hide*/ , j , lvl ) ;
-							break ;
-						}
-				break ;
+				case ReqKey::InvDeps    : for( Job j : target.inv_deps   () ) _send_job( fd , ro , No , false/*hide*/ , j , lvl ) ; break ;
+				case ReqKey::InvTargets : for( Job j : target.inv_targets() ) _send_job( fd , ro , No , false/*hide*/ , j , lvl ) ; break ;
 			DF}
 		}
 		if (porcelaine) audit( fd , ro , "}" , true/*as_is*/ ) ;
@@ -12,7 +12,7 @@ using namespace Time ;
 
 namespace Engine {
 
-	ThreadDeque<EngineClosure> g_engine_queue ;
+	ThreadMpsc<EngineClosure> g_engine_queue ;
 
 	static ::string _audit_indent( ::string&& t , DepDepth l , char sep=0 ) {
 		if (!l) {
@@ -74,8 +74,10 @@ namespace Engine {
 	::ostream& operator<<( ::ostream& os , Config::Backend const& be ) {
 		os << "Backend(" ;
 		if (be.configured) {
-			if (+be.ifce) os << be.ifce <<',' ;
-			/**/          os << be.dct        ;
+			if (+be.ifce            ) os << be.ifce <<','       ;
+			if ( be.relay           ) os << "relay,"            ;
+			if ( be.precompute_start) os << "precompute_start," ;
+			/**/                      os << be.dct              ;
 		}
 		return os <<')' ;
 	}
@@ -114,8 +116,10 @@ namespace Engine {
 			for( auto const& [py_k,py_v] : py_map ) {
 				field = py_k.as_a<Str>() ;
 				::string v = py_v==True ? "1"s : py_v==False ? "0"s : ::string(*py_v.str()) ;
-				if (field=="interface") ifce = v ;
-				else                    dct.emplace_back(field,v) ;
+				if      (field=="interface"       ) ifce             = v                    ;
+				else if (field=="relay"           ) relay            = from_string<bool>(v) ;
+				else if (field=="precompute_start") precompute_start = from_string<bool>(v) ;
+				else                                dct.emplace_back(field,v)               ;
 			}
 		} catch(::string const& e) {
 			throw "while processing "+field+e ;
@@ -139,6 +143,7 @@ namespace Engine {
 			fields[0] = "max_error_lines"     ; if (py_map.contains(fields[0])) max_err_lines          = size_t                    (py_map[fields[0]].as_a<Int  >())           ;
 			fields[0] = "network_delay"       ; if (py_map.contains(fields[0])) network_delay          = Time::Delay               (py_map[fields[0]].as_a<Float>())           ;
 			fields[0] = "path_max"            ; if (py_map.contains(fields[0])) path_max               = size_t                    (py_map[fields[0]].as_a<Int  >())           ;
+			fields[0] = "python_evaluators"   ; if (py_map.contains(fields[0])) n_py_evaluators        = uint8_t                   (py_map[fields[0]].as_a<Int  >())           ;
 			fields[0] = "reliable_dirs"       ; if (py_map.contains(fields[0])) reliable_dirs          =                           +py_map[fields[0]]                          ;
 			fields[0] = "has_split_rules"     ; if (py_map.contains(fields[0])) has_split_rules        =                           +py_map[fields[0]]                          ;
 			fields[0] = "has_split_srcs"      ; if (py_map.contains(fields[0])) has_split_srcs         =                           +py_map[fields[0]]                          ;
@@ -298,6 +303,7 @@ namespace Engine {
 		/**/                             res << "\tnetwork_delay       : " << network_delay .short_str() <<'\n' ;
 		if (path_max!=size_t(-1)       ) res << "\tpath_max            : " << size_t(path_max     )      <<'\n' ;
 		else                             res << "\tpath_max            : " <<        "<unlimited>"       <<'\n' ;
+		if (n_py_evaluators            ) res << "\tpython_evaluators   : " << size_t(n_py_evaluators)    <<'\n' ;
 		//
 		if (+caches) {
 			res << "\tcaches :\n" ;
@@ -341,12 +347,16 @@ namespace Engine {
 			res <<"\t\t"<< snake(t) <<'('<< (bbe->is_local()?"local":"remote") <<") :\n" ;
 			::vmap_ss descr = bbe->descr()   ;
 			size_t    w     = 4/*len(addr)*/ ;
-			if ( !bbe->is_local() )           w = ::max(w,size_t(4)/*len(addr)*/) ;
-			for( auto const& [k,v] : be.dct ) w = ::max(w,k.size()              ) ;
-			for( auto const& [k,v] : descr  ) w = ::max(w,k.size()              ) ;
-			if ( !bbe->is_local() )           res <<"\t\t\t"<< ::setw(w)<<"addr" <<" : "<< SockFd::s_addr_str(bbe->addr) <<'\n' ;
-			for( auto const& [k,v] : be.dct ) res <<"\t\t\t"<< ::setw(w)<<k      <<" : "<< v                             <<'\n' ;
-			for( auto const& [k,v] : descr  ) res <<"\t\t\t"<< ::setw(w)<<k      <<" : "<< v                             <<'\n' ;
+			if ( !bbe->is_local()     )       w = ::max(w,size_t( 4)/*len(addr)*/            ) ;
+			if (  be.relay            )       w = ::max(w,size_t( 5)/*len(relay)*/           ) ;
+			if (  be.precompute_start )       w = ::max(w,size_t(16)/*len(precompute_start)*/) ;
+			for( auto const& [k,v] : be.dct ) w = ::max(w,k.size()                           ) ;
+			for( auto const& [k,v] : descr  ) w = ::max(w,k.size()                           ) ;
+			if ( !bbe->is_local()     )       res <<"\t\t\t"<< ::setw(w)<<"addr"            <<" : "<< SockFd::s_addr_str(bbe->addr) <<'\n' ;
+			if (  be.relay            )       res <<"\t\t\t"<< ::setw(w)<<"relay"           <<" : "<< "true"                         <<'\n' ;
+			if (  be.precompute_start )       res <<"\t\t\t"<< ::setw(w)<<"precompute_start"<<" : "<< "true"                         <<'\n' ;
+			for( auto const& [k,v] : be.dct ) res <<"\t\t\t"<< ::setw(w)<<k                 <<" : "<< v                             <<'\n' ;
+			for( auto const& [k,v] : descr  ) res <<"\t\t\t"<< ::setw(w)<<k                 <<" : "<< v                             <<'\n' ;
 			if (+be.ifce)                     res <<indent<'\t'>(be.ifce,3)                                              <<'\n' ;
 		}
 		//
@@ -12,6 +12,7 @@
 ENUM( CacheTag // PER_CACHE : add a tag for each cache method
 ,	None
 ,	Dir
+,	Tiered
 )
 
 ENUM( Color
@@ -143,6 +144,7 @@ namespace Engine {
 		Time::Delay    heartbeat_tick  ;                                              // min time between successive heartbeat probes
 		DepDepth       max_dep_depth   = 1000 ; static_assert(DepDepth(1000)==1000) ; // ensure default value can be represented
 		Time::Delay    network_delay   ;
+		uint8_t        n_py_evaluators = 0    ;                                       // number of processes evaluating dynamic attributes, if 0 <=> evaluate within server
 		size_t         path_max        = -1   ;                                       // if -1 <=> unlimited
 		bool           has_split_rules ;                                              // if true <=> read independently of config
 		bool           has_split_srcs  ;                                              // .
@@ -162,14 +164,18 @@ namespace Engine {
 			// services
 			bool operator==(Backend const&) const = default ;
 			template<IsStream T> void serdes(T& s) {
-				::serdes(s,ifce      ) ;
-				::serdes(s,dct       ) ;
-				::serdes(s,configured) ;
+				::serdes(s,ifce            ) ;
+				::serdes(s,relay           ) ;
+				::serdes(s,precompute_start) ;
+				::serdes(s,dct             ) ;
+				::serdes(s,configured      ) ;
 			}
 			// data
-			::string  ifce       ;
-			::vmap_ss dct        ;
-			bool      configured = false ;
+			::string  ifce             ;
+			bool      relay            = false ; // if true <=> jobs communicate with server through a per host relay (cf. job_relay.cc)
+			bool      precompute_start = false ; // if true <=> start attributes are evaluated when job is launched rather than when it connects to start
+			::vmap_ss dct              ;
+			bool      configured       = false ;
 		} ;
 
 		struct Console {
@@ -289,14 +295,15 @@ namespace Engine {
 		friend ::ostream& operator<<( ::ostream& , EngineClosureJobEnd const& ) ;
 		::vmap_ss  rsrcs = {} ;
 		JobInfoEnd end   = {} ;
+		JobEndPrep prep  = {} ;
 	} ;
 
 	struct EngineClosureJob {
 		friend ::ostream& operator<<( ::ostream& , EngineClosureJob const& ) ;
 		// cxtors & casts
-		EngineClosureJob( JobRpcProc p , JobExec const& je , EngineClosureJobStart&& ecjs ) : proc{p} , job_exec{je} , start{ecjs} {}
-		EngineClosureJob( JobRpcProc p , JobExec const& je , EngineClosureJobEtc  && ecje ) : proc{p} , job_exec{je} , etc  {ecje} {}
-		EngineClosureJob( JobRpcProc p , JobExec const& je , EngineClosureJobEnd  && ecje ) : proc{p} , job_exec{je} , end  {ecje} {}
+		EngineClosureJob( JobRpcProc p , JobExec const& je , EngineClosureJobStart&& ecjs ) : proc{p} , job_exec{je} , start{::move(ecjs)} {}
+		EngineClosureJob( JobRpcProc p , JobExec const& je , EngineClosureJobEtc  && ecje ) : proc{p} , job_exec{je} , etc  {::move(ecje)} {}
+		EngineClosureJob( JobRpcProc p , JobExec const& je , EngineClosureJobEnd  && ecje ) : proc{p} , job_exec{je} , end  {::move(ecje)} {}
 		//
 		EngineClosureJob(EngineClosureJob&& ecj) : proc{ecj.proc} , job_exec{::move(ecj.job_exec)} {
 			switch (ecj.proc) {
@@ -373,9 +380,9 @@ namespace Engine {
 		EngineClosure( JRP p , JE&& je , R rq , bool rpt ) : kind{K::Job} , ecj{p,::move(je),EngineClosureJobEtc{.report=rpt,.req=rq}} { SWEAR( p==JRP::GiveUp                        ) ; }
 		EngineClosure( JRP p , JE&& je                   ) : kind{K::Job} , ecj{p,::move(je),EngineClosureJobEtc{                   }} { SWEAR( p==JRP::GiveUp || p==JRP::ReportStart ) ; }
 		//
-		EngineClosure( JRP p , JE&& je , JobRpcReq&& jrr , ::vmap_ss&& r ) :
-			kind { K::Job                                                               }
-		,	ecj  { p , ::move(je) , EngineClosureJobEnd{.rsrcs=::move(r),.end={::move(jrr)}} }
+		EngineClosure( JRP p , JE&& je , JobRpcReq&& jrr , ::vmap_ss&& r , JobEndPrep&& jep={} ) :
+			kind { K::Job                                                                                      }
+		,	ecj  { p , ::move(je) , EngineClosureJobEnd{.rsrcs=::move(r),.end={::move(jrr)},.prep=::move(jep)} }
 		{ SWEAR(p==JRP::End) ; }
 		// JobMngt
 		EngineClosure( JMP p , JE&& je , ::string&& t                       ) : kind{K::JobMngt} , ecjm{.proc=p,.job_exec=::move(je),.txt=::move(t)             } { SWEAR(p==JMP::LiveOut) ; }
@@ -411,7 +418,7 @@ namespace Engine {
 		} ;
 	} ;
 
-	extern ThreadDeque<EngineClosure,true/*Flush*/> g_engine_queue ;
+	extern ThreadMpsc<EngineClosure,true/*Flush*/> g_engine_queue ;
 
 }
 
@@ -189,13 +189,14 @@ namespace Engine {
 		return os <<')' ;
 	}
 
-	Job::Job( Rule::SimpleMatch&& match , Req req , DepDepth lvl ) {
-		Trace trace("Job",match,req,lvl) ;
+	Job::Job( Rule::SimpleMatch&& match , Req req , DepDepth lvl , ::vmap_s<DepSpec>* dep_names_ ) {
+		Trace trace("Job",match,req,lvl,STR(dep_names_)) ;
 		if (!match) { trace("no_match") ; return ; }
 		Rule              rule      = match.rule ; SWEAR( rule->special<=Special::HasJobs , rule->special ) ;
 		::vmap_s<DepSpec> dep_names ;
 		try {
-			dep_names = rule->deps_attrs.eval(match) ;
+			if (dep_names_) dep_names = ::move(*dep_names_)           ;
+			else            dep_names = rule->deps_attrs.eval(match) ;
 		} catch (::pair_ss const& msg_err) {
 			trace("no_dep_subst") ;
 			if (+req) {
@@ -271,6 +272,40 @@ namespace Engine {
 		if (+ji.end  ) serialize( jas , ji.end   ) ;
 	}
 
+	//
+	// JobEndPrep
+	//
+
+	// resolving names into nodes and evaluating end attributes is the bulk of the work to interpret a digest that does not need the engine
+	// (nodes can be created from any thread and dynamic attributes only depend on job name and resources)
+	// targets and deps are only resolved if JobExec::end will use them, so as not to create useless nodes
+	JobEndPrep::JobEndPrep( Job job , JobDigest const& digest , ::vmap_ss const& rsrcs ) {
+		Status            status = digest.status ;
+		Rule              rule   = job->rule     ;
+		Rule::SimpleMatch match  ;
+		Trace trace("JobEndPrep",job,status,digest.targets.size(),digest.deps.size()) ;
+		if ( !is_lost(status) && status>Status::Early             ) { targets.reserve(digest.targets.size()) ; for( auto const& [tn,_ ] : digest.targets ) targets.emplace_back(tn   ) ; }
+		if ( status==Status::EarlyChkDeps || status>Status::Async ) { deps   .reserve(digest.deps   .size()) ; for( auto const& [dn,dd] : digest.deps    ) deps   .emplace_back(dn,dd) ; }
+		// do not generate error if *_none_attrs is not available, as we will not restart job when fixed : do our best by using static info
+		try {
+			cache_key = rule->cache_none_attrs.eval( job , match , &::ref(::vmap_s<DepDigest>()) ).key ;                          // we cant record deps here, but we dont care, no impact on target
+		} catch (::pair_ss const& msg_err) {
+			cache_key          = rule->cache_none_attrs.spec.key ;
+			cache_none_static  = true                            ;
+			cache_none_msg_err = msg_err                         ;
+		}
+		try                                  { allow_stderr = rule->end_cmd_attrs.eval(job,match).allow_stderr ; }
+		catch (::pair_ss const& /*msg,err*/) { end_cmd_err  = true ;                                               }
+		try {
+			max_stderr_len = rule->end_none_attrs.eval( job , match , rsrcs , &::ref(::vmap_s<DepDigest>()) ).max_stderr_len ; // .
+		} catch (::pair_ss const& msg_err) {
+			max_stderr_len   = rule->end_none_attrs.spec.max_stderr_len ;
+			end_none_static  = true                                     ;
+			end_none_msg_err = msg_err                                  ;
+		}
+		prepared = true ;
+	}
+
 	//
 	// JobExec
 	//
@@ -392,7 +427,7 @@ namespace Engine {
 		}
 	}
 
-	void JobExec::end( JobRpcReq&& jrr , bool sav_jrr , ::vmap_ss const& rsrcs ) {
+	void JobExec::end( JobRpcReq&& jrr , bool sav_jrr , ::vmap_ss const& rsrcs , JobEndPrep&& prep ) {
 		JobData&          data             = **this                                               ;
 		JobDigest&        digest           = jrr.digest                                           ;
 		Status            status           = digest.status                                        ;           // status will be modified, need to make a copy
@@ -407,27 +442,19 @@ namespace Engine {
 		::vector<Req>     running_reqs_    = data.running_reqs(true/*with_zombies*/)              ;
 		::string          local_msg        ;                                                                  // to be reported if job was otherwise ok
 		::string          severe_msg       ;                                                                  // to be reported always
-		CacheNoneAttrs    cache_none_attrs ;
-		EndCmdAttrs       end_cmd_attrs    ;
-		Rule::SimpleMatch match            ;
 		//
 		SWEAR(status!=Status::New) ;                                                                          // we just executed the job, it can be neither new, frozen or special
 		SWEAR(!frozen()          ) ;                                                                          // .
 		SWEAR(!rule->is_special()) ;                                                                          // .
-		// do not generate error if *_none_attrs is not available, as we will not restart job when fixed : do our best by using static info
-		try {
-			cache_none_attrs = rule->cache_none_attrs.eval( *this , match , &::ref(::vmap_s<DepDigest>()) ) ; // we cant record deps here, but we dont care, no impact on target
-		} catch (::pair_ss const& msg_err) {
-			cache_none_attrs = rule->cache_none_attrs.spec ;
+		if (!prep) prep = JobEndPrep(*this,digest,rsrcs) ;                                                    // not prepared ahead, do it now
+		if (prep.cache_none_static)
 			for( Req req : running_reqs_ ) {
 				req->audit_job(Color::Note,"dynamic",*this,true/*at_end*/) ;
 				::string req_msg = rule->cache_none_attrs.s_exc_msg(true/*using_static*/) ;
-				req_msg <<set_nl<< msg_err.first ;
-				req->audit_stderr( *this , req_msg , msg_err.second , -1 , 1 ) ;
+				req_msg <<set_nl<< prep.cache_none_msg_err.first ;
+				req->audit_stderr( *this , req_msg , prep.cache_none_msg_err.second , -1 , 1 ) ;
 			}
-		}
-		try                                  { end_cmd_attrs = rule->end_cmd_attrs.eval(*this,match) ;       }
-		catch (::pair_ss const& /*msg,err*/) { severe_msg << "cannot compute " << EndCmdAttrs::Msg << '\n' ; }
+		if (prep.end_cmd_err) severe_msg << "cannot compute " << EndCmdAttrs::Msg << '\n' ;
 		//
 		data.status = Status::New ;                                                                           // ensure we cannot appear up to date while working on data
 		fence() ;
@@ -442,10 +469,12 @@ namespace Engine {
 			//
 			for( Node t : data.targets ) if (t->has_actual_job(*this)) t->actual_job() = {} ;  // ensure targets we no more generate do not keep pointing to us
 			//
+			SWEAR( prep.targets.size()==digest.targets.size() , prep.targets.size() , digest.targets.size() ) ;
 			::vector<Target> targets ; targets.reserve(digest.targets.size()) ;
-			for( auto const& [tn,td] : digest.targets ) {
+			for( NodeIdx ti=0 ; ti<digest.targets.size() ; ti++ ) {
+				auto const& [tn,td] = digest.targets[ti] ;
 				Tflags tflags          = td.tflags              ;
-				Node   target          { tn }                   ;
+				Node   target          = prep.targets[ti]       ;
 				bool   static_phony    = ::static_phony(tflags) ;
 				Crc    crc             = td.crc                 ;
 				bool   target_modified = false                  ;
@@ -528,23 +557,27 @@ namespace Engine {
 				}
 			}
 			::sort(targets) ;                                                          // ease search in targets
+			::vector<Node> old_targets = data.target_nodes() ;
 			//vvvvvvvvvvvvvvvvvvvvvvvvvv
 			data.targets.assign(targets) ;
 			//^^^^^^^^^^^^^^^^^^^^^^^^^^
+			update_inv_targets(old_targets) ;
 		}
 		//
 		// handle deps
 		//
 		bool has_new_deps = false ;
 		if (fresh_deps) {
+			SWEAR( prep.deps.size()==digest.deps.size() , prep.deps.size() , digest.deps.size() ) ;
 			::uset<Node>  old_deps ;
 			::vector<Dep> deps     ; deps.reserve(digest.deps.size()) ;
 			for( Dep const& d : data.deps )
 				if (d->is_plain())
 					for( Node dd=d ; +dd ; dd=dd->dir() )
 						if (!old_deps.insert(dd).second) break ;                                                  // record old deps and all uphill dirs as these are implicit deps
-			for( auto& [dn,dd] : digest.deps ) {
-				Dep dep { dn , dd } ;
+			for( NodeIdx di=0 ; di<digest.deps.size() ; di++ ) {
+				auto& [dn,dd] = digest.deps[di]  ;
+				Dep&  dep     = prep.deps[di] ;
 				if (!old_deps.contains(dep)) {
 					has_new_deps = true ;
 					// dep.hot means dep has been accessed within g_config->date_prc after its mtime (according to Pdate::now())
@@ -565,23 +598,22 @@ namespace Engine {
 				deps.push_back(dep) ;
 				trace("dep",dep) ;
 			}
+			::vector<Node> prev_deps = data.dep_nodes() ;
 			//vvvvvvvvvvvvvvvvvvvv
 			data.deps.assign(deps) ;
 			//^^^^^^^^^^^^^^^^^^^^
+			update_inv_deps(prev_deps) ;
 		}
 		//
 		// wrap up
 		//
-		if ( ok==Yes && +digest.stderr && !end_cmd_attrs.allow_stderr ) { local_msg+="non-empty stderr\n" ; status = Status::Err ; }
-		EndNoneAttrs end_none_attrs ;
-		::string     stderr         ;
-		try {
-			end_none_attrs = rule->end_none_attrs.eval( *this , match , rsrcs , &::ref(::vmap_s<DepDigest>()) ) ; // we cant record deps here, but we dont care, no impact on target
+		if ( ok==Yes && +digest.stderr && !prep.allow_stderr ) { local_msg+="non-empty stderr\n" ; status = Status::Err ; }
+		::string stderr ;
+		if (!prep.end_none_static) {
 			stderr = digest.stderr ;                                                                              // must copy because digest is move'd when jrr is move'd
-		} catch (::pair_ss const& msg_err) {
-			end_none_attrs = rule->end_none_attrs.spec ;
-			severe_msg << rule->end_none_attrs.s_exc_msg(true/*using_static*/) << '\n' << msg_err.first ;
-			stderr = ensure_nl(msg_err.second) + digest.stderr ;
+		} else {
+			severe_msg << rule->end_none_attrs.s_exc_msg(true/*using_static*/) << '\n' << prep.end_none_msg_err.first ;
+			stderr = ensure_nl(prep.end_none_msg_err.second) + digest.stderr ;
 			stderr <<set_nl<< digest.stderr ;
 		}
 		//
@@ -594,9 +626,9 @@ namespace Engine {
 		data.status = status ;
 		//^^^^^^^^^^^^^^^^^^
 		// job_data file must be updated before make is called as job could be remade immediately (if cached), also info may be fetched if issue becomes known
-		bool     upload = sav_jrr && data.run_status==RunStatus::Ok && ok==Yes  && +cache_none_attrs.key ;
+		bool     upload = sav_jrr && data.run_status==RunStatus::Ok && ok==Yes  && +prep.cache_key ;
 		::string msg    ;
-		trace("wrap_up",STR(sav_jrr),ok,cache_none_attrs.key,data.run_status,STR(upload)) ;
+		trace("wrap_up",STR(sav_jrr),ok,prep.cache_key,data.run_status,STR(upload)) ;
 		if (sav_jrr) {
 			msg = jrr.msg ;
 			jrr.msg <<set_nl<< local_msg << severe_msg ;
@@ -638,7 +670,7 @@ namespace Engine {
 			Delay    exec_time = digest.stats.total ;
 			::string pfx       = !ri.done() && status>Status::Garbage && !unstable_dep ? "may_" : "" ;
 			// dont report user stderr if analysis made it meaningless
-			JobReport jr = audit_end( ri , true/*with_stats*/ , pfx , job_msg , !job_err?stderr:""s , end_none_attrs.max_stderr_len , exec_time ) ;
+			JobReport jr = audit_end( ri , true/*with_stats*/ , pfx , job_msg , !job_err?stderr:""s , prep.max_stderr_len , exec_time ) ;
 			if (ri.done()) {
 				trace("wakeup_watchers",ri) ;
 				ri.wakeup_watchers() ;
@@ -652,7 +684,7 @@ namespace Engine {
 		// as soon as job is done for a req, it is meaningful and justifies to be cached, in practice all reqs agree most of the time
 		if ( upload && one_done ) {                                                                // cache only successful results
 			NfsGuard nfs_guard{g_config->reliable_dirs} ;
-			Cache::s_tab.at(cache_none_attrs.key)->upload( *this , digest , nfs_guard ) ;
+			Cache::s_tab.at(prep.cache_key)->upload( *this , digest , nfs_guard ) ;
 		}
 		trace("summary",*this) ;
 	}
@@ -831,6 +863,10 @@ namespace Engine {
 					ri.state.proto_modif   = true ;                                                            // ensure we can copy proto_modif to stamped_modif anytime when pertinent
 					ri.state.stamped_modif = true ;
 				}
+				for( Dep const& dep : deps ) {                                                                 // src/anti deps will be checked on disk, probe them ahead in parallel
+					Node d = dep ;
+					if ( d->is_plain() && d->match_ok() && d->is_src_anti() && !d->c_req_info(req).done(NodeGoal::Status) ) Node::s_prefetch(d) ;
+				}
 			}
 		}
 		SWEAR(ri.step()==Step::Dep) ;
@@ -859,7 +895,9 @@ namespace Engine {
 							static_deps.push_back(*it) ;
 							static_deps.back().accesses = {} ;
 						}
+						::vector<Node> old_deps = dep_nodes() ;
 						deps.replace_tail(iter,static_deps) ;
+						idx().update_inv_deps(old_deps) ;
 						seen_all = !static_deps ;
 					}
 					stamped_seen_waiting = proto_seen_waiting ;
@@ -1334,13 +1372,19 @@ namespace Engine {
 		fence() ;                                                  // once status is New, we are sure target is not up to date, we can safely modify it
 		run_status = RunStatus::Ok ;
 		if (deps_) {
-			::vector<Dep> static_deps ;
+			::vector<Node> old_deps = dep_nodes() ;
+			::vector<Dep>  static_deps ;
 			for( Dep const& d : deps )  if (d.dflags[Dflag::Static]) static_deps.push_back(d) ;
 			deps.assign(static_deps) ;
+			idx().update_inv_deps(old_deps) ;
 		}
 		if (!rule->is_special()) {
 			exec_gen = 0 ;
-			if (targets_) _reset_targets() ;
+			if (targets_) {
+				::vector<Node> old_targets = target_nodes() ;
+				_reset_targets() ;
+				idx().update_inv_targets(old_targets) ;
+			}
 		}
 		trace("summary",deps) ;
 		return true ;
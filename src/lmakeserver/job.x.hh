@@ -92,7 +92,8 @@ namespace Engine {
 		// cxtors & casts
 	public :
 		using JobBase::JobBase ;
-		Job( Rule::SimpleMatch&&                               , Req={} , DepDepth lvl=0 ) ; // plain Job, used internally and when repairing, req is only for error reporting
+		Job( Rule::SimpleMatch&&                               , Req={} , DepDepth lvl=0 , ::vmap_s<DepSpec>* dep_names=nullptr ) ; // plain Job, used internally and when repairing, req is only for error reporting
+		//                                                                                                                        // if dep_names, they have been evaluated from match, they are used rather than evaluating again
 		Job( RuleTgt , ::string const& t  , bool chk_psfx=true , Req={} , DepDepth lvl=0 ) ; // plain Job, match on target
 		Job( Rule    , ::string const& jn , bool chk_psfx=true , Req={} , DepDepth lvl=0 ) ; // plain Job, match on name, used for repairing or when required from command line
 		//
@@ -116,6 +117,7 @@ namespace Engine {
 		JobTgt(                                                                                   ) = default ;
 		JobTgt( Job j , bool isp=false                                                            ) : Job(j ) { if (+j) is_static_phony(isp)          ; } // if no job, ensure JobTgt appears as false
 		JobTgt( RuleTgt rt , ::string const& t , bool chk_psfx=true , Req req={} , DepDepth lvl=0 ) ;
+		JobTgt( RuleTgt rt , Rule::SimpleMatch&& m ,                 Req req={} , DepDepth lvl=0 , ::vmap_s<DepSpec>* dep_names=nullptr ) ; // m is the result of matching rt
 		JobTgt( JobTgt const& jt                                                                  ) : Job(jt) { is_static_phony(jt.is_static_phony()) ; }
 		//
 		JobTgt& operator=(JobTgt const& jt) { Job::operator=(jt) ; is_static_phony(jt.is_static_phony()) ; return *this ; }
@@ -133,6 +135,29 @@ namespace Engine {
 		using JobTgtsBase::JobTgtsBase ;
 	} ;
 
+	// part of job end processing that does not need the engine, so that it can be done on a pool of threads before JobExec::end is called from the engine thread
+	// this includes the evaluation of end attributes, which may run Python code
+	struct JobEndPrep {
+		// cxtors & casts
+		JobEndPrep() = default ;
+		JobEndPrep( Job , JobDigest const& , ::vmap_ss const& rsrcs ) ; // can be called from any thread
+		// accesses
+		bool operator+() const { return prepared ; }
+		bool operator!() const { return !+*this  ; }
+		// data
+		::vector<Node> targets            ;                             // in the same order as digest.targets
+		::vector<Dep > deps               ;                             // in the same order as digest.deps
+		::string       cache_key          ;                             // from cache_none_attrs
+		bool           allow_stderr       = false ;                     // from end_cmd_attrs
+		size_t         max_stderr_len     = -1    ;                     // from end_none_attrs
+		bool           cache_none_static  = false ;                     // if true <=> cache_none_attrs could not be computed and static info is used
+		bool           end_cmd_err        = false ;                     // if true <=> end_cmd_attrs could not be computed
+		bool           end_none_static    = false ;                     // if true <=> end_none_attrs could not be computed and static info is used
+		::pair_ss      cache_none_msg_err ;                             // if cache_none_static
+		::pair_ss      end_none_msg_err   ;                             // if end_none_static
+		bool           prepared           = false ;
+	} ;
+
 	struct JobExec : Job {
 		friend ::ostream& operator<<( ::ostream& , JobExec const& ) ;
 		// cxtors & casts
@@ -153,9 +178,9 @@ namespace Engine {
 		void live_out( ReqInfo& , ::string const& ) const ;
 		void live_out(            ::string const& ) const ;
 		//
-		JobMngtRpcReply  job_analysis( JobMngtProc , ::vector<Dep> const& deps                ) const ; // answer to requests from job execution
-		void             end         ( JobRpcReq&& , bool sav_jrr , ::vmap_ss const& rsrcs={} ) ;       // hit indicates that result is from a cache hit
-		void             give_up     ( Req={} , bool report=true                              ) ;       // Req (all if 0) was killed and job was not killed (not started or continue)
+		JobMngtRpcReply  job_analysis( JobMngtProc , ::vector<Dep> const& deps                                   ) const ; // answer to requests from job execution
+		void             end         ( JobRpcReq&& , bool sav_jrr , ::vmap_ss const& rsrcs={} , JobEndPrep&& ={} ) ;       // if no JobEndPrep, preparation is done on the fly
+		void             give_up     ( Req={} , bool report=true                                                 ) ;       // Req (all if 0) was killed and job was not killed (not started or continue)
 		//
 		// audit_end returns the report to do if job is finally not rerun
 		JobReport audit_end(ReqInfo&   ,bool with_stats,::string const& pfx,::string const& msg,::string const& stderr   ,size_t max_stderr_len=-1,Delay exec_time={}) const ;
@@ -306,6 +331,9 @@ namespace Engine {
 			DF}
 		}
 		bool missing() const { return run_status==RunStatus::MissingStatic ; }
+		//
+		::vector<Node> dep_nodes   () const ;                                                                     // used to maintain reverse index
+		::vector<Node> target_nodes() const { return mk_vector<Node>(targets) ; }                                 // .
 		// services
 		vmap<Node,FileAction> pre_actions( Rule::SimpleMatch const& , bool mark_target_dirs=false ) const ;       // thread-safe
 		//
@@ -410,6 +438,7 @@ namespace Engine {
 	//
 
 	inline JobTgt::JobTgt( RuleTgt rt , ::string const& t , bool chk_psfx , Req r , DepDepth lvl ) : JobTgt{ Job(rt,t,chk_psfx,r,lvl) , rt.sure() } {}
+	inline JobTgt::JobTgt( RuleTgt rt , Rule::SimpleMatch&& m ,             Req r , DepDepth lvl , ::vmap_s<DepSpec>* dns ) : JobTgt{ Job(::move(m),r,lvl,dns) , rt.sure() } {}
 
 	inline bool JobTgt::sure() const {
 		return is_static_phony() && (*this)->sure() ;
@@ -443,6 +472,12 @@ namespace Engine {
 		return t.tflags ;
 	}
 
+	inline ::vector<Node> JobData::dep_nodes() const {
+		::vector<Node> res ;
+		for( Dep const& d : deps ) res.push_back(d) ;
+		return res ;
+	}
+
 	inline void JobData::invalidate_old() {
 		if ( +rule && rule.old() ) idx().pop() ;
 	}
@@ -500,14 +535,12 @@ namespace Engine {
 	}
 
 	inline JobReqInfo const& JobData::c_req_info(Req r) const {
-		::umap<Job,ReqInfo> const& req_infos = Req::s_store[+r].jobs ;
-		auto                       it        = req_infos.find(idx()) ;                  // avoid double look up
-		if (it==req_infos.end()) return Req::s_store[+r].jobs.dflt ;
-		else                     return it->second                 ;
+		ReqData::InfoMap<Job> const& req_infos = Req::s_store[+r].jobs ;
+		if (ReqInfo const* ri = req_infos.find(idx())) return *ri            ;
+		else                                           return req_infos.dflt ;
 	}
 	inline JobReqInfo& JobData::req_info(Req req) const {
-		auto te = Req::s_store[+req].jobs.try_emplace(idx(),ReqInfo(req)) ;
-		return te.first->second ;
+		return Req::s_store[+req].jobs.get(idx(),req) ;
 	}
 	inline JobReqInfo& JobData::req_info(ReqInfo const& cri) const {
 		if (&cri==&Req::s_store[+cri.req].jobs.dflt) return req_info(cri.req)         ; // allocate
@@ -251,18 +251,19 @@ bool/*interrupted*/ engine_loop() {
 	::umap<Req,FdEntry> fd_tab          ;
 	Pdate               next_stats_date = New ;
 	for (;;) {
-		bool empty = !g_engine_queue ;
+		bool empty = !Backend::s_n_job_end_preps() && !g_engine_queue ;           // job ends being prepared will soon be in queue
 		if (empty) {                                                               // we are about to block, do some book-keeping
 			trace("wait") ;
 			//vvvvvvvvvvvvvvvvv
 			Backend::s_launch() ;                                                  // we are going to wait, tell backend as it may have retained jobs to process them with as mauuch info as possible
 			//^^^^^^^^^^^^^^^^^
+			Cache::s_audit_errs() ;                                                // report errors that occurred in cache threads since last time
 		}
 		if ( Pdate now=New ; empty || now>next_stats_date ) {
 			for( auto const& [r,_] : fd_tab ) if (+r->audit_fd) r->audit_stats() ; // refresh title
 			next_stats_date = now+Delay(1.) ;
 		}
-		if ( empty && _g_done && !Req::s_n_reqs() && !g_engine_queue ) break ;
+		if ( empty && _g_done && !Req::s_n_reqs() && !Backend::s_n_job_end_preps() && !g_engine_queue ) break ; // check preps before queue as they are counted until queued
 		EngineClosure closure = g_engine_queue.pop() ;
 		switch (closure.kind) {
 			case EngineClosureKind::Global : {
@@ -368,7 +369,7 @@ bool/*interrupted*/ engine_loop() {
 					case JobRpcProc::Start       : je.started     ( ::move(ecj.start.start) ,ecj.start.report , ecj.start.report_unlnks , ecj.start.txt , ecj.start.msg ) ; break ;
 					case JobRpcProc::ReportStart : je.report_start(                                                                                                     ) ; break ;
 					case JobRpcProc::GiveUp      : je.give_up     ( ecj.etc.req , ecj.etc.report                                                                        ) ; break ;
-					case JobRpcProc::End         : je.end         ( ::move(ecj.end.end.end) , true/*sav_jrr*/ , ecj.end.rsrcs                                           ) ; break ;
+					case JobRpcProc::End         : je.end         ( ::move(ecj.end.end.end) , true/*sav_jrr*/ , ecj.end.rsrcs , ::move(ecj.end.prep)                    ) ; break ;
 					//                             ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
 				DF}
 			} break ;
@@ -399,8 +400,10 @@ bool/*interrupted*/ engine_loop() {
 }
 
 int main( int argc , char** argv ) {
+	bool py_evaluator = argc==2 && argv[1]=="-e"s ;                                           // launched by server to evaluate dynamic attributes
+	if (py_evaluator) g_trace_file = new ::string ;                                          // dont trace, so as not to interfere with server trace
 	Trace::s_backup_trace = true ;
-	_g_read_only = app_init(true/*read_only_ok*/,Maybe/*chk_version*/) ;                      // server is always launched at root
+	_g_read_only = app_init(true/*read_only_ok*/,py_evaluator?No:Maybe/*chk_version*/) ;      // server is always launched at root
 	if (Record::s_is_simple(g_root_dir_s->c_str()))
 		exit(Rc::Usage,"cannot use lmake inside system directory "+no_slash(*g_root_dir_s)) ; // all local files would be seen as simple, defeating autodep
 	Py::init(*g_lmake_dir_s) ;
@@ -408,6 +411,7 @@ int main( int argc , char** argv ) {
 	ade.root_dir_s = *g_root_dir_s ;
 	Record::s_static_report = true ;
 	Record::s_autodep_env(ade) ;
+	if (py_evaluator) return PyEvaluator::s_serve(Fd::Stdin,Fd::Stdout) ;
 	if (+*g_startup_dir_s) {
 		g_startup_dir_s->pop_back() ;
 		FAIL("lmakeserver must be started from repo root, not from ",*g_startup_dir_s) ;
@@ -430,7 +434,7 @@ int main( int argc , char** argv ) {
 		}
 		continue ;
 	Bad :
-		exit(Rc::Usage,"unrecognized argument : ",argv[i],"\nsyntax : lmakeserver [-cstartup_dir_s] [-d/*no_daemon*/] [-r/*no makefile refresh*/]") ;
+		exit(Rc::Usage,"unrecognized argument : ",argv[i],"\nsyntax : lmakeserver [-cstartup_dir_s] [-d/*no_daemon*/] [-r/*no makefile refresh*/] | lmakeserver -e/*python evaluator*/") ;
 	}
 	if (g_startup_dir_s) SWEAR( is_dirname(*g_startup_dir_s) , *g_startup_dir_s ) ;
 	else                 g_startup_dir_s = new ::string ;
@@ -465,6 +469,7 @@ int main( int argc , char** argv ) {
 	if (!_g_read_only) Trace::s_new_trace_file( g_config->local_admin_dir_s+"trace/"+base_name(read_lnk("/proc/self/exe")) ) ;
 	Codec::Closure::s_init() ;
 	Job           ::s_init() ;
+	PyEvaluator   ::s_init(g_config->n_py_evaluators) ;
 	//
 	static ::jthread reqs_thread { reqs_thread_func , in_fd , out_fd } ;
 	//
@@ -45,6 +45,116 @@ namespace Engine {
 		return _s_src_dirs_crc ;
 	}
 
+	//
+	// prefetch
+	//
+
+	// while the engine walks the deps of a job, the disk state of its src/anti deps is probed on a pool of threads so that refresh_src_anti need not wait for it
+	// consistency is the same as when probing from the engine :
+	// - probes go through a NfsGuard exactly as refresh_src_anti does
+	// - a prefetched state is only used by a Req started before it was probed
+	// - it is discarded if node records changed in between (e.g. a job overwrote it), and it is used at most once
+	static constexpr size_t NPrefetchThreads = 8 ;                                                     // probing is latency bound (typically on NFS), not cpu bound
+
+	struct PrefetchEntry {
+		bool     busy          = false ;                                                               // a thread is probing disk
+		bool     ready         = false ;
+		bool     ok            = false ;                                                               // if false, probing failed, do it again from the engine to report errors
+		// asked
+		FileSig  ref_sig       ;                                                                       // recorded sig when asked, entry is discarded if records changed in between
+		bool     ref_crc_ok    = false ;                                                               // if recorded crc is not valid, crc must be computed in all cases
+		bool     reliable_dirs = false ;
+		// probed
+		Pdate    date          ;                                                                       // disk was probed after this date
+		FileInfo fi            ;
+		Crc      crc           ;                                                                       // only computed if disk does not match records
+		FileSig  crc_sig       ;                                                                       // sig associated with crc
+	} ;
+
+	static Mutex<MutexLvl::Prefetch>                              _g_prefetch_mutex   ;
+	static ::condition_variable_any                               _g_prefetch_cond    ;                // notified when an entry becomes ready
+	static ::umap<Node,PrefetchEntry>                             _g_prefetch_tab     ;                // only the engine inserts and erases entries, threads only fill them
+	static ThreadDeque<::pair<Node,::string>,false/*Flush*/>      _g_prefetch_queue   ;
+	static ::vector<::jthread>                                    _g_prefetch_threads ;                // ensure threads are last so they are stopped before other data are destructed
+
+	static void _prefetch_thread_func( ::stop_token stop , size_t id ) {
+		t_thread_key = 'P' ;
+		Trace trace("_prefetch_thread_func",id) ;
+		for(;;) {
+			auto [popped,item] = _g_prefetch_queue.pop(stop) ;
+			if (!popped) break ;
+			auto const& [node,name] = item ;
+			PrefetchEntry e ;
+			{	Lock lock { _g_prefetch_mutex } ;
+				auto it = _g_prefetch_tab.find(node) ;
+				if ( it==_g_prefetch_tab.end() || it->second.busy || it->second.ready ) continue ;  // engine did not wait for us or a previous request is being processed
+				it->second.busy = true       ;
+				e               = it->second ;
+			}
+			e.date = New ;
+			try {
+				NfsGuard nfs_guard { e.reliable_dirs } ;
+				e.fi = FileInfo(nfs_guard.access(name)) ;
+				if ( +e.fi && !( e.ref_crc_ok && FileSig(e.fi)==e.ref_sig ) ) {                        // same condition as refresh_src_anti to compute crc
+					e.crc = Crc::Reg ;
+					while ( e.crc==Crc::Reg || e.crc==Crc::Lnk ) e.crc = Crc(e.crc_sig,name) ;                   // ensure file is stable when computing crc, as refresh_src_anti
+				}
+				e.ok = true ;
+			} catch (::string const&) {}                                                                // engine will do it again and report
+			e.busy  = false ;
+			e.ready = true  ;
+			Lock lock { _g_prefetch_mutex } ;
+			auto it = _g_prefetch_tab.find(node) ;
+			if (it==_g_prefetch_tab.end()) continue ;                                                   // cleared in between
+			it->second = ::move(e) ;
+			_g_prefetch_cond.notify_all() ;
+		}
+		trace("done") ;
+	}
+
+	void Node::s_prefetch(Node node) {
+		SWEAR( node->is_plain() && node->match_ok() && node->is_src_anti() , node ) ;
+		if (_g_prefetch_threads.empty()) {
+			_g_prefetch_threads.reserve(NPrefetchThreads) ;
+			for( size_t i=0 ; i<NPrefetchThreads ; i++ ) _g_prefetch_threads.emplace_back(_prefetch_thread_func,i) ;
+		}
+		PrefetchEntry e ;                                                                               // dont access store while holding lock
+		e.ref_sig       = node->date().sig        ;
+		e.ref_crc_ok    = node->crc.valid()       ;
+		e.reliable_dirs = g_config->reliable_dirs ;
+		{	Lock lock { _g_prefetch_mutex } ;
+			if (!_g_prefetch_tab.try_emplace(node,::move(e)).second) return ;                          // already asked, will be consumed by first user
+		}
+		_g_prefetch_queue.emplace( node , node->name() ) ;
+	}
+
+	void Node::s_prefetch_clear() {
+		Lock lock { _g_prefetch_mutex } ;
+		Trace trace("s_prefetch_clear",_g_prefetch_tab.size()) ;
+		_g_prefetch_tab.clear() ;                                                                       // queued items are skipped by threads as their entry is gone
+	}
+
+	// consume prefetched state of node, return false if none is usable
+	static bool/*hit*/ _prefetched( NodeData const& nd , Pdate after , FileInfo&/*out*/ fi , Crc&/*out*/ crc , FileSig&/*out*/ crc_sig ) {
+		PrefetchEntry e ;
+		{	Lock lock { _g_prefetch_mutex } ;
+			auto it = _g_prefetch_tab.find(nd.idx()) ;
+			if (it==_g_prefetch_tab.end()) return false ;
+			if ( !it->second.busy && !it->second.ready ) {                                             // not started yet, it is faster to probe ourselves
+				_g_prefetch_tab.erase(it) ;
+				return false ;
+			}
+			_g_prefetch_cond.wait( lock , [&]()->bool { return it->second.ready ; } ) ;                // only engine erases entries, so it stays valid while waiting
+			e = ::move(it->second) ;
+			_g_prefetch_tab.erase(it) ;
+		}
+		if ( !e.ok || e.date<after || e.ref_sig!=nd.date().sig || e.ref_crc_ok!=nd.crc.valid() ) return false ;
+		fi      = e.fi      ;
+		crc     = e.crc     ;
+		crc_sig = e.crc_sig ;
+		return true ;
+	}
+
 	//
 	// NodeData
 	//
@@ -119,14 +229,20 @@ namespace Engine {
 		for( Job j : conform_job_tgts(ri) ) j->set_pressure(j->req_info(ri.req),ri.pressure) ; // go through current analysis level as this is where we may have deps we are waiting for
 	}
 
-	bool/*modified*/ NodeData::refresh_src_anti( bool report_no_file , ::vector<Req> const& reqs_ , ::string const& name_ ) { // reqss_ are for reporting only
-		bool        prev_ok   = crc.valid() && crc.exists() ;
-		bool        frozen    = idx().frozen()              ;
-		const char* msg       = frozen ? "frozen" : "src"   ;
-		NfsGuard    nfs_guard { g_config->reliable_dirs }   ;
-		FileInfo    fi        { nfs_guard.access(name_) }   ;
-		FileSig     sig       { fi  }                       ;
-		Trace trace("refresh_src_anti",STR(report_no_file),reqs_,sig) ;
+	bool/*modified*/ NodeData::refresh_src_anti( bool report_no_file , ::vector<Req> const& reqs_ , ::string const& name_ , Pdate prefetch_after ) { // reqss_ are for reporting only
+		bool        prev_ok    = crc.valid() && crc.exists() ;
+		bool        frozen     = idx().frozen()              ;
+		const char* msg        = frozen ? "frozen" : "src"   ;
+		FileInfo    fi         ;
+		Crc         crc_       ;                                                                                       // valid if prefetched and file does not match records
+		FileSig     crc_sig    ;                                                                                       // sig associated with crc_
+		bool        prefetched = +prefetch_after && _prefetched(*this,prefetch_after,fi,crc_,crc_sig) ;
+		if (!prefetched) {
+			NfsGuard nfs_guard { g_config->reliable_dirs } ;
+			fi = FileInfo(nfs_guard.access(name_)) ;
+		}
+		FileSig sig { fi } ;
+		Trace trace("refresh_src_anti",STR(report_no_file),reqs_,sig,STR(prefetched)) ;
 		if (frozen) for( Req r : reqs_  ) r->frozen_nodes.emplace(idx(),r->frozen_nodes.size()) ;
 		if (!fi) {
 			if (report_no_file) for( Req r : reqs_  ) r->audit_job( Color::Err , "missing" , msg , name_ ) ;
@@ -136,7 +252,8 @@ namespace Engine {
 			//^^^^^^^^^^^^^^^^
 		} else {
 			if ( crc.valid() && sig==date().sig ) return false/*updated*/ ;
-			Crc crc_ = Crc::Reg ;
+			if (crc_.valid()) sig  = crc_sig  ;                                                                             // prefetched
+			else              crc_ = Crc::Reg ;                                                                             // .
 			while ( crc_==Crc::Reg || crc_==Crc::Lnk ) crc_ = Crc(sig,name_) ;                                                // ensure file is stable when computing crc
 			Accesses mismatch = crc.diff_accesses(crc_) ;
 			//vvvvvvvvvvvvvvvvvvv
@@ -257,14 +374,35 @@ namespace Engine {
 		::vector<RuleTgt> rule_tgts_ = rule_tgts().view() ;
 		//
 		SWEAR(is_lcl(name_),name_) ;
-		::vector<JobTgt> jts ; jts.reserve(rule_tgts_.size()) ;                // typically, there is a single priority
-		for( RuleTgt const& rt : rule_tgts_ ) {
+		::vector<JobTgt>                        jts     ; jts.reserve(rule_tgts_.size()) ; // typically, there is a single priority
+		::vector<::optional<Rule::SimpleMatch>> matches ( rule_tgts_.size() )          ; // computed on demand, only for candidates that are looked at
+		auto match = [&](size_t i)->Rule::SimpleMatch& {
+			if (!matches[i]) matches[i].emplace(rule_tgts_[i],name_,false/*chk_psfx*/) ; // rule is pre-filtered, so no need to match prefix and suffix
+			return *matches[i] ;
+		} ;
+		// candidates at the prio of the first one are all instantiated, so their dynamic deps can be evaluated concurrently by python evaluators beforehand
+		::vector<::optional<::vmap_s<DepSpec>>> dep_names ( rule_tgts_.size() ) ;
+		if ( PyEvaluator::s_n>1 && lvl<g_config->max_dep_depth ) {
+			::vector<::function<void()>> evals ;
+			for( size_t i=0 ; i<rule_tgts_.size() && rule_tgts_[i]->prio==rule_tgts_[0]->prio ; i++ ) {
+				Rule::SimpleMatch const& m = match(i) ;
+				if ( !m || !m.rule->deps_attrs.is_dynamic ) continue ;
+				evals.push_back( [&m,&dn=dep_names[i]]()->void {
+					try                       { dn = m.rule->deps_attrs.eval(m) ; }
+					catch (::pair_ss  const&) {                                   }                // errors are reported when job is instantiated, which evaluates again
+					catch (::string   const&) {                                   }                // .
+				} ) ;
+			}
+			if (evals.size()>1) PyEvaluator::s_run(evals) ;
+		}
+		for( size_t i=0 ; i<rule_tgts_.size() ; i++ ) {
+			RuleTgt rt = rule_tgts_[i] ;
 			SWEAR(!rt->is_special()) ;
 			if (rt->prio<prio) goto Done ;
 			if (lvl>=g_config->max_dep_depth) throw ::vector<Node>() ;         // too deep, must be an infinite dep path
-			//          vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
-			JobTgt jt = JobTgt(rt,name_,false/*chk_psfx*/,req,lvl+1) ;         // rule is pre-filtered, so no need to match prefix and suffix
-			//          ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
+			//          vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+			JobTgt jt = JobTgt( rt , ::move(match(i)) , req , lvl+1 , dep_names[i]?&*dep_names[i]:nullptr ) ;
+			//          ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
 			if (+jt) {
 				if (jt.sure()) { buildable  = Buildable::Yes   ; n = NoIdx ; } // after a sure job, we can forget about rules at lower prio
 				else             buildable |= Buildable::Maybe ;
@@ -438,7 +576,7 @@ namespace Engine {
 		}
 		FAIL() ;
 	Src :
-		{	bool modified = refresh_src_anti( status()!=NodeStatus::None , {req} , lazy_name() ) ;
+		{	bool modified = refresh_src_anti( status()!=NodeStatus::None , {req} , lazy_name() , req->start_pdate ) ;
 			if      (crc            !=Crc::None) status(NodeStatus::Src) ;                              // overwrite status if it was pre-set to None
 			else if (status()==NodeStatus::None) goto NoSrc ;                                           // if status was pre-set to None, it means we accept NoSrc
 			if      (modified                  ) actual_job() = {} ;
@@ -129,7 +129,9 @@ namespace Engine {
 		static constexpr RuleIdx NoIdx      = -1                 ;
 		static constexpr RuleIdx MaxRuleIdx = -(N<NodeStatus>+1) ;
 		// statics
-		static Hash::Crc s_src_dirs_crc() ;
+		static Hash::Crc s_src_dirs_crc  () ;
+		static void      s_prefetch      (Node) ;              // probe disk state of a src/anti node on prefetch threads, ahead of refresh_src_anti
+		static void      s_prefetch_clear(    ) ;              // forget prefetched states, called when no Req is running any more
 		// static data
 	private :
 		static Hash::Crc _s_src_dirs_crc ;
@@ -369,7 +371,7 @@ namespace Engine {
 		Manual manual_refresh( Req            r                )       { return manual_refresh(r,FileSig(name())) ; }
 		Manual manual_refresh( JobData const& j                )       { return manual_refresh(j,FileSig(name())) ; }
 		//
-		bool/*modified*/ refresh_src_anti( bool report_no_file , ::vector<Req> const& , ::string const& name ) ;      // Req's are for reporting only
+		bool/*modified*/ refresh_src_anti( bool report_no_file , ::vector<Req> const& , ::string const& name , Pdate prefetch_after={} ) ; // Req's are for reporting only
 		//
 		void full_refresh( bool report_no_file , ::vector<Req> const& reqs , ::string const& name ) {
 			if (+reqs) set_buildable(reqs[0]) ;
@@ -542,13 +544,12 @@ namespace Engine {
 		return Req::s_store[+r].nodes.contains(idx()) ;
 	}
 	inline NodeReqInfo const& NodeData::c_req_info(Req r) const {
-		::umap<Node,ReqInfo> const& req_infos = Req::s_store[+r].nodes ;
-		auto                        it        = req_infos.find(idx())  ;                 // avoid double look up
-		if (it==req_infos.end()) return Req::s_store[+r].nodes.dflt ;
-		else                     return it->second                  ;
+		ReqData::InfoMap<Node> const& req_infos = Req::s_store[+r].nodes ;
+		if (ReqInfo const* ri = req_infos.find(idx())) return *ri            ;
+		else                                           return req_infos.dflt ;
 	}
 	inline NodeReqInfo& NodeData::req_info(Req r) const {
-		return Req::s_store[+r].nodes.try_emplace(idx(),NodeReqInfo(r)).first->second ;
+		return Req::s_store[+r].nodes.get(idx(),r) ;
 	}
 	inline NodeReqInfo& NodeData::req_info(ReqInfo const& cri) const {
 		if (&cri==&Req::s_store[+cri.req].nodes.dflt) return req_info(cri.req)         ; // allocate
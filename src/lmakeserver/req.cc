@@ -111,6 +111,7 @@ namespace Engine {
 			}
 			_s_reqs_by_eta.pop_back() ;
 		}
+		if (!s_reqs_by_start) Node::s_prefetch_clear() ;                                 // prefetched states can only be used by running reqs
 	}
 
 	void Req::new_eta() {
@@ -225,9 +225,34 @@ namespace Engine {
 	struct ReqData {
 		friend Req ;
 		using Idx = ReqIdx ;
-		template<IsWatcher T> struct InfoMap : ::umap<T,typename T::ReqInfo> {
-			typename T::ReqInfo dflt ;
-			using ::umap<T,typename T::ReqInfo>::umap ;
+		// dense table indexed by +job/+node, allocated by pages so that memory is only used around jobs/nodes actually seen by this Req
+		// an entry is allocated iff its req is set, which default constructed entries have not
+		template<IsWatcher T> struct InfoMap {
+			using Info = typename T::ReqInfo ;
+			static constexpr uint8_t PageLog = 8                  ;                              // small pages as Req's may be sparse
+			static constexpr size_t  PageSz  = size_t(1)<<PageLog ;
+			using Page = ::array<Info,PageSz> ;
+			// accesses
+			bool        contains(T t) const { return find(t) ; }
+			Info const* find    (T t) const {
+				size_t p = +t>>PageLog ;
+				if ( p>=_pages.size() || !_pages[p] ) return nullptr ;
+				Info const& res = (*_pages[p])[+t&(PageSz-1)] ;
+				return +res.req ? &res : nullptr ;
+			}
+			// services
+			Info& get( T t , Req r ) {                                                           // allocate if necessary
+				size_t p = +t>>PageLog ;
+				if (p>=_pages.size()) _pages.resize(p+1) ;
+				if (!_pages[p]      ) _pages[p] = ::make_unique<Page>() ;
+				Info& res = (*_pages[p])[+t&(PageSz-1)] ;
+				if (!res.req) res = Info(r) ;
+				return res ;
+			}
+			// data
+			Info dflt ;
+		private :
+			::vector<::unique_ptr<Page>> _pages ;
 		} ;
 		static constexpr size_t StepSz = 14 ;           // size of the field representing step in output
 		// static data
@@ -271,6 +271,165 @@ namespace Engine {
 		}
 	}
 
+	Py::Ptr<Py::Object> DynamicDskBase::s_run_code( Py::Dict& glbs , Py::Code const& code , EvalCtxVals const& vals , ::vmap_s<DepDigest>* deps ) {
+		// functions defined in glbs use glbs as their global dict (which is stored in the code object of the functions), so glbs must be modified in place or the job-related values will not
+		// be seen by these functions, which is the whole purpose of such dynamic values
+		Py::Gil::s_swear_locked() ;
+		::vector_s to_del ;
+		for( auto const& [key,val] : vals.strs ) {
+			to_del.push_back(key) ;
+			glbs.set_item(key,*Py::Ptr<Py::Str>(val)) ;
+		}
+		for( auto const& [key,val] : vals.dcts ) {
+			to_del.push_back(key) ;
+			Py::Ptr<Py::Dict> py_dct { New } ;
+			for( auto const& [k,v] : val ) py_dct->set_item(k,*Py::Ptr<Py::Str>(v)) ;
+			glbs.set_item(key,*py_dct) ;
+		}
+		try                       { Py::py_run(vals.to_eval,glbs) ;          }
+		catch (::string const& e) { throw ::pair_ss({}/*msg*/,e/*stderr*/) ; }
+		Py::Ptr<Py::Object> res      ;
+		::string            err      ;
+		bool                seen_err = false  ;
+		AutodepLock         lock     { deps } ;
+		//                                vvvvvvvvvvvvvvvv
+		try                       { res = code.eval(glbs) ;     }
+		//                                ^^^^^^^^^^^^^^^^
+		catch (::string const& e) { err = e ; seen_err = true ; }
+		for( ::string const& key : to_del ) glbs.del_item(key) ;                      // delete job-related info, just to avoid percolation to other jobs, even in case of error
+		if ( +lock.err || seen_err ) throw ::pair_ss(lock.err/*msg*/,err/*stderr*/) ;
+		return res ;
+	}
+
+	//
+	// DynamicEvalCache
+	//
+
+	::atomic<size_t> DynamicEvalCacheBase::s_n_hits   = 0 ;
+	::atomic<size_t> DynamicEvalCacheBase::s_n_misses = 0 ;
+
+	//
+	// PyEvaluator
+	//
+
+	uint8_t                                           PyEvaluator::s_n      = 0       ;
+	PyEvaluator*                                      PyEvaluator::_s_tab   = nullptr ;
+	ThreadDeque<uint8_t              ,false/*Flush*/>* PyEvaluator::_s_free  = nullptr ;
+	ThreadDeque<PyEvaluator::Task    ,false/*Flush*/>* PyEvaluator::_s_tasks = nullptr ;
+
+	void PyEvaluator::s_init(uint8_t n_evaluators) {
+		Trace trace("PyEvaluator::s_init",n_evaluators) ;
+		SWEAR(!s_n) ;
+		if (!n_evaluators) return ;
+		_s_tab   = new PyEvaluator[n_evaluators]                 ;                              // never destroyed, evaluators exit when server closes their stdin
+		_s_free  = new ThreadDeque<uint8_t,false/*Flush*/>{'E'}  ;
+		_s_tasks = new ThreadDeque<Task   ,false/*Flush*/>{'N'}  ;                              // .
+		for( uint8_t i=0 ; i<n_evaluators ; i++ ) {
+			_s_tab[i]._spawn() ;
+			_s_free->push(i) ;
+		}
+		for( uint8_t i=1 ; i<n_evaluators ; i++ ) ::thread(_s_task_func,i).detach() ;            // s_run caller is the last one, helpers block on _s_tasks until server exits
+		s_n = n_evaluators ;
+	}
+
+	void PyEvaluator::_s_task_func(size_t id) {
+		t_thread_key = 'N' ;
+		Trace trace("PyEvaluator::_s_task_func",id) ;
+		for(;;) {
+			Task task = _s_tasks->pop() ;
+			(*task.func)() ;
+			task.done->count_down() ;
+		}
+	}
+
+	void PyEvaluator::s_run(::vector<::function<void()>> const& funcs) {
+		if (!funcs) return ;
+		Trace trace("PyEvaluator::s_run",funcs.size()) ;
+		::latch done { ptrdiff_t(funcs.size()-1) } ;
+		if (s_n>1) for( size_t i=1 ; i<funcs.size() ; i++ ) _s_tasks->push(Task{&funcs[i],&done}) ;
+		else       for( size_t i=1 ; i<funcs.size() ; i++ ) { funcs[i]() ; done.count_down() ; }     // no helper
+		funcs[0]() ;
+		for( Task task ; _s_tasks->try_pop(task) ; ) { (*task.func)() ; task.done->count_down() ; } // help rather than wait, tasks may be from another caller
+		done.wait() ;
+		trace("done") ;
+	}
+
+	void PyEvaluator::_spawn() {
+		if (+_child) { _child.kill(SIGKILL) ; _child.wait() ; }
+		_known.clear() ;
+		AutoCloseFd dev_null = ::open("/dev/null",O_WRONLY|O_CLOEXEC) ;                         // stderr must be open for python to report errors, and is diverted while doing so
+		_child.cmd_line  = { read_lnk("/proc/self/exe") , "-e" } ;
+		_child.stdin_fd  = Child::PipeFd ;
+		_child.stdout_fd = Child::PipeFd ;
+		_child.stderr_fd = dev_null      ;
+		_child.spawn() ;                                                                          // pipes are created close-on-exec, so evaluator sees eof when server dies, even if it has launched other processes
+		Trace("PyEvaluator::_spawn",_child.pid) ;
+	}
+
+	bool/*done*/ PyEvaluator::s_eval( Reply& reply , uint64_t id , DynamicDskBase const& dyn , EvalCtxVals const& vals , bool want_deps ) {
+		uint8_t      i    = _s_free->pop() ;
+		PyEvaluator& self = _s_tab[i]      ;
+		Trace trace("PyEvaluator::s_eval",i,id) ;
+		Req req { .id=id , .glbs_str={} , .code_str={} , .vals=vals , .want_deps=want_deps } ;
+		bool known = self._known.contains(id) ;
+		if (!known) {
+			req.glbs_str = dyn.append_dbg_info(dyn.glbs_str) ;
+			req.code_str = dyn.code_str                      ;
+		}
+		bool done = false ;
+		try {
+			OMsgBuf().send( self._child.stdin , req ) ;
+			reply = IMsgBuf().receive<Reply>(self._child.stdout) ;
+			if (!known) self._known.insert(id) ;                                                // if evaluator could not compile, it remembers it
+			done = reply.done ;
+		} catch (::string const& e) {
+			trace("dead",e) ;
+			try                       { self._spawn() ;         }                              // evaluator died, replace it and evaluate in server this time
+			catch (::string const& e) { trace("no_spawn",e) ; }
+		}
+		_s_free->push(i) ;
+		trace("done",STR(done)) ;
+		return done ;
+	}
+
+	int PyEvaluator::s_serve( Fd in , Fd out ) {
+		struct Code {
+			::string          err  ;                                                            // if not empty, code cannot be compiled in evaluator
+			Py::Ptr<Py::Dict> glbs ;
+			Py::Ptr<Py::Code> code ;
+		} ;
+		::umap<uint64_t,Code> codes ;
+		Py::Gil               gil   ;
+		for(;;) {
+			Req req ;
+			try                     { req = IMsgBuf().receive<Req>(in) ; }
+			catch (::string const&) { break ;                            }                      // server has gone, we are done
+			Reply reply ;
+			auto [it,inserted] = codes.try_emplace(req.id) ;
+			Code& c = it->second ;
+			if (inserted)
+				try {
+					c.code = req.code_str ; c.code->boost() ;
+					c.glbs = Py::py_run(req.glbs_str) ; c.glbs->boost() ;
+				} catch (::string const& e) { c.err = e ; }
+			if (!c.err) {
+				reply.done = true ;
+				::vmap_s<DepDigest> deps ;
+				try {
+					Py::Ptr<Py::Object> res = DynamicDskBase::s_run_code( *c.glbs , *c.code , req.vals , req.want_deps?&deps:nullptr ) ;
+					try                     { reply.val = Py::py_marshal(*res) ; reply.ok = true ; }
+					catch (::string const&) { reply.done = false ;                                  } // result cannot be transported, let server evaluate
+				} catch (::pair_ss const& e) {
+					reply.msg_err = e ;
+				}
+				reply.deps = ::move(deps) ;
+			}
+			try                     { OMsgBuf().send(out,reply) ; }
+			catch (::string const&) { break ;                     }
+		}
+		return 0 ;
+	}
+
 	//
 	// Rule
 	//
@@ -456,7 +615,7 @@ namespace Engine {
 		//
 		if (is_dynamic) {
 			Gil         gil    ;
-			Ptr<Object> py_obj = _eval_code(match) ;
+			Ptr<Object> py_obj = _eval_code(gil,match) ;
 			//
 			::map_s<VarIdx> dep_idxs ;
 			for( VarIdx di=0 ; di<spec.deps.size() ; di++ ) dep_idxs[spec.deps[di].first] = di ;
@@ -544,16 +703,25 @@ namespace Engine {
 	pair_ss/*script,call*/ DynamicCmd::eval( Rule::SimpleMatch const& match , ::vmap_ss const& rsrcs , ::vmap_s<DepDigest>* deps ) const {
 		Rule r = match.rule ; // if we have no job, we must have a match as job is there to lazy evaluate match if necessary
 		if (!r->is_python) {
-			::string cmd ;
+			Cmd cmd ;
 			if (!is_dynamic) {
-				cmd = parse_fstr(spec.cmd,match,rsrcs) ;
+				cmd.cmd = parse_fstr(spec.cmd,match,rsrcs) ;
 			} else {
-				Gil         gil    ;
-				Ptr<Object> py_obj = _eval_code( match , rsrcs , deps ) ;
-				if (!py_obj->is_a<Py::Str>()) throw "type error : "+py_obj->type_name()+" is not a str" ;
-				Attrs::acquire( cmd , &py_obj->as_a<Str>() ) ;
+				EvalCtxVals          vals       = _eval_ctx_vals( {} , const_cast<Rule::SimpleMatch&>(match) , rsrcs ) ;
+				::string             key        = serialize(vals)                                                     ;
+				::vmap_s<DepDigest>  local_deps ;
+				::vmap_s<DepDigest>* eval_deps  = deps ? deps : &local_deps                                           ;          // always record deps so cache entry can be checked
+				size_t               n_deps     = eval_deps->size()                                                   ;
+				if (!_eval_cache.get(cmd,key,deps)) {                                                                            // no need to take the Gil if already evaluated
+					{	Gil         gil    ;
+						Ptr<Object> py_obj = _eval_code( gil , vals , eval_deps ) ;
+						if (!py_obj->is_a<Py::Str>()) throw "type error : "+py_obj->type_name()+" is not a str" ;
+						Attrs::acquire( cmd.cmd , &py_obj->as_a<Str>() ) ;
+					}
+					_eval_cache.set( cmd , key , ::vmap_s<DepDigest>(eval_deps->begin()+n_deps,eval_deps->end()) ) ;
+				}
 			}
-			return {{}/*preamble*/,::move(cmd)} ;
+			return {{}/*preamble*/,::move(cmd.cmd)} ;
 		} else {
 			::string res ;
 			eval_ctx( match , rsrcs
@@ -1241,6 +1409,7 @@ namespace Engine {
 		for( pass=1 ; pass<=2 ; pass++ ) {                                                                        // on 1st pass we compute key size, on 2nd pass we do the job
 			if (+interpreter               ) do_field( "interpreter" , interpreter                            ) ;
 			if ( sca.use_script            ) do_field( "use_script"  , fmt_string(sca.use_script            ) ) ;
+			if ( sca.use_zygote            ) do_field( "use_zygote"  , fmt_string(sca.use_zygote            ) ) ;
 			if ( sca.auto_mkdir            ) do_field( "auto_mkdir"  , fmt_string(sca.auto_mkdir            ) ) ;
 			if ( sca.ignore_stat           ) do_field( "ignore_stat" , fmt_string(sca.ignore_stat           ) ) ;
 			if (+sca.job_space.chroot_dir_s) do_field( "chroot_dir"  , no_slash  (sca.job_space.chroot_dir_s) ) ;
@@ -1271,9 +1440,11 @@ namespace Engine {
 	static ::string _pretty( size_t i , StartNoneAttrs const& sna ) {
 		OStringStream res     ;
 		::vmap_ss     entries ;
-		if ( sna.keep_tmp   ) entries.emplace_back( "keep_tmp"    , fmt_string  (sna.keep_tmp   )            ) ;
-		if (+sna.start_delay) entries.emplace_back( "start_delay" ,              sna.start_delay.short_str() ) ;
-		if (+sna.kill_sigs  ) entries.emplace_back( "kill_sigs"   , _pretty_sigs(sna.kill_sigs  )            ) ;
+		if ( sna.autodep_cache) entries.emplace_back( "autodep_cache" , fmt_string  (sna.autodep_cache)           ) ;
+		if ( sna.autodep_ring ) entries.emplace_back( "autodep_ring"  , fmt_string  (sna.autodep_ring )           ) ;
+		if ( sna.keep_tmp     ) entries.emplace_back( "keep_tmp"      , fmt_string  (sna.keep_tmp     )           ) ;
+		if (+sna.start_delay  ) entries.emplace_back( "start_delay"   ,              sna.start_delay.short_str()  ) ;
+		if (+sna.kill_sigs    ) entries.emplace_back( "kill_sigs"     , _pretty_sigs(sna.kill_sigs    )           ) ;
 		/**/              res << _pretty_vmap(i,entries)                                     ;
 		if (+sna.env    ) res << indent("environ :\n"   ,i) << _pretty_env ( i+1 , sna.env ) ;
 		return ::move(res).str() ;
@@ -59,6 +59,8 @@ namespace Engine {
 
 	struct RuleTgt ;
 
+	struct DepSpec ;
+
 }
 
 #endif
@@ -220,6 +222,7 @@ namespace Engine {
 			Attrs::acquire_from_dct( job_space.root_view_s  , py_dct , "root_view"   ) ; if (+job_space.root_view_s ) job_space.root_view_s  = Disk::with_slash(job_space.root_view_s ) ;
 			Attrs::acquire_from_dct( job_space.tmp_view_s   , py_dct , "tmp_view"    ) ; if (+job_space.tmp_view_s  ) job_space.tmp_view_s   = Disk::with_slash(job_space.tmp_view_s  ) ;
 			Attrs::acquire_from_dct( use_script             , py_dct , "use_script"  ) ;
+			Attrs::acquire_from_dct( use_zygote             , py_dct , "use_zygote"  ) ;
 			Attrs::acquire_from_dct( job_space.views        , py_dct , "views"       ) ;
 			::sort( env                                                                                                                                   ) ; // stabilize cmd crc
 			::sort( job_space.views , [](::pair_s<JobSpace::ViewDescr> const& a,::pair_s<JobSpace::ViewDescr> const&b)->bool { return a.first<b.first ; } ) ; // .
@@ -232,6 +235,7 @@ namespace Engine {
 		::vmap_ss  env         ;
 		JobSpace   job_space   ;
 		bool       use_script  = false ;
+		bool       use_zygote  = false ;
 		// END_OF_VERSIONING
 	} ;
 
@@ -271,10 +275,11 @@ namespace Engine {
 			Attrs::acquire_env     ( env     , py_dct , "env"                            ) ;
 			Attrs::acquire_from_dct( method  , py_dct , "autodep"                        ) ;
 			Attrs::acquire_from_dct( timeout , py_dct , "timeout" , Time::Delay()/*min*/ ) ;
-			::sort(env) ;                                                                                                    // stabilize rsrcs crc
+			::sort(env) ;                                                                                                         // stabilize rsrcs crc
 			// check
-			if ( method==AutodepMethod::Fuse    && !HAS_FUSE     ) throw snake(method)+" is not supported on this system"s ; // PER_AUTODEP_METHOD
-			if ( method==AutodepMethod::LdAudit && !HAS_LD_AUDIT ) throw snake(method)+" is not supported on this system"s ; // .
+			if ( method==AutodepMethod::Fuse    && !HAS_FUSE          ) throw snake(method)+" is not supported on this system"s ; // PER_AUTODEP_METHOD
+			if ( method==AutodepMethod::LdAudit && !HAS_LD_AUDIT      ) throw snake(method)+" is not supported on this system"s ; // .
+			if ( method==AutodepMethod::Seccomp && !HAS_SECCOMP_NOTIF ) throw snake(method)+" is not supported on this system"s ; // .
 		}
 		// data
 		// START_OF_VERSIONING
@@ -291,20 +296,24 @@ namespace Engine {
 		void init  ( bool /*is_dynamic*/ , Py::Dict const* py_src , ::umap_s<CmdIdx> const& ) { update(*py_src) ; }
 		void update(                       Py::Dict const& py_dct                           ) {
 			using namespace Attrs ;
-			Attrs::acquire_from_dct( keep_tmp    , py_dct , "keep_tmp"                           ) ;
-			Attrs::acquire_from_dct( start_delay , py_dct , "start_delay" , Time::Delay()/*min*/ ) ;
-			Attrs::acquire_from_dct( kill_sigs   , py_dct , "kill_sigs"                          ) ;
-			Attrs::acquire_from_dct( n_retries   , py_dct , "n_retries"                          ) ;
-			Attrs::acquire_env     ( env         , py_dct , "env"                                ) ;
+			Attrs::acquire_from_dct( autodep_cache , py_dct , "autodep_cache"                         ) ;
+			Attrs::acquire_from_dct( autodep_ring  , py_dct , "autodep_ring"                          ) ;
+			Attrs::acquire_from_dct( keep_tmp      , py_dct , "keep_tmp"                              ) ;
+			Attrs::acquire_from_dct( start_delay   , py_dct , "start_delay"   , Time::Delay()/*min*/ ) ;
+			Attrs::acquire_from_dct( kill_sigs     , py_dct , "kill_sigs"                             ) ;
+			Attrs::acquire_from_dct( n_retries     , py_dct , "n_retries"                             ) ;
+			Attrs::acquire_env     ( env           , py_dct , "env"                                   ) ;
 			::sort(env) ;                                                                            // by symmetry with env entries in StartCmdAttrs and StartRsrcsAttrs
 		}
 		// data
 		// START_OF_VERSIONING
-		bool              keep_tmp    = false ;
-		Time::Delay       start_delay ;                                                              // job duration above which a start message is generated
-		::vector<uint8_t> kill_sigs   ;                                                              // signals to use to kill job (tried in sequence, 1s apart from each other)
-		uint8_t           n_retries   = 0     ;                                                      // max number of retry if job is lost
-		::vmap_ss         env         ;
+		bool              autodep_cache = false ;                                                    // if true <=> read accesses already reported by a process of the job are not reported again
+		bool              autodep_ring  = false ;                                                    // if true <=> read accesses are reported through shared memory rather than through a socket
+		bool              keep_tmp      = false ;
+		Time::Delay       start_delay   ;                                                            // job duration above which a start message is generated
+		::vector<uint8_t> kill_sigs     ;                                                            // signals to use to kill job (tried in sequence, 1s apart from each other)
+		uint8_t           n_retries     = 0     ;                                                    // max number of retry if job is lost
+		::vmap_ss         env           ;
 		// END_OF_VERSIONING
 	} ;
 
@@ -339,10 +348,19 @@ namespace Engine {
 	using EvalCtxFuncStr = ::function<void( VarCmd , VarIdx idx , string const& key , string  const& val )> ;
 	using EvalCtxFuncDct = ::function<void( VarCmd , VarIdx idx , string const& key , vmap_ss const& val )> ;
 
+	// values of the context of a dynamic attribute, as seen by its code
+	struct EvalCtxVals {
+		::vmap_ss           strs    ; // variables defined as str
+		::vmap_s<::vmap_ss> dcts    ; // variables defined as dict
+		::string            to_eval ; // python code defining other variables (star targets are functions)
+	} ;
+
 	// the part of the Dynamic struct which is stored on disk
 	struct DynamicDskBase {
+		friend struct PyEvaluator ;
 		// statics
-		static bool s_is_dynamic(Py::Tuple const& ) ;
+		static bool                s_is_dynamic(Py::Tuple const& ) ;
+		static Py::Ptr<Py::Object> s_run_code  ( Py::Dict& glbs , Py::Code const& , EvalCtxVals const& , ::vmap_s<DepDigest>* deps ) ; // Gil must be held
 	protected :
 		static void _s_eval( Job , Rule::SimpleMatch&/*lazy*/ , ::vmap_ss const& rsrcs_ , ::vector<CmdIdx> const& ctx , EvalCtxFuncStr const& , EvalCtxFuncDct const& ) ;
 		// cxtors & casts
@@ -403,6 +421,72 @@ namespace Engine {
 		// END_OF_VERSIONING
 	} ;
 
+	// cache of dynamic evaluations, so that jobs sharing the same inputs do not run Python code again
+	// key is made of the values of the context (stems, matches, deps & resources referenced by code)
+	// an entry is valid as long as the deps read during evaluation are unchanged, which assumes code is pure, as required by documentation (cf. dynamic-values)
+	struct DynamicEvalCacheBase {
+		static constexpr size_t MaxSz = 1<<12 ; // max number of entries per attribute, cache is cleared when full
+		// static data
+		static ::atomic<size_t> s_n_hits   ;
+		static ::atomic<size_t> s_n_misses ;
+	} ;
+	template<class V> struct DynamicEvalCache : DynamicEvalCacheBase {
+		struct Entry {
+			V                   val  ;
+			::vmap_s<DepDigest> deps ; // deps read during evaluation
+		} ;
+		// services
+		bool/*hit*/ get  ( V&       , ::string const& key , ::vmap_s<DepDigest>* deps              ) const ; // if hit, deps are appended to deps (if not null)
+		void        set  ( V const& , ::string const& key , ::vmap_s<DepDigest>&& deps             ) ;       // deps must be all deps read during evaluation, even if caller did not ask for them
+		void        clear(                                                                         ) { Lock lock{_mutex} ; _tab.clear() ; }
+		// data
+	private :
+		Mutex<MutexLvl::DynamicEval> mutable _mutex ;
+		::umap_s<Entry>                      _tab   ;
+	} ;
+
+	// pool of processes evaluating dynamic attributes out of server, so that evaluations run in parallel and do not hold the server Gil
+	// evaluators are lmakeserver processes launched with -e, that run the same code as the server would on the same context values
+	struct PyEvaluator {
+		struct Req {
+			uint64_t    id        = 0     ; // identifies code, glbs_str and code_str are only sent the first time to a given evaluator
+			::string    glbs_str  ;
+			::string    code_str  ;
+			EvalCtxVals vals      ;
+			bool        want_deps = false ;
+		} ;
+		struct Reply {
+			bool                done    = false ; // if false, evaluation could not be carried out by evaluator, it must be done in server
+			bool                ok      = false ; // if false, evaluation failed, msg_err is as thrown by code evaluation in server
+			::string            val     ;         // marshaled result
+			::vmap_s<DepDigest> deps    ;
+			::pair_ss           msg_err ;
+		} ;
+		struct Task {
+			::function<void()> const* func = nullptr ;
+			::latch*                  done = nullptr ;
+		} ;
+		// statics
+		static void         s_init (uint8_t n_evaluators) ;
+		static bool/*done*/ s_eval ( Reply& , uint64_t id , DynamicDskBase const& , EvalCtxVals const& , bool want_deps ) ;
+		static void         s_run  ( ::vector<::function<void()>> const&                                               ) ; // run funcs concurrently (up to s_n at a time) and return when all are done
+		static int          s_serve( Fd in , Fd out                                                                    ) ; // called in evaluator process
+	private :
+		static void _s_task_func(size_t id) ;
+		// static data
+	public :
+		static uint8_t s_n ;                                                                                                 // if 0, evaluations are done in server
+	private :
+		static PyEvaluator*                      _s_tab   ;
+		static ThreadDeque<uint8_t,false/*Flush*/>* _s_free  ;                                                                // indexes in _s_tab of evaluators not in use
+		static ThreadDeque<Task   ,false/*Flush*/>* _s_tasks ;                                                                // funcs submitted to s_run, run by s_n-1 helper threads and by s_run caller
+		// services
+		void _spawn() ;
+		// data
+		Child            _child ;
+		::uset<uint64_t> _known ; // ids of codes already sent to evaluator
+	} ;
+
 	template<class T> struct Dynamic : DynamicDsk<T> {
 		using Base = DynamicDsk<T> ;
 		using Base::is_dynamic      ;
@@ -411,23 +495,28 @@ namespace Engine {
 		using Base::ctx             ;
 		using Base::spec            ;
 		using Base::_s_eval         ;
+		using Base::s_run_code      ;
 		using Base::append_dbg_info ;
 		// statics
 		static bool s_is_dynamic(Py::Tuple const&) ;
 		// cxtors & casts
 		using Base::Base ;
-		Dynamic           (Dynamic const& src) : Base{       src } , glbs{       src.glbs } , code{       src.code } {}                                  // mutex is not copiable
-		Dynamic           (Dynamic     && src) : Base{::move(src)} , glbs{::move(src.glbs)} , code{::move(src.code)} {}                                  // .
+		Dynamic           (Dynamic const& src) : Base{       src } , _py_id{src._py_id} , glbs{       src.glbs } , code{       src.code } {}            // mutex is not copiable, eval cache is not copied
+		Dynamic           (Dynamic     && src) : Base{::move(src)} , _py_id{src._py_id} , glbs{::move(src.glbs)} , code{::move(src.code)} {}            // .
 		Dynamic& operator=(Dynamic const& src) {                                                                                                         // .
 			Base::operator=(src) ;
-			glbs = src.glbs ;
-			code = src.code ;
+			glbs   = src.glbs   ;
+			code   = src.code   ;
+			_py_id = src._py_id ;
+			_eval_cache.clear() ;
 			return *this ;
 		}
 		Dynamic& operator=(Dynamic&& src) {                                                                                                              // .
 			Base::operator=(::move(src)) ;
-			glbs = ::move(src.glbs) ;
-			code = ::move(src.code) ;
+			glbs   = ::move(src.glbs) ;
+			code   = ::move(src.code) ;
+			_py_id = src._py_id       ;
+			_eval_cache.clear() ;
 			return *this ;
 		}
 		// services
@@ -448,13 +537,18 @@ namespace Engine {
 			return parse_fstr( fstr , {} , const_cast<Rule::SimpleMatch&>(m) , rsrcs ) ;                                                                 // cannot lazy evaluate w/o a job
 		}
 	protected :
-		Py::Ptr<Py::Object> _eval_code( Job , Rule::SimpleMatch      &/*lazy*/ , ::vmap_ss const& rsrcs={} , ::vmap_s<DepDigest>* deps=nullptr ) const ;
-		Py::Ptr<Py::Object> _eval_code(       Rule::SimpleMatch const& m       , ::vmap_ss const& rsrcs={} , ::vmap_s<DepDigest>* deps=nullptr ) const {
-			return _eval_code( {} , const_cast<Rule::SimpleMatch&>(m) , rsrcs , deps ) ;                                                                 // cannot lazy evaluate w/o a job
+		EvalCtxVals _eval_ctx_vals( Job , Rule::SimpleMatch&/*lazy*/ , ::vmap_ss const& rsrcs ) const ;
+		//
+		Py::Ptr<Py::Object> _eval_code( Py::Gil& , EvalCtxVals const& , ::vmap_s<DepDigest>* deps=nullptr ) const ;                                    // Gil may be released while evaluating
+		Py::Ptr<Py::Object> _eval_code( Py::Gil& gil , Rule::SimpleMatch const& m , ::vmap_ss const& rsrcs={} , ::vmap_s<DepDigest>* deps=nullptr ) const {
+			return _eval_code( gil , _eval_ctx_vals( {} , const_cast<Rule::SimpleMatch&>(m) , rsrcs ) , deps ) ;                                         // cannot lazy evaluate w/o a job
 		}
 		// data
 	private :
-		mutable Mutex<MutexLvl::Rule> _glbs_mutex ; // ensure glbs is not used for several jobs simultaneously
+		mutable Mutex<MutexLvl::PyGlbs> _glbs_mutex ;     // ensure glbs is not used for several jobs simultaneously
+	protected :
+		mutable DynamicEvalCache<T>     _eval_cache ;
+		uint64_t                        _py_id      = 0 ; // identifies code when evaluated out of server
 	public :
 		Py::Ptr<Py::Dict> mutable glbs ;            // if is_dynamic <=> dict to use as globals when executing code, modified then restored during evaluation
 		Py::Ptr<Py::Code>         code ;            // if is_dynamic <=> python code object to execute with stems as locals and glbs as globals leading to a dict that can be used to build data
@@ -813,11 +907,33 @@ namespace Engine {
 		if (py_src[0]!=Py::None) spec.init( is_dynamic , &py_src[0].as_a<Py::Dict>() , var_idxs , ::forward<A>(args)... ) ;
 	}
 
+	template<class V> bool/*hit*/ DynamicEvalCache<V>::get( V& val , ::string const& key , ::vmap_s<DepDigest>* deps ) const {
+		Lock lock { _mutex } ;
+		auto it = _tab.find(key) ;
+		if (it==_tab.end()) { s_n_misses++ ; return false ; }
+		Entry const& e = it->second ;
+		for( auto const& [d,dd] : e.deps )
+			if ( +dd.accesses && ( dd.is_crc || Disk::FileSig(d)!=dd.sig() ) ) { s_n_misses++ ; return false ; }                 // dep has changed since evaluation (crc cannot be checked cheaply)
+		val = e.val ;
+		if (deps) for( auto const& d_dd : e.deps ) deps->push_back(d_dd) ;
+		s_n_hits++ ;
+		return true ;
+	}
+
+	template<class V> void DynamicEvalCache<V>::set( V const& val , ::string const& key , ::vmap_s<DepDigest>&& deps ) {
+		Lock lock { _mutex } ;
+		if (_tab.size()>=MaxSz) _tab.clear() ;                                                                                    // simple and good enough as all entries are typically alike
+		_tab.insert_or_assign( key , Entry{val,::move(deps)} ) ;
+	}
+
 	template<class T> void Dynamic<T>::compile() {
 		if (!is_dynamic) return ;
 		Py::Gil::s_swear_locked() ;
+		_eval_cache.clear() ;
 		try { code = code_str                              ; code->boost() ; } catch (::string const& e) { throw "cannot compile code :\n"   +indent(e,1) ; }
 		try { glbs = Py::py_run(append_dbg_info(glbs_str)) ; glbs->boost() ; } catch (::string const& e) { throw "cannot compile context :\n"+indent(e,1) ; }
+		Hash::Xxh h ; h.update(append_dbg_info(glbs_str)) ; h.update(code_str) ;
+		_py_id = +h.digest() ;
 	}
 
 	template<class T> void Dynamic<T>::eval_ctx( Job job , Rule::SimpleMatch& match_ , ::vmap_ss const& rsrcs_ , EvalCtxFuncStr const& cb_str , EvalCtxFuncDct const& cb_dct ) const {
@@ -847,50 +963,56 @@ namespace Engine {
 		return res ;
 	}
 
-	template<class T> Py::Ptr<Py::Object> Dynamic<T>::_eval_code( Job job , Rule::SimpleMatch& match , ::vmap_ss const& rsrcs , ::vmap_s<DepDigest>* deps ) const {
-		// functions defined in glbs use glbs as their global dict (which is stored in the code object of the functions), so glbs must be modified in place or the job-related values will not
-		// be seen by these functions, which is the whole purpose of such dynamic values
-		Rule       r       = +match ? match.rule : job->rule ;
-		::vector_s to_del  ;
-		::string   to_eval ;
+	template<class T> EvalCtxVals Dynamic<T>::_eval_ctx_vals( Job job , Rule::SimpleMatch& match , ::vmap_ss const& rsrcs ) const {
+		Rule        r   = +match ? match.rule : job->rule ;
+		EvalCtxVals res ;
 		eval_ctx( job , match , rsrcs
 		,	[&]( VarCmd vc , VarIdx i , ::string const& key , ::string const& val ) -> void {
-				to_del.push_back(key) ;
-				if (vc!=VarCmd::StarMatch) glbs->set_item(key,*Py::Ptr<Py::Str>(val)) ;
-				else                       to_eval += r->gen_py_line( job , match , vc , i , key , val ) ;
+				if (vc!=VarCmd::StarMatch) res.strs.emplace_back(key,val) ;
+				else                       res.to_eval += r->gen_py_line( job , match , vc , i , key , val ) ;
 			}
 		,	[&]( VarCmd , VarIdx , ::string const& key , ::vmap_ss const& val ) -> void {
-				to_del.push_back(key) ;
-				Py::Ptr<Py::Dict> py_dct { New } ;
-				for( auto const& [k,v] : val ) py_dct->set_item(k,*Py::Ptr<Py::Str>(v)) ;
-				glbs->set_item(key,*py_dct) ;
+				res.dcts.emplace_back(key,val) ;
 			}
 		) ;
-		try                       { Py::py_run(to_eval,*glbs) ;              }
-		catch (::string const& e) { throw ::pair_ss({}/*msg*/,e/*stderr*/) ; }
-		Py::Ptr<Py::Object> res      ;
-		::string            err      ;
-		bool                seen_err = false  ;
-		AutodepLock         lock     { deps } ;
-		//                                vvvvvvvvvvvvvvvvv
-		try                       { res = code->eval(*glbs) ;   }
-		//                                ^^^^^^^^^^^^^^^^^
-		catch (::string const& e) { err = e ; seen_err = true ; }
-		for( ::string const& key : to_del ) glbs->del_item(key) ;                     // delete job-related info, just to avoid percolation to other jobs, even in case of error
-		if ( +lock.err || seen_err ) throw ::pair_ss(lock.err/*msg*/,err/*stderr*/) ;
 		return res ;
 	}
 
+	template<class T> Py::Ptr<Py::Object> Dynamic<T>::_eval_code( Py::Gil& gil , EvalCtxVals const& vals , ::vmap_s<DepDigest>* deps ) const {
+		if (PyEvaluator::s_n) {
+			PyEvaluator::Reply reply ;
+			bool               done  ;
+			{	Py::NoGil no_gil { gil } ;                                                   // other threads may use the Gil while we wait for evaluator
+				done = PyEvaluator::s_eval( reply , _py_id , *this , vals , bool(deps) ) ;
+			}
+			if (done) {
+				if (deps     ) for( auto& d_dd : reply.deps ) deps->push_back(::move(d_dd)) ;
+				if (!reply.ok) throw reply.msg_err ;
+				return Py::py_unmarshal(reply.val) ;
+			}
+		}
+		Lock lock { _glbs_mutex } ;                                                                        // glbs is modified in place during evaluation
+		return s_run_code( *glbs , *code , vals , deps ) ;
+	}
+
 	template<class T> T Dynamic<T>::eval( Job job , Rule::SimpleMatch& match , ::vmap_ss const& rsrcs , ::vmap_s<DepDigest>* deps ) const {
 		T res = spec ;
 		if (is_dynamic) {
-			Py::Gil             gil    ;
-			Py::Ptr<Py::Object> py_obj = _eval_code( job , match , rsrcs , deps ) ;
-			if (*py_obj!=Py::None) {
-				if (!py_obj->is_a<Py::Dict>()) throw "type error : "s+py_obj->ob_type->tp_name+" is not a dict" ;
-				try                       { res.update(py_obj->template as_a<Py::Dict>()) ; }
-				catch (::string const& e) { throw ::pair_ss({}/*msg*/,e/*stderr*/) ;        }
+			EvalCtxVals          vals       = _eval_ctx_vals(job,match,rsrcs) ;
+			::string             key        = serialize(vals)                 ;
+			::vmap_s<DepDigest>  local_deps ;
+			::vmap_s<DepDigest>* eval_deps  = deps ? deps : &local_deps       ;                                  // always record deps so cache entry can be checked, whether caller wants them or not
+			size_t               n_deps     = eval_deps->size()               ;
+			if (_eval_cache.get(res,key,deps)) return res ;                                                      // no need to take the Gil
+			{	Py::Gil             gil    ;
+				Py::Ptr<Py::Object> py_obj = _eval_code( gil , vals , eval_deps ) ;
+				if (*py_obj!=Py::None) {
+					if (!py_obj->is_a<Py::Dict>()) throw "type error : "s+py_obj->ob_type->tp_name+" is not a dict" ;
+					try                       { res.update(py_obj->template as_a<Py::Dict>()) ; }
+					catch (::string const& e) { throw ::pair_ss({}/*msg*/,e/*stderr*/) ;        }
+				}
 			}
+			_eval_cache.set( res , key , ::vmap_s<DepDigest>(eval_deps->begin()+n_deps,eval_deps->end()) ) ; // only cache successful evaluations
 		}
 		return res ;
 	}
@@ -30,10 +30,28 @@ namespace Engine::Persistent {
 	MatchGen         RuleBase::s_match_gen = 1 ; // 0 is forbidden as it is reserved to mean !match
 	umap_s<RuleBase> RuleBase::s_by_name   ;
 
+	//
+	// JobBase
+	//
+
+	void JobBase::update_inv_deps   (::vector<Node> const& old_deps   ) const { update_inv( +*this , false/*targets*/ , old_deps    , (*this)->dep_nodes   () ) ; }
+	void JobBase::update_inv_targets(::vector<Node> const& old_targets) const { update_inv( +*this , true /*targets*/ , old_targets , (*this)->target_nodes() ) ; }
+
 	//
 	// NodeBase
 	//
 
+	static ::vector<Job> _inv_jobs( Node n , bool targets ) {
+		if (+n>=_node_inv_file.size()) return {} ;                                              // reverse index is grown on demand
+		NodeInvJobs const& nij = _node_inv_file.c_at(n)                 ;
+		::vector<Job>      res ;
+		for( Job j : targets?nij.targets:nij.deps ) if (+j) res.push_back(j) ;           // ignore spare room
+		::sort(res) ;                                                                            // report in a stable order, as when walking through all jobs
+		return res ;
+	}
+	::vector<Job> NodeBase::inv_deps   () const { return _inv_jobs(Node(+*this),false/*targets*/) ; }
+	::vector<Job> NodeBase::inv_targets() const { return _inv_jobs(Node(+*this),true /*targets*/) ; }
+
 	RuleTgts NodeBase::s_rule_tgts(::string const& target_name) {
 		// first match on suffix
 		PsfxIdx sfx_idx = _sfxs_file.longest(target_name,::string{Persistent::StartMrkr}).first ; // StartMrkr is to match rules w/ no stems
@@ -58,6 +76,8 @@ namespace Engine::Persistent {
 	TargetsFile  _targets_file   ; // .
 	NodeFile     _node_file      ; // nodes
 	JobTgtsFile  _job_tgts_file  ; // .
+	NodeInvFile  _node_inv_file  ; // .
+	InvJobsFile  _inv_jobs_file  ; // .
 	RuleStrFile  _rule_str_file  ; // rules
 	RuleFile     _rule_file      ; // .
 	RuleTgtsFile _rule_tgts_file ; // .
@@ -118,6 +138,8 @@ namespace Engine::Persistent {
 		// nodes
 		_node_file     .init( dir_s+"node"      , writable ) ;
 		_job_tgts_file .init( dir_s+"job_tgts"  , writable ) ;
+		_node_inv_file .init( dir_s+"node_inv"  , writable ) ;
+		_inv_jobs_file .init( dir_s+"inv_jobs"  , writable ) ;
 		// rules
 		_rule_str_file .init( dir_s+"rule_str"  , writable ) ;
 		_rule_file     .init( dir_s+"rule"      , writable ) ; if ( writable && !_rule_file.c_hdr() ) _rule_file.hdr() = 1 ; // 0 is reserved to mean no match
@@ -142,6 +164,8 @@ namespace Engine::Persistent {
 		_targets_file  .keep_open = true ; // .
 		_node_file     .keep_open = true ; // .
 		_job_tgts_file .keep_open = true ; // .
+		_node_inv_file .keep_open = true ; // .
+		_inv_jobs_file .keep_open = true ; // .
 		_rule_str_file .keep_open = true ; // .
 		_rule_file     .keep_open = true ; // .
 		_rule_tgts_file.keep_open = true ; // .
@@ -161,6 +185,7 @@ namespace Engine::Persistent {
 			try {
 				chk()              ;       // first verify we have a coherent store
 				invalidate_match() ;       // then rely only on essential data that should be crash-safe
+				rebuild_inv()      ;       // reverse index may have been left behind if crash occurred while updating it
 				::cerr<<"seems ok"<<endl ;
 			} catch (::string const&) {
 				exit(Rc::Format,"failed to rescue, consider running lrepair") ;
@@ -176,6 +201,8 @@ namespace Engine::Persistent {
 		/**/                                  _targets_file  .chk(                    ) ; // .
 		/**/                                  _node_file     .chk(                    ) ; // nodes
 		/**/                                  _job_tgts_file .chk(                    ) ; // .
+		/**/                                  _node_inv_file .chk(                    ) ; // .
+		/**/                                  _inv_jobs_file .chk(                    ) ; // .
 		/**/                                  _rule_str_file .chk(                    ) ; // rules
 		/**/                                  _rule_file     .chk(                    ) ; // .
 		/**/                                  _rule_tgts_file.chk(                    ) ; // .
@@ -271,8 +298,12 @@ namespace Engine::Persistent {
 				// set job
 				Job job { {rule,::move(job_info.start.stems)} } ;
 				if (!job) goto NextJob ;
+				::vector<Node> old_targets = job->target_nodes() ;
+				::vector<Node> old_deps    = job->dep_nodes   () ;
 				job->targets.assign(targets) ;
 				job->deps   .assign(deps   ) ;
+				job.update_inv_targets(old_targets) ;
+				job.update_inv_deps   (old_deps   ) ;
 				job->status = job_info.end.end.digest.status ;
 				job->exec_ok(true) ;                                                                           // pretend job just ran
 				// set target actual_job's
@@ -288,6 +319,57 @@ namespace Engine::Persistent {
 		}
 	}
 
+	static NodeInvJobs& _node_inv(Node n) {
+		NodeInvFile::Sz sz = _node_inv_file.size() ;
+		if (+n>=sz) _node_inv_file.emplace_back(+n+1-sz) ;                               // grow on demand, entries are zero filled, which is a legal empty value
+		return _node_inv_file.at(n) ;
+	}
+
+	// multi-job inverse vectors are allocated with spare room at their end, filled with null jobs
+	// so that adding a job to a node referenced by numerous jobs (e.g. a common header) is amortized O(1) and removing one does not reallocate
+	static constexpr InvJobsIdx InvJobsMinCapacity = 4 ;
+	static Job* _inv_end(InvJobs& ijs) {                                                 // end of used slots
+		return ::partition_point( ijs.begin() , ijs.end() , [](Job j)->bool { return +j ; } ) ;
+	}
+	static void _inv_reshape( InvJobs& ijs , ::vector<Job>&& v ) {                       // v contains no null job
+		if (v.size()>1) v.resize( ::max( size_t(InvJobsMinCapacity) , 2*v.size() ) ) ; // geometric growth, padding with null jobs
+		ijs.assign(v) ;                                                                  // v.size()<=1 is stored in place
+	}
+	static void _inv_add( InvJobs& ijs , Job j ) {
+		if (ijs.size()>1) {
+			Job* e = _inv_end(ijs) ;
+			if (e!=ijs.end()) { *e = j ; return ; }                                      // use spare room
+		}
+		::vector<Job> v = mk_vector<Job>(ijs) ; v.push_back(j) ;
+		_inv_reshape(ijs,::move(v)) ;
+	}
+	static void _inv_del( InvJobs& ijs , Job j ) {
+		Job* b = ijs.begin()    ;
+		Job* e = _inv_end(ijs) ;
+		Job* p = ::find(b,e,j) ; if (p==e) return ;
+		*p = e[-1] ; e[-1] = {} ;                                                        // order is irrelevant as readers sort
+		size_t n = e-b-1 ;
+		if ( n<=1 || 4*n<=ijs.size() ) _inv_reshape( ijs , ::vector<Job>(b,b+n) ) ;    // shrink when mostly empty
+	}
+
+	void update_inv( Job j , bool targets , ::vector<Node> const& old , ::vector<Node> const& new_ ) {
+		if (j->rule==Rule(Special::Req)) return ;                                        // Req jobs are fugitive, dont record them
+		::uset<Node> old_set = mk_uset(old ) ;
+		::uset<Node> new_set = mk_uset(new_) ;
+		for( Node n : new_set ) if (!old_set.contains(n)) _inv_add( targets ? _node_inv(n).targets : _node_inv(n).deps , j ) ;
+		for( Node n : old_set ) if (!new_set.contains(n)) _inv_del( targets ? _node_inv(n).targets : _node_inv(n).deps , j ) ;
+	}
+
+	void rebuild_inv() {
+		Trace trace("rebuild_inv") ;
+		_node_inv_file.clear() ;
+		_inv_jobs_file.clear() ;
+		for( Job j : job_lst() ) {
+			update_inv( j , false/*targets*/ , {} , j->dep_nodes   () ) ;
+			update_inv( j , true /*targets*/ , {} , j->target_nodes() ) ;
+		}
+	}
+
 	// str has target syntax
 	// return suffix after last stem (StartMrkr+str if no stem)
 	static ::string _parse_sfx(::string const& str) {
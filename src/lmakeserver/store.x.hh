@@ -13,15 +13,18 @@
 #include "idxed.hh"
 
 //
-// There are 9 files :
+// There are 11 files :
 // - 1 name file associates a name with either a node or a job :
 //   - This is a prefix-tree to share as much prefixes as possible since names tend to share a lot of prefixes
 //   - For jobs, a suffix containing the rule and the positions of the stems is added.
 //   - Before this suffix, a non printable char is inserted to distinguish nodes and jobs.
 //   - A single file is used to store both nodes and jobs as they tend to share the same prefixes.
-// - 2 files for nodes :
+// - 4 files for nodes :
 //   - A node data file provides its name (a pointer to the name file) and all pertinent info about a node.
 //   - A job-star file containing vectors of job-star, a job-star is a job index and a marker saying if we refer to a static or a star target
+//   - A reverse index file, indexed by node, providing the jobs that have this node as dep and those that have it as target.
+//     It is kept up to date each time deps or targets of a job are modified, so that inverse queries need not walk through all jobs.
+//   - An inv-jobs file containing vectors of jobs referenced by the reverse index file.
 // - 3 files for jobs :
 //   - A job data file containing its name (a pointer to the name file) and all the pertinent info for a job
 //   - A targets file containing vectors of star targets (static targets can be identified from the rule).
@@ -137,7 +140,9 @@ namespace Engine::Persistent {
 		RuleIdx rule_idx () const ;
 		bool    frozen   () const ;
 		// services
-		void chk() const ;
+		void chk               (                                ) const ;
+		void update_inv_deps   (::vector<Node> const& old_deps   ) const ; // update reverse index after deps    have been modified, old_deps    are the nodes before modification
+		void update_inv_targets(::vector<Node> const& old_targets) const ; // update reverse index after targets have been modified, old_targets are the nodes before modification
 	} ;
 
 	struct NodeBase
@@ -173,6 +178,8 @@ namespace Engine::Persistent {
 		NodeData      * operator->()       { return &**this ; }
 		bool            frozen    () const ;
 		bool            no_trigger() const ;
+		::vector<Job>   inv_deps   () const ;                                            // jobs having this node as dep   , ordered by index
+		::vector<Job>   inv_targets() const ;                                            // jobs having this node as target, ordered by index
 		// services
 		void chk() const ;
 	} ;
@@ -228,6 +235,7 @@ namespace Engine {
 	using Name        = Persistent::Name                            ;
 	using JobBase     = Persistent::JobBase                         ;
 	using JobTgtsBase = Vector::Crunch<JobTgtsIdx,JobTgt,StoreMrkr> ;
+	using InvJobs     = Vector::Crunch<InvJobsIdx,Job   ,StoreMrkr> ;
 	using NodeBase    = Persistent::NodeBase                        ;
 	using RuleBase    = Persistent::RuleBase                        ;
 	using RuleTgts    = Persistent::RuleTgts                        ;
@@ -261,6 +269,11 @@ namespace Engine::Persistent {
 		Targets no_triggers ; // these nodes do not trigger rebuild
 	} ;
 
+	struct NodeInvJobs {      // all zero is a legal empty value, as the reverse index file is grown with zero filled entries
+		InvJobs deps    ;     // jobs having this node as dep
+		InvJobs targets ;     // jobs having this node as target
+	} ;
+
 	//                                           autolock header     index             key       data         misc
 	// jobs
 	using JobFile      = Store::AllocFile       < false , JobHdr   , Job             ,           JobData                       > ;
@@ -269,6 +282,8 @@ namespace Engine::Persistent {
 	// nodes
 	using NodeFile     = Store::AllocFile       < false , NodeHdr  , Node            ,           NodeData                      > ;
 	using JobTgtsFile  = Store::VectorFile      < false , void     , JobTgts::Vector ,           JobTgt     , RuleIdx          > ;
+	using NodeInvFile  = Store::StructFile      < false , void     , Node            ,           NodeInvJobs, true /*Multi*/   > ; // indexed by Node, grown on demand
+	using InvJobsFile  = Store::VectorFile      < false , void     , InvJobs::Vector ,           Job                           > ;
 	// rules
 	using RuleStrFile  = Store::VectorFile      < false , void     , RuleStr         ,           char       , uint32_t         > ;
 	using RuleFile     = Store::AllocFile       < false , MatchGen , Rule            ,           RuleStr                       > ;
@@ -291,6 +306,8 @@ namespace Engine::Persistent {
 	extern TargetsFile  _targets_file   ; // .
 	extern NodeFile     _node_file      ; // nodes
 	extern JobTgtsFile  _job_tgts_file  ; // .
+	extern NodeInvFile  _node_inv_file  ; // .
+	extern InvJobsFile  _inv_jobs_file  ; // .
 	extern RuleStrFile  _rule_str_file  ; // rules
 	extern RuleFile     _rule_file      ; // .
 	extern RuleTgtsFile _rule_tgts_file ; // .
@@ -309,6 +326,7 @@ namespace Vector {
 	template<> struct File<Engine            ::DepsBase   > { static constexpr Engine::Persistent::DepsFile   & file = Engine::Persistent::_deps_file     ; } ;
 	template<> struct File<Engine            ::TargetsBase> { static constexpr Engine::Persistent::TargetsFile& file = Engine::Persistent::_targets_file  ; } ;
 	template<> struct File<Engine            ::JobTgtsBase> { static constexpr Engine::Persistent::JobTgtsFile& file = Engine::Persistent::_job_tgts_file ; } ;
+	template<> struct File<Engine            ::InvJobs    > { static constexpr Engine::Persistent::InvJobsFile& file = Engine::Persistent::_inv_jobs_file ; } ;
 	template<> struct File<Engine::Persistent::RuleStr    > { static constexpr Engine::Persistent::RuleStrFile& file = Engine::Persistent::_rule_str_file ; } ;
 }
 
@@ -321,6 +339,9 @@ namespace Engine::Persistent {
 	void               invalidate_match(                                                                               ) ;
 	void               invalidate_exec ( bool cmd_ok                                                                   ) ;
 	void               repair          ( ::string const& from_dir_s                                                    ) ;
+	void               rebuild_inv     (                                                                               ) ; // rebuild reverse index from scratch
+	//
+	void update_inv( Job , bool targets , ::vector<Node> const& old , ::vector<Node> const& new_ ) ; // update reverse index of targets or deps of job from old to new_
 	//
 	NodeFile::Lst  node_lst() ;
 	JobFile ::Lst  job_lst () ;
@@ -393,6 +414,8 @@ namespace Engine::Persistent {
 	// cxtors & casts
 	template<class... A> JobBase::JobBase( NewType , A&&... args ) {                               // 1st arg is only used to disambiguate
 		*this = _job_file.emplace( Name() , ::forward<A>(args)... ) ;
+		update_inv_deps   ({}) ;
+		update_inv_targets({}) ;
 	}
 	template<class... A> JobBase::JobBase( ::pair_ss const& name_sfx , bool new_ , A&&... args ) { // jobs are only created in main thread, so no locking is necessary
 		Name name_ = _name_file.insert(name_sfx.first,name_sfx.second) ;
@@ -400,15 +423,23 @@ namespace Engine::Persistent {
 		if (+*this) {
 			SWEAR( name_==(*this)->_full_name , name_ , (*this)->_full_name ) ;
 			if (!new_) return ;
+			::vector<Node> old_deps    = (*this)->dep_nodes   () ;
+			::vector<Node> old_targets = (*this)->target_nodes() ;
 			**this = JobData( name_ , ::forward<A>(args)...) ;
+			update_inv_deps   (old_deps   ) ;
+			update_inv_targets(old_targets) ;
 		} else {
 			_name_file.at(+name_) = *this = _job_file.emplace( name_ , ::forward<A>(args)... ) ;
+			update_inv_deps   ({}) ;
+			update_inv_targets({}) ;
 		}
 		(*this)->_full_name = name_ ;
 	}
 	inline void JobBase::pop() {
 		if (!*this) return ;
 		if (+(*this)->_full_name) (*this)->_full_name.pop() ;
+		update_inv( +*this , false/*targets*/ , (*this)->dep_nodes   () , {} ) ;
+		update_inv( +*this , true /*targets*/ , (*this)->target_nodes() , {} ) ;
 		_job_file.pop(+*this) ;
 		clear() ;
 	}
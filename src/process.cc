@@ -99,9 +99,9 @@ void Child::spawn() {
 	SWEAR( !stdout_fd || stdout_fd>=Fd::Stdout                      , stdout_fd ) ;                                          // .
 	SWEAR( !stderr_fd || stderr_fd>=Fd::Stdout                      , stderr_fd ) ;                                          // .
 	SWEAR( !( stderr_fd==Fd::Stdout && stdout_fd==Fd::Stderr )                  ) ;                                          // .
-	if (stdin_fd ==PipeFd) _p2c .open() ; else if (+stdin_fd ) _p2c .read  = stdin_fd  ;
-	if (stdout_fd==PipeFd) _c2po.open() ; else if (+stdout_fd) _c2po.write = stdout_fd ;
-	if (stderr_fd==PipeFd) _c2pe.open() ; else if (+stderr_fd) _c2pe.write = stderr_fd ;
+	if (stdin_fd ==PipeFd) _p2c .open(false/*no_std*/,true/*cloexec*/) ; else if (+stdin_fd ) _p2c .read  = stdin_fd  ; // cloexec : pipes must not leak to processes spawned concurrently or ...
+	if (stdout_fd==PipeFd) _c2po.open(false/*no_std*/,true/*cloexec*/) ; else if (+stdout_fd) _c2po.write = stdout_fd ; // ... later by caller, child side is dup'ed to std fd's anyway
+	if (stderr_fd==PipeFd) _c2pe.open(false/*no_std*/,true/*cloexec*/) ; else if (+stderr_fd) _c2pe.write = stderr_fd ; // .
 	//
 	// /!\ memory for environment must be allocated before calling clone
 	::vector_s env_vector ;                                                                                                  // ensure actual env strings (of the form name=val) lifetime
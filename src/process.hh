@@ -16,11 +16,11 @@
 struct Pipe {
 	// cxtors & casts
 	Pipe(                          ) = default ;
-	Pipe(NewType,bool no_std_=false) { open(no_std_) ; }
+	Pipe(NewType,bool no_std_=false,bool cloexec=false) { open(no_std_,cloexec) ; }
 	// services
-	void open(bool no_std_=false) {
+	void open( bool no_std_=false , bool cloexec=false ) {
 		int fds[2] ;
-		swear_prod( ::pipe(fds)==0 , "cannot create pipes" ) ;
+		swear_prod( ::pipe2(fds,cloexec?O_CLOEXEC:0)==0 , "cannot create pipes" ) ;
 		read  = {fds[0],no_std_} ;
 		write = {fds[1],no_std_} ;
 	}
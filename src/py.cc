@@ -5,6 +5,8 @@
 
 #include "py.hh" // /!\ must be included first as Python.h must be included first
 
+#include <marshal.h>
+
 #if HAS_MEMFD
 	#include <sys/mman.h>
 #endif
@@ -130,6 +132,21 @@ namespace Py {
 		return env ;
 	}
 
+	::string py_marshal(Object const& obj) {
+		Ptr<Object> bytes { PyMarshal_WriteObjectToString( obj.to_py() , Py_MARSHAL_VERSION ) } ;
+		if (!bytes) throw py_err_str_clear() ;
+		char*      data = nullptr/*garbage*/ ;
+		Py_ssize_t sz   = 0      /*garbage*/ ;
+		if (PyBytes_AsStringAndSize(bytes->to_py(),&data,&sz)<0) throw py_err_str_clear() ;
+		return {data,size_t(sz)} ;
+	}
+
+	Ptr<Object> py_unmarshal(::string const& txt) {
+		Ptr<Object> res { PyMarshal_ReadObjectFromString( txt.data() , txt.size() ) } ;
+		if (!res) throw py_err_str_clear() ;
+		return res ;
+	}
+
 	//
 	// val methods (mostly for debug)
 	//
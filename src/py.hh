@@ -92,9 +92,11 @@ namespace Py {
 		return nullptr ;
 	}
 
-	Ptr<Object> py_eval( ::string const& expr             ) ;
-	void        py_run ( ::string const& text , Dict& env ) ;
-	Ptr<Dict>   py_run ( ::string const& text             ) ;
+	Ptr<Object> py_eval     ( ::string const& expr             ) ;
+	void        py_run      ( ::string const& text , Dict& env ) ;
+	Ptr<Dict>   py_run      ( ::string const& text             ) ;
+	::string    py_marshal  ( Object   const& obj              ) ; // only for simple objects (str, dict, list, tuple, ...), e.g. to transport results between processes
+	Ptr<Object> py_unmarshal( ::string const& txt              ) ;
 
 	//
 	// Object
@@ -23,6 +23,7 @@ ENUM_2( AutodepMethod                     // PER_AUTODEP_METHOD : add entry here
 ,	None
 ,	Fuse
 ,	Ptrace
+,	Seccomp
 ,	LdAudit
 ,	LdPreload
 ,	LdPreloadJemalloc
@@ -331,10 +332,11 @@ struct JobStats {
 	using Delay = Time::Delay ;
 	// data
 	// START_OF_VERSIONING
-	Delay  cpu   = {} ;
-	Delay  job   = {} ; // elapsed in job
-	Delay  total = {} ; // elapsed including overhead
-	size_t mem   = 0  ; // in bytes
+	Delay  cpu              = {} ;
+	Delay  job              = {} ; // elapsed in job
+	Delay  total            = {} ; // elapsed including overhead
+	size_t mem              = 0  ; // in bytes
+	size_t n_access_reports = 0  ; // number of accesses reported by job processes, after filtering by access caches
 	// END_OF_VERSIONING
 } ;
 
@@ -620,6 +622,13 @@ public :
 	// END_OF_VERSIONING
 } ;
 
+// messages sent by a job_exec pool to the local backend on its stdout, fixed size so they are written atomically
+struct JobPoolMsg {
+	bool  exited  = false ; // if false, pid of the job_exec just forked (or -1 if fork failed), else job pid has exited with wstatus
+	pid_t pid     = 0     ;
+	int   wstatus = 0     ;
+} ;
+
 struct JobRpcReq {
 	using P   = JobRpcProc          ;
 	using SI  = SeqId               ;
@@ -684,6 +693,8 @@ struct JobRpcReply {
 			case Proc::Start :
 				::serdes(s,addr          ) ;
 				::serdes(s,autodep_env   ) ;
+				::serdes(s,autodep_cache ) ;
+				::serdes(s,autodep_ring  ) ;
 				::serdes(s,cmd           ) ;
 				::serdes(s,cwd_s         ) ;
 				::serdes(s,date_prec     ) ;
@@ -706,6 +717,7 @@ struct JobRpcReply {
 				::serdes(s,timeout       ) ;
 				::serdes(s,tmp_sz_mb     ) ;
 				::serdes(s,use_script    ) ;
+				::serdes(s,zygote_sz     ) ;
 			break ;
 		DF}
 	}
@@ -725,6 +737,8 @@ struct JobRpcReply {
 	Proc                     proc           = {}                  ;
 	in_addr_t                addr           = 0                   ; // proc==Start , the address at which server and subproccesses can contact job_exec
 	AutodepEnv               autodep_env    ;                       // proc==Start
+	bool                     autodep_cache  = false               ; // proc==Start , if true <=> processes share a cache of reported read accesses
+	bool                     autodep_ring   = false               ; // proc==Start , if true <=> read accesses may be reported through shared memory
 	::pair_ss/*script,call*/ cmd            ;                       // proc==Start
 	::string                 cwd_s          ;                       // proc==Start
 	Time::Delay              date_prec      ;                       // proc==Start
@@ -747,6 +761,7 @@ struct JobRpcReply {
 	Time::Delay              timeout        ;                       // proc==Start
 	size_t                   tmp_sz_mb      = Npos                ; // proc==Start , if not Npos and TMPDIR not defined, tmp size in MB
 	bool                     use_script     = false               ; // proc==Start
+	size_t                   zygote_sz      = 0                   ; // proc==Start , if not 0, job may be forked from a zygote preloaded with the last zygote_sz bytes of cmd.first
 	// END_OF_VERSIONING
 private :
 	::string _tmp_dir_s_to_cleanup ;                                // for use in exit (autodep.tmp_dir_s may be moved)
@@ -0,0 +1,106 @@
+// This file is part of the open-lmake distribution (git@github.com:cesar-douady/open-lmake.git)
+// Copyright (c) 2023 Doliam
+// This program is free software: you can redistribute/modify under the terms of the GPL-v3 (https://www.gnu.org/licenses/gpl-3.0.html).
+// This program is distributed WITHOUT ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+#pragma once
+
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "fd.hh"
+#include "serialize.hh"
+
+// a job relay is a per host agent that carries all connections between the jobs running on this host and the server over a single persistent link (cf. src/job_relay.cc)
+// jobs connect to it through an abstract unix socket and send a JobRelayProc byte telling which service they want to reach, then talk exactly as they would to the server
+// each connection is a channel on the link, and data flows as JobRelayMsg's in both directions
+// when server closes a channel opened by a job, relay sends a byte to job before closing, so job can know its messages have been received by server
+// if server cannot open the channel, relay closes it without this byte, and job falls back to a direct connection
+// as abstract sockets are visible to all users, relay and jobs check their peer runs as the same user
+// relay and server never block on writes (data are buffered until peer can accept them), so that a slow reader cannot dead-lock the link
+
+// START_OF_VERSIONING
+ENUM( JobRelayProc
+,	None
+// relay -> server
+,	Start   // open a channel to job start service
+,	Mngt    // open a channel to job mngt  service
+,	End     // open a channel to job end   service
+,	Err     // channel opened by server could not be connected to job
+// server -> relay
+,	Connect // open a channel to job listening on port
+// both ways
+,	Data    // data on an open channel
+,	Close   // sender will send no more data on channel
+)
+// END_OF_VERSIONING
+
+struct JobRelayMsg {
+	friend ::ostream& operator<<( ::ostream& os , JobRelayMsg const& jrm ) {
+		/**/                                   os << "JobRelayMsg(" << jrm.proc <<','<< jrm.chan ;
+		if (jrm.proc==JobRelayProc::Connect  ) os <<','<< jrm.port                               ;
+		if (jrm.proc==JobRelayProc::Data     ) os <<','<< jrm.data.size()                        ;
+		return                                 os <<')'                                          ;
+	}
+	using Proc = JobRelayProc ;
+	static constexpr uint32_t ServerChan = uint32_t(1)<<31 ; // channels opened by server have this bit set, so both ends can allocate channel ids independently
+	// services
+	template<IsStream T> void serdes(T& s) {
+		if (is_base_of_v<::istream,T>) *this = {} ;
+		::serdes(s,proc) ;
+		::serdes(s,chan) ;
+		switch (proc) {
+			case Proc::Connect : ::serdes(s,port) ; break ;
+			case Proc::Data    : ::serdes(s,data) ; break ;
+			default : break ;
+		}
+	}
+	// data
+	Proc      proc = {} ;
+	uint32_t  chan = 0  ;
+	in_port_t port = 0  ;                                    // proc==Connect
+	::string  data ;                                         // proc==Data
+} ;
+
+namespace JobRelay {
+
+	static constexpr char SockPfx[] = "lmake_relay_" ;
+
+	// relays are per host and per server, they listen to an abstract unix socket whose name is derived from the service they relay to
+	inline ::string sock_name(::string const& relay_service) { return SockPfx+relay_service ; }
+
+	inline AutoCloseFd connect_relay(::string const& sock_name) { // return an invalid fd if no relay listens to sock_name
+		struct sockaddr_un addr = { .sun_family=AF_UNIX , .sun_path={} } ;
+		if (sock_name.size()+1>sizeof(addr.sun_path)) return {} ;
+		::memcpy( addr.sun_path+1 , sock_name.data() , sock_name.size() ) ;                                                   // abstract socket : sun_path starts with a null
+		AutoCloseFd fd = ::socket( AF_UNIX , SOCK_STREAM|SOCK_CLOEXEC , 0 ) ;
+		if (::connect( fd , reinterpret_cast<struct sockaddr*>(&addr) , offsetof(struct sockaddr_un,sun_path)+1+sock_name.size() )!=0) return {} ;
+		if (!SockFd::s_same_user(fd)                                                                                                 ) return {} ; // abstract sockets are visible to all users, only trust ours
+		return fd ;
+	}
+
+	// connect to service through relay listening to sock_name, directly if sock_name is empty or if relay cannot be reached
+	inline ClientSockFd connect( ::string const& sock_name , JobRelayProc proc , ::string const& service , int n_trials=1 ) {
+		if (+sock_name) {
+			AutoCloseFd fd = connect_relay(sock_name) ;
+			char        p  = char(proc)               ;
+			if ( +fd && ::write(fd,&p,1)==1 ) { ClientSockFd res ; res = fd.detach() ; return res ; }
+		}
+		return { service , n_trials } ;
+	}
+
+	static constexpr Time::Delay AckTimeout { 100. } ; // as for direct connections, ensure we dont stay stuck if server is in the coma
+
+	// for connections through a relay, wait until server has closed connection, throw if relay disappeared, closed channel without ack or timed out before that
+	// this is a no-op for direct connections as data have then been delivered to the server kernel when write returns
+	inline void wait_ack( Fd fd , Time::Delay timeout=AckTimeout ) {
+		int       domain = 0              ;
+		socklen_t len    = sizeof(domain) ;
+		if ( ::getsockopt(fd,SOL_SOCKET,SO_DOMAIN,&domain,&len)!=0 || domain!=AF_UNIX ) return ;
+		::shutdown(fd,SHUT_WR) ;
+		Time::Pdate::TimeVal to_tv(timeout) ; ::setsockopt( fd , SOL_SOCKET , SO_RCVTIMEO , &to_tv , sizeof(to_tv) ) ;
+		char c ;
+		if (::read(fd,&c,1)!=1) throw "relay did not acknowledge message"s ;
+	}
+
+}
@@ -56,6 +56,15 @@ namespace Store {
 			_resize_file(::max( sz , size + (size>>2) )) ;      // ensure remaps are in log(n)
 			_map(old_size) ;
 		}
+		void sync_size() {                                      // if file is shared with other processes, they may have expanded it
+			ULock  lock     { _mutex } ;
+			size_t old_size = size     ;
+			size_t new_size = Disk::FileInfo(_fd).sz ;
+			if (new_size<=old_size) return ;
+			SWEAR( new_size<=capacity , new_size , capacity ) ;
+			size = new_size ;
+			_map(old_size) ;
+		}
 		void clear(size_t sz=0) {
 			ULock lock{_mutex} ;
 			_clear(sz) ;
@@ -14,6 +14,75 @@
 #include "time.hh"
 #include "trace.hh"
 
+// MpscQueue is a multi-producer single-consumer queue :
+// - producers push with a single CAS, they never wait for the consumer nor for each other
+// - consumer drains all pending items in a single atomic exchange into a private batch from which it then pops without any synchronization
+// - urgent items are pushed on a separate lane which is drained before each pop and put in front of the batch, so urgent items are served first, last pushed first, as with push_front
+// all accesses but pushes must be done by the consumer
+template<class T> struct MpscQueue {
+	using value_type = T ;
+	struct Item {
+		template<class... A> Item(A&&... a) : val(::forward<A>(a)...) {}
+		Item* next = nullptr ;
+		T     val  ;
+	} ;
+	// cxtors & casts
+	MpscQueue() = default ;
+	~MpscQueue() {
+		_drain() ;
+		while (_front) pop_front() ;
+	}
+	// accesses
+	bool empty() const { return !_front && !_urgent.load(::memory_order_relaxed) && !_normal.load(::memory_order_relaxed) ; }
+	// services
+	template<class U   > void push_front   (U&&    x) { _push( _urgent , new Item(::forward<U>(x)   ) ) ; }
+	template<class U   > void push_back    (U&&    x) { _push( _normal , new Item(::forward<U>(x)   ) ) ; }
+	template<class... A> void emplace_front(A&&... a) { _push( _urgent , new Item(::forward<A>(a)...) ) ; }
+	template<class... A> void emplace_back (A&&... a) { _push( _normal , new Item(::forward<A>(a)...) ) ; }
+	//
+	bool/*ready*/ ready() {                                                                       // drain pending items if necessary, return true if an item is available
+		if ( !_front || _urgent.load(::memory_order_relaxed) ) _drain() ;
+		return _front ;
+	}
+	T& front() {
+		SWEAR(ready()) ;
+		return _front->val ;
+	}
+	void pop_front() {
+		SWEAR(_front) ;
+		Item* i = _front ;
+		_front = i->next ;
+		if (!_front) _back = nullptr ;
+		delete i ;
+	}
+private :
+	static void _push( ::atomic<Item*>& lane , Item* i ) {
+		Item* n = lane.load(::memory_order_relaxed) ;
+		do i->next = n ; while (!lane.compare_exchange_weak( n , i , ::memory_order_release , ::memory_order_relaxed )) ;
+	}
+	void _drain() {
+		if ( Item* u = _urgent.exchange(nullptr,::memory_order_acquire) ) {                        // lane is last pushed first, which is what we want for urgent items
+			Item* l = u ; while (l->next) l = l->next ;
+			if (!_front) _back = l ;
+			l->next = _front ;
+			_front  = u      ;
+		}
+		if ( Item* n = _normal.exchange(nullptr,::memory_order_acquire) ) {                        // lane is last pushed first, reverse it to append to batch
+			Item* f = nullptr ;
+			Item* b = n       ;
+			while (n) { Item* nxt = n->next ; n->next = f ; f = n ; n = nxt ; }
+			if (_back) _back->next = f ;
+			else       _front      = f ;
+			_back = b ;
+		}
+	}
+	// data
+	::atomic<Item*> _urgent = nullptr ;
+	::atomic<Item*> _normal = nullptr ;
+	Item*           _front  = nullptr ;                                                           // private batch, only accessed by consumer
+	Item*           _back   = nullptr ;                                                           // .
+} ;
+
 template<class Q,bool Flush=true> struct ThreadQueue : Q { // if Flush, process remaining items when asked to stop
 	using ThreadMutex = Mutex<MutexLvl::Thread> ;
 	using Val         = typename Q::value_type  ;
@@ -60,6 +129,58 @@ private :
 } ;
 template<class T,bool Flush=true> using ThreadDeque = ThreadQueue<::deque<T>,Flush> ;
 
+// lock-free version for a single consumer, used when producers are numerous and consumer must not be slowed down by lock handoffs
+// consumer waits on an atomic counter when there is nothing to do, producers only make a syscall to wake it up when it is actually waiting
+template<class T,bool Flush> struct ThreadQueue<MpscQueue<T>,Flush> : private MpscQueue<T> { // if Flush, process remaining items when asked to stop
+	using Q   = MpscQueue<T> ;
+	using Val = T            ;
+	// cxtors & casts
+	ThreadQueue(      ) = default ;
+	ThreadQueue(char k) : key{k} {}
+	~ThreadQueue() { Trace("~ThreadQueue",key) ; }
+	// accesses (consumer only)
+	bool operator+() const { return !Q::empty() ; }
+	bool operator!() const { return  Q::empty() ; }
+	// services
+	template<class    U> void push_urgent   (U&&    x) { Q::push_front   (::forward<U>(x)   ) ; _wakeup() ; }
+	template<class    U> void push          (U&&    x) { Q::push_back    (::forward<U>(x)   ) ; _wakeup() ; }
+	template<class... A> void emplace_urgent(A&&... a) { Q::emplace_front(::forward<A>(a)...) ; _wakeup() ; }
+	template<class... A> void emplace       (A&&... a) { Q::emplace_back (::forward<A>(a)...) ; _wakeup() ; }
+	// consumer only
+	void           pop    (                     Val& res ) {                                                      _wait({}  ) ;             _pop(res) ;                 }
+	bool/*popped*/ try_pop(                     Val& res ) { bool popped =                        Q::ready()                  ; if (popped) _pop(res) ; return popped ; }
+	bool/*popped*/ pop    ( ::stop_token stop , Val& res ) { bool popped = (Flush&&Q::ready()) || _wait(stop) ; if (popped) _pop(res) ; return popped ; }
+	//
+	/**/                  Val  pop    (                 ) {                                                      _wait({}  ) ; return                   _pop()         ; }
+	::pair<bool/*popped*/,Val> try_pop(                 ) { bool popped =                        Q::ready()                  ; return { popped , popped?_pop():Val() } ; }
+	::pair<bool/*popped*/,Val> pop    (::stop_token stop) { bool popped = (Flush&&Q::ready()) || _wait(stop) ; return { popped , popped?_pop():Val() } ; }
+private :
+	void _pop(Val& res) {     res = ::move(Q::front()) ; Q::pop_front() ;              }
+	Val  _pop(        ) { Val res = ::move(Q::front()) ; Q::pop_front() ; return res ; }
+	void _wakeup() {
+		_seq.fetch_add(1) ;                                                                        // seq_cst, so that either we see _sleeping or consumer sees new _seq
+		if (_sleeping.load()) _seq.notify_one() ;
+	}
+	bool/*ready*/ _wait(::stop_token stop) {
+		::stop_callback stop_cb { stop , [&]()->void { _wakeup() ; } } ;
+		for(;;) {
+			uint32_t seq = _seq.load() ;
+			if (Q::ready()           ) return true  ;
+			if (stop.stop_requested()) return false ;
+			_sleeping = true  ;
+			_seq.wait(seq) ;                                                                       // returns immediately if an item has been pushed since seq was read
+			_sleeping = false ;
+		}
+	}
+	// data
+public :
+	char key = t_thread_key ;
+private :
+	::atomic<uint32_t> _seq      = 0     ;                                                         // incremented at each push
+	::atomic<bool    > _sleeping = false ;                                                         // consumer is waiting on _seq
+} ;
+template<class T,bool Flush=true> using ThreadMpsc = ThreadQueue<MpscQueue<T>,Flush> ;
+
 template<class Q,bool Flush=true,bool QueueAccess=false> struct QueueThread : private ThreadQueue<Q,Flush> { // if Flush, process remaining items when asked to stop
 	using Base = ThreadQueue<Q,Flush> ;
 	using Val  = typename Base::Val  ;
@@ -71,6 +192,8 @@ template<class Q,bool Flush=true,bool QueueAccess=false> struct QueueThread : pr
 	using Base::unlock         ;
 	using Base::swear_locked   ;
 	using Base::key            ;
+	using Base::operator+      ;
+	using Base::operator!      ;
 	#define RQA  requires( QueueAccess)
 	#define RNQA requires(!QueueAccess)
 	// statics
@@ -209,10 +332,12 @@ ENUM(ServerThreadEventKind
 ,	Master
 ,	Slave
 ,	Stop
+,	Adopt
 )
 template<class Req,bool Flush=true> struct ServerThread {                                  // if Flush, finish on going connections
-	using Delay = Time::Delay ;
-	using EventKind = ServerThreadEventKind ;
+	using Delay       = Time::Delay              ;
+	using EventKind   = ServerThreadEventKind    ;
+	using ThreadMutex = Mutex<MutexLvl::Thread> ;
 private :
 	static void _s_thread_func( ::stop_token stop , char key , ServerThread* self , ::function<bool/*keep_fd*/(::stop_token,Req&&,SlaveSockFd const&)> func ) {
 		static constexpr uint64_t One = 1 ;
@@ -232,8 +357,9 @@ private :
 		Trace trace("ServerThread::_s_thread_func",self->fd,self->fd.port(),stop_fd) ;
 		self->_ready.count_down() ;
 		//
-		epoll.add_read(self->fd,EventKind::Master) ;
-		epoll.add_read(stop_fd ,EventKind::Stop  ) ;
+		epoll.add_read(self->fd       ,EventKind::Master              ) ;
+		epoll.add_read(stop_fd        ,EventKind::Stop                ) ;
+		epoll.add_read(self->_adopt_fd,EventKind::Adopt,false/*wait*/) ;                   // adopted connections are an activity, not the possibility to adopt them
 		for(;;) {
 			trace("wait") ;
 			::vector<Epoll::Event> events = epoll.wait(epoll.cnt?Delay::Forever:Delay()) ; // wait for 1 event, no timeout unless stopped
@@ -252,6 +378,20 @@ private :
 							slaves.try_emplace(slave_fd) ;
 						} catch (::string const& e) { trace("cannot_accept",e) ; }         // ignore error as this may be fd starvation and client will retry
 					} break ;
+					case EventKind::Adopt : {
+						uint64_t     n   ;
+						ssize_t      cnt = ::read(efd,&n,sizeof(n)) ; SWEAR( cnt==sizeof(n) , cnt ) ;
+						::vector<Fd> fds ;
+						{	Lock<ThreadMutex> lock { self->_adopt_mutex } ;
+							fds = ::move(self->_adopted) ;
+							self->_adopted.clear() ;
+						}
+						for( Fd slave_fd : fds ) {
+							trace("adopt_req",slave_fd) ;
+							epoll.add_read(slave_fd,EventKind::Slave) ;
+							slaves.try_emplace(slave_fd) ;
+						}
+					} break ;
 					case EventKind::Stop : {
 						uint64_t one ;
 						ssize_t  cnt = ::read(efd,&one,sizeof(one)) ;
@@ -265,7 +405,12 @@ private :
 					case EventKind::Slave : {
 						Req r ;
 						try         { if (!slaves.at(efd).receive_step(efd,r)) { trace("partial") ; continue ; } }
-						catch (...) {                                            trace("bad_msg") ; continue ;   } // ignore malformed messages
+						catch (...) {                                                                                // ignore malformed messages, but close connection as it will not become well formed
+							trace("bad_msg") ;
+							epoll.close(efd) ;
+							slaves.erase(efd) ;
+							continue ;
+						}
 						//
 						epoll.del(efd) ;                 // Func may trigger efd being closed by another thread, hence epoll.del must be done before
 						slaves.erase(efd) ;
@@ -297,9 +442,20 @@ public :
 	void wait_started() {
 		_ready.wait() ;
 	}
+	void adopt(Fd slave_fd) {                            // process slave_fd as if it had been accepted on fd, thread becomes owner of slave_fd
+		static constexpr uint64_t One = 1 ;
+		{	Lock<ThreadMutex> lock { _adopt_mutex } ;
+			_adopted.push_back(slave_fd) ;
+		}
+		ssize_t cnt = ::write(_adopt_fd,&One,sizeof(One)) ;
+		SWEAR( cnt==sizeof(One) , cnt , _adopt_fd ) ;
+	}
 	// data
 	ServerSockFd fd ;
 private :
-	::latch   _ready  { 1 } ;
-	::jthread _thread ;                                  // ensure _thread is last so other fields are constructed when it starts
+	ThreadMutex  _adopt_mutex ;
+	::vector<Fd> _adopted     ;                          // protected by _adopt_mutex
+	AutoCloseFd  _adopt_fd    = ::eventfd(0,O_CLOEXEC) ;
+	::latch      _ready       { 1 } ;
+	::jthread    _thread      ;                          // ensure _thread is last so other fields are constructed when it starts
 } ;
@@ -0,0 +1,96 @@
+// This file is part of the open-lmake distribution (git@github.com:cesar-douady/open-lmake.git)
+// Copyright (c) 2023 Doliam
+// This program is free software: you can redistribute/modify under the terms of the GPL-v3 (https://www.gnu.org/licenses/gpl-3.0.html).
+// This program is distributed WITHOUT ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+#include "thread.hh"
+
+static constexpr int NProducers = 4     ;
+static constexpr int NItems     = 20000 ; // per producer
+
+struct Item {
+	int producer = -1 ; // -1 for urgent items
+	int seq      = 0  ;
+} ;
+
+//
+// MpscQueue
+//
+
+void test_drain_all() {
+	::cout<<"check drain all ..." ;
+	MpscQueue<int> q ;
+	SWEAR(!q.ready()) ;
+	for( int i=0 ; i<NItems ; i++ ) q.emplace_back(i) ;
+	for( int i=0 ; i<NItems ; i++ ) {              // all pending items are drained at once and served in push order
+		SWEAR( q.ready()    , i           ) ;
+		SWEAR( q.front()==i , i,q.front() ) ;
+		q.pop_front() ;
+		if (i==NItems/2) q.emplace_back(NItems) ;  // pushed after drain, must be served after the batch
+	}
+	SWEAR( q.ready() && q.front()==NItems , q.front() ) ; q.pop_front() ;
+	SWEAR( !q.ready() && q.empty() ) ;
+	::cout<<" ok\n" ;
+}
+
+void test_urgent() {
+	::cout<<"check urgent ..." ;
+	MpscQueue<int> q ;
+	for( int i=0 ; i<NItems ; i++ ) q.emplace_back(i) ;
+	SWEAR( q.ready() && q.front()==0 ) ; q.pop_front() ;              // batch is now drained with NItems-1 pending items
+	q.emplace_front(-1) ;
+	q.emplace_front(-2) ;
+	SWEAR( q.ready() && q.front()==-2 , q.front() ) ; q.pop_front() ; // urgent items are served before pending ones, last pushed first
+	SWEAR( q.ready() && q.front()==-1 , q.front() ) ; q.pop_front() ; // .
+	for( int i=1 ; i<NItems ; i++ ) {
+		SWEAR( q.ready()    , i           ) ;
+		SWEAR( q.front()==i , i,q.front() ) ;
+		q.pop_front() ;
+	}
+	SWEAR(q.empty()) ;
+	::cout<<" ok\n" ;
+}
+
+//
+// ThreadMpsc
+//
+
+void test_producers() {
+	::cout<<"check producers ..." ;
+	ThreadMpsc<Item> q ;
+	::vector<::jthread> producers ;
+	for( int p=0 ; p<NProducers ; p++ ) producers.emplace_back( [&q,p]()->void { for( int i=0 ; i<NItems ; i++ ) q.emplace(p,i) ; } ) ;
+	::vector<int> next ( NProducers , 0 ) ;
+	for( int i=0 ; i<NProducers*NItems ; i++ ) {   // no item is lost and each producer is served in its push order
+		Item item = q.pop() ;
+		SWEAR( item.producer>=0 && item.producer<NProducers , item.producer          ) ;
+		SWEAR( item.seq==next[item.producer]                , item.producer,item.seq ) ;
+		next[item.producer]++ ;
+	}
+	for( ::jthread& t : producers ) t.join() ;
+	SWEAR(!q) ;
+	::cout<<" ok\n" ;
+}
+
+void test_flood() {                                                  // mimic a req kill while engine is flooded with job events
+	::cout<<"check flood ..." ;
+	ThreadMpsc<Item> q ;
+	::jthread flooder { [&q]()->void { for( int i=0 ; i<NItems ; i++ ) q.emplace(0,i) ; } } ;
+	int n_popped = 0 ;
+	for(; n_popped<NItems/4 ; n_popped++ ) SWEAR(q.pop().seq==n_popped) ; // consumer is busy with normal items ...
+	flooder.join() ;                                                     // ... and many of them are pending ...
+	::jthread{ [&q]()->void { q.emplace_urgent(-1,0) ; } }.join() ;      // ... when an urgent item is pushed from another thread
+	Item kill = q.pop() ;
+	SWEAR( kill.producer==-1 , kill.producer , kill.seq ) ;              // it must be served before pending items
+	for(; n_popped<NItems ; n_popped++ ) SWEAR(q.pop().seq==n_popped) ;
+	SWEAR(!q) ;
+	::cout<<" ok\n" ;
+}
+
+int main() {
+	test_drain_all() ;
+	test_urgent   () ;
+	test_producers() ;
+	test_flood    () ;
+	return 0 ;
+}
@@ -924,6 +924,7 @@ ENUM( MutexLvl  // identify who is owning the current level to ease debugging
 ,	BackendId   // must follow Backend
 ,	Gil         // must follow Backend
 ,	NodeCrcDate // must follow Backend
+,	PyGlbs      // must follow Gil
 ,	Req         // must follow Backend
 ,	TargetDir   // must follow Backend
 // level 4
@@ -934,8 +935,13 @@ ENUM( MutexLvl  // identify who is owning the current level to ease debugging
 // level 5
 ,	Autodep2    // must follow Autodep1
 // inner (locks that take no other locks)
+,	Cache
+,	DynamicEval
 ,	File
 ,	Hash
+,	JobPool
+,	Prefetch
+,	Relay
 ,	Sge
 ,	Slurm
 ,	SmallId
@@ -0,0 +1,25 @@
+	#pragma once
+	#define ADDR2LINE                   "/usr/bin/addr2line"
+	#define HAS_32                      0
+	#define HAS_CLOSE_RANGE             1
+	#define HAS_FUSE                    0
+	#define HAS_LD_AUDIT                1
+	#define HAS_MEMFD                   1
+	#define HAS_OSTRINGSTREAM_VIEW      1
+	#define HAS_PCRE                    0
+	#define HAS_PTRACE_GET_SYSCALL_INFO 1
+	#define HAS_SECCOMP                 0
+	#define HAS_SECCOMP_NOTIF           1
+	#define HAS_SGE                     0
+	#define HAS_SLURM                   0
+	#define HAS_STACKTRACE              0
+	#define HAS_UNREACHABLE             1
+	#define MAX_PID                     32768
+	#define MUST_UNDEF_PTRACE_MACROS    1
+	#define MAP_VFORK                   0
+	#define NEED_STAT_WRAPPERS          0
+	#define PY_LD_LIBRARY_PATH          "/root/.pyenv/versions/3.11.7/lib"
+	#define PYTHON                      "/root/.pyenv/shims/python3"
+	#define SLURM_SO                    "libslurm.so"
+	#define STD_PATH                    "/.rbenv/shims:/root/.rbenv/bin:/root/.cargo/bin:/root/miniconda/condabin:/.pyenv/bin:/.pyenv/shims:/usr/local/bin:/usr/local/sbin:/usr/bin:/usr/sbin:/bin:/sbin:."
+	#define USE_LIBC_START_MAIN         1
@@ -0,0 +1,46 @@
+SYS_CONFIG_OK      := 1
+LMAKE_FLAGS        := 
+#
+BASH               := /bin/bash
+GIT                := /usr/bin/git
+STD_PATH           := /.rbenv/shims:/root/.rbenv/bin:/root/.cargo/bin:/root/miniconda/condabin:/.pyenv/bin:/.pyenv/shims:/usr/local/bin:/usr/local/sbin:/usr/bin:/usr/sbin:/bin:/sbin:.
+#
+PYTHON2            := 
+PY2_INCLUDEDIR     := 
+PY2_INCLUDEPY      := 
+PY2_LIB_DIR        := 
+PY2_LIB_BASE       := 
+HAS_PY2_DYN        := 
+PYTHON             := /root/.pyenv/shims/python3
+PY3_INCLUDEDIR     := /root/.pyenv/versions/3.11.7/include
+PY3_INCLUDEPY      := /root/.pyenv/versions/3.11.7/include/python3.11
+PY3_LIB_DIR        := /root/.pyenv/versions/3.11.7/lib
+PY3_LIB_BASE       := libpython3.11.so
+HAS_PY3_DYN        := 1
+PY_LD_LIBRARY_PATH := /root/.pyenv/versions/3.11.7/lib
+#
+CXX                := /usr/bin/g++
+CXX_DIR            := /usr/bin
+CXX_FLAVOR         := gcc
+CXX_STD            := c++23
+LD_SO_LIB          := lib
+LD_SO_LIB_32       := 
+LIB_STACKTRACE     := 
+LIB_STACKTRACE_32  := 
+LINK_LIB_PATH      := 
+LINK_LIB_PATH_32   := 
+OBJCOPY            := /usr/bin/objcopy
+STD_INC_DIRS       := /usr/lib/gcc/x86_64-linux-gnu/12/include /usr/local/include /usr/include/x86_64-linux-gnu /usr/include
+#
+SLURM_INC_DIR      := 
+#
+HAS_32             := 
+HAS_FUSE           := 
+HAS_LD_AUDIT       := 1
+HAS_PCRE           := 
+HAS_SECCOMP        := 
+HAS_SECCOMP_NOTIF  := 1
+HAS_SGE            := 
+HAS_SLURM          := 
+HAS_STACKTRACE     := 
+HAS_STACKTRACE_32  := 
@@ -0,0 +1,3 @@
+#include<stdio.h>
+#include<stdlib.h>
+unsigned int la_version(unsigned int) { printf("1") ; exit(0) ; }
@@ -0,0 +1,2 @@
+	#include <sstream>
+	std::string_view ossv = std::ostringstream().view() ;
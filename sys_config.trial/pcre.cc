@@ -0,0 +1,5 @@
+	#define PCRE2_CODE_UNIT_WIDTH 8
+	#include <pcre2.h>
+	int main() {
+		pcre2_compile(nullptr,0,PCRE2_ANCHORED|PCRE2_DOTALL|PCRE2_ENDANCHORED,nullptr,nullptr,nullptr) ;
+	}
@@ -0,0 +1,6 @@
+	#include <seccomp.h>
+	struct scmp_version v ;
+	int main() {
+		scmp_filter_ctx ctx ;
+		seccomp_syscall_priority(ctx,0,0) ;
+	}
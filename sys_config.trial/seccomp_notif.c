@@ -0,0 +1,9 @@
+	#include <sys/ioctl.h>
+	#include <linux/seccomp.h>
+	#include <linux/audit.h>
+	#if !defined(__x86_64__) && !defined(__aarch64__)
+		#error "seccomp autodep method is only implemented for x86_64 and aarch64"
+	#endif
+	struct seccomp_notif      notif ;
+	struct seccomp_notif_resp resp  ;
+	unsigned long flags[] = { SECCOMP_FILTER_FLAG_NEW_LISTENER , SECCOMP_USER_NOTIF_FLAG_CONTINUE , SECCOMP_RET_USER_NOTIF , AUDIT_ARCH_X86_64 , AUDIT_ARCH_AARCH64 , SECCOMP_IOCTL_NOTIF_RECV , SECCOMP_IOCTL_NOTIF_SEND } ;
@@ -0,0 +1,8 @@
+	#include <stacktrace>
+	using namespace std ;
+	int main() {                                    // mimic a mini-program using stack trace
+		::stacktrace st = ::stacktrace::current() ;
+		int          rc = 0                       ;
+		for( ::stacktrace_entry const& e : st ) rc += e.source_line() ;
+		return rc ;
+	}
@@ -0,0 +1,6 @@
+	#include<unistd.h>
+	int __libc_start_main( void* main , int argc , void* argv , void* auxvec , void* init , void* fini , void* rtld_fini , void* stack_end) {
+		write(1,"1",1) ; // stick to very basic sycalls as nothing is initialized yet
+		_exit(0) ;       // dont call main
+	}
+	int main() { write(1,"0",1) ; }
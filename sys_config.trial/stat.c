@@ -0,0 +1,3 @@
+	#include <sys/stat.h>
+	struct stat buf ;
+	int main() { stat("",&buf) ; }
@@ -0,0 +1,6 @@
+	#include<sys/ptrace.h>
+	#include<linux/ptrace.h>
+	#undef PTRACE_TRACEME
+	void foo() {
+		long rx = ptrace(PTRACE_TRACEME,0,0,0) ;
+	}
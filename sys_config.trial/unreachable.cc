@@ -0,0 +1,4 @@
+	#include <utility>
+	int main() {
+		std::unreachable() ;
+	}
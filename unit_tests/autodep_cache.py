@@ -0,0 +1,47 @@
+# This file is part of the open-lmake distribution (git@github.com:cesar-douady/open-lmake.git)
+# Copyright (c) 2023 Doliam
+# This program is free software: you can redistribute/modify under the terms of the GPL-v3 (https://www.gnu.org/licenses/gpl-3.0.html).
+# This program is distributed WITHOUT ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+import lmake
+
+n_cats = 5
+
+if __name__!='__main__' :
+
+	from lmake.rules import Rule
+
+	lmake.manifest = (
+		'Lmakefile.py'
+	,	'src'
+	,	'other'
+	)
+
+	for cache in (False,True) :
+		for other in (False,True) :
+			class Cats(Rule) :
+				name          = f'cats {cache} {other}'
+				target        = f'cats.{int(cache)}{int(other)}'
+				autodep       = 'ld_preload'
+				autodep_cache = cache
+				cmd           = ' ; '.join(('cat src',)*n_cats) + (' ; cat other' if other else '') # each cat is a separate process reading the same file
+
+else :
+
+	import subprocess as sp
+
+	import ut
+
+	def n_reports(target) :
+		for l in sp.check_output(('lshow','-i',target),universal_newlines=True).splitlines() :
+			k,_,v = l.partition(':')
+			if k.strip()=='access reports' : return int(v)
+		assert False,f'no access reports for {target}'
+
+	print('src'  ,file=open('src'  ,'w'))
+	print('other',file=open('other','w'))
+	ut.lmake( 'cats.00' , 'cats.01' , 'cats.10' , 'cats.11' , new=2 , done=4 )
+
+	assert n_reports('cats.00')==n_reports('cats.10')+n_cats-1 # with job-wide cache, a repeated access is reported once
+	assert n_reports('cats.11')==n_reports('cats.10')+1        # and a different access is still reported
+	assert n_reports('cats.01')==n_reports('cats.00')+1        # as without it
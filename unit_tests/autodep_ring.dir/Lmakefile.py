@@ -0,0 +1,44 @@
+# This file is part of the open-lmake distribution (git@github.com:cesar-douady/open-lmake.git)
+# Copyright (c) 2023 Doliam
+# This program is free software: you can redistribute/modify under the terms of the GPL-v3 (https://www.gnu.org/licenses/gpl-3.0.html).
+# This program is distributed WITHOUT ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+import lmake
+
+n_srcs = 10
+
+if __name__!='__main__' :
+
+	from lmake.rules import Rule
+
+	lmake.manifest = (
+		'Lmakefile.py'
+	,	*( f'src{i}' for i in range(n_srcs) )
+	)
+
+	class Gen(Rule) :
+		target = r'gen{Digit:\d}'
+		cmd    = 'echo gen{Digit}'
+
+	for ad in lmake.autodeps :
+		class Cat(Rule) :
+			name         = f'cat {ad}'
+			target       = f'cat.{ad}'
+			autodep      = ad
+			autodep_ring = True                                                              # only effective for ld_* methods, others must be unaffected
+			cmd          = f'cat {" ".join(f"src{i}" for i in range(n_srcs))} gen1'
+
+else :
+
+	import ut
+
+	n_ads = len(lmake.autodeps)
+	cats  = [ f'cat.{ad}' for ad in lmake.autodeps ]
+
+	for i in range(n_srcs) : print(f'src{i}',file=open(f'src{i}','w'))
+	ut.lmake( *cats , new=n_srcs , may_rerun=n_ads , done=1+n_ads )                         # deps reported through ring must be seen
+
+	print('src3 modified',file=open('src3','w'))
+	ut.lmake( *cats , changed=1 , done=n_ads )                                              # and recorded
+
+	for c in cats : assert open(c).read()==''.join( 'src3 modified\n' if i==3 else f'src{i}\n' for i in range(n_srcs) )+'gen1\n'
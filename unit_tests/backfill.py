@@ -0,0 +1,45 @@
+# This file is part of the open-lmake distribution (git@github.com:cesar-douady/open-lmake.git)
+# Copyright (c) 2023 Doliam
+# This program is free software: you can redistribute/modify under the terms of the GPL-v3 (https://www.gnu.org/licenses/gpl-3.0.html).
+# This program is distributed WITHOUT ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+# pressure is exec time, so once exec times are known, jobs are considered in this order : long (3s) , big (2.5s) , mid1 & mid2 (2s)
+# long starts and big, which needs both cpus, reserves the date at which long ends
+# the first mid ends before this date and is backfilled, but the second one would delay big and must wait for it
+
+jobs = ('long.3','big.2.5','mid1.2','mid2.2')
+
+if __name__!='__main__' :
+
+	import lmake
+	from lmake.rules import Rule,PyRule
+
+	lmake.manifest = (
+		'Lmakefile.py'
+	,	'trig'
+	)
+
+	lmake.config.backends.local.cpu      = 2
+	lmake.config.backends.local.backfill = True
+
+	class Work(Rule) :
+		deps      = { 'TRIG':'trig' }
+		resources = { 'cpu':1 }
+		cmd       = 'echo $SEQUENCE_ID ; sleep {Duration} ; cat {TRIG}'
+
+	class Small(Work) : target = r'{Name:long|mid\d}.{Duration:[\d.]+}'
+	class Big  (Work) : target = r'{Name:big}.{Duration:[\d.]+}'       ; resources = { 'cpu':2 }
+
+	class All(PyRule) :
+		target = 'all'
+		def cmd() :
+			lmake.depend(*jobs)
+
+else :
+
+	import ut
+
+	launch = ut.launch_order('all',jobs)
+	long,big,mid1,mid2 = (launch[j] for j in jobs)
+	assert long<big and min(mid1,mid2)<big , launch # first mid is backfilled while big waits for long
+	assert big<max(mid1,mid2)              , launch # second mid would delay big, it must wait
@@ -0,0 +1,2 @@
+def hello(x) :
+	return f'hello {x}'
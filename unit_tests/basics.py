@@ -37,7 +37,8 @@ if __name__!='__main__' :
 else :
 
 	import os
-	import os.path as osp
+	import os.path    as osp
+	import subprocess as sp
 
 	import ut
 
@@ -50,6 +51,10 @@ else :
 
 	assert os.system('ldebug hello+world_sh'  )==0 # check no crash
 
+	def lshow(*args) : return { tuple(l.split()) for l in sp.check_output(('lshow',*args),universal_newlines=True).splitlines() }
+	assert lshow('-D','hello'         )=={('CatSh','hello+world_sh'),('CatPy','hello+world_py'),('CatSh','hello+hello_sh')} # check reverse index
+	assert lshow('-T','world+world_py')=={('CatPy','world+world_py')}                                                       # .
+
 	assert           os.system('chmod -w -R .'          )==0 # check we can interrogate a read-only repo
 	try     : assert os.system('lshow -i hello+world_sh')==0
 	finally : assert os.system('chmod u+w -R .'         )==0 # restore state